@@ -151,6 +151,7 @@ public:
 	void clearStats(){
 		_errors.clear();
 		_warnings.clear();
+		_outofresources = false;
 	}
 
 	void notifyParsed(const std::string& filename){
@@ -56,6 +56,10 @@
 #include "modeliteration.hpp"
 #include "twoValuedIterator.hpp"
 #include "negateTerm.hpp"
+#include "tableview.hpp"
+#include "streammodels.hpp"
+#include "countmodels.hpp"
+#include "profiling.hpp"
 
 #include "answer.hpp" //easter egg
 
@@ -183,8 +187,16 @@ const vector<shared_ptr<Inference>>& getAllInferences() {
 	inferences.push_back(make_shared<AnswerInference>());
 	inferences.push_back(make_shared<ModelIterationInference>());
 	inferences.push_back(make_shared<ModelIterationWithOutputVocInference>());
+	inferences.push_back(make_shared<StreamModelsInference>());
+	inferences.push_back(make_shared<StreamModelsWithOutputVocInference>());
+	inferences.push_back(make_shared<CountModelsInference>());
+	inferences.push_back(make_shared<CountModelsWithOutputVocInference>());
 	inferences.push_back(make_shared<TwoValuedIterator>());
+	inferences.push_back(make_shared<StartProfilingInference>());
+	inferences.push_back(make_shared<StopProfilingInference>());
 	inferences.push_back(make_shared<NegateTerm>());
+	inferences.push_back(make_shared<PredTableViewInference>());
+	inferences.push_back(make_shared<FuncInterViewInference>());
 
 	return inferences;
 }
@@ -76,6 +76,8 @@ MAPPING(Options*, AT_OPTIONS)
 MAPPING(Query*, AT_QUERY)
 MAPPING(UserProcedure*, AT_PROCEDURE)
 MAPPING(PredInter*, AT_PREDINTER)
+MAPPING(FuncInter*, AT_FUNCINTER)
+MAPPING(TableView*, AT_TABLEVIEW)
 MAPPING(ElementTuple*, AT_TUPLE)
 MAPPING(std::vector<InternalArgument>*, AT_TABLE)
 MAPPING(bool, AT_BOOLEAN)
@@ -0,0 +1,62 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef COUNTMODELS_HPP_
+#define COUNTMODELS_HPP_
+
+#include "commandinterface.hpp"
+
+#include "inferences/modelIteration/ModelCounting.hpp"
+#include "utils/NumericLimits.hpp"
+
+/**
+ * Returns the number of models projected onto outputvoc (the vocabulary of the theory if NULL), approximately if the option approxcounting is set.
+ * Counts which do not fit in an integer are returned as a double.
+ */
+InternalArgument executeCountModelsCommand(AbstractTheory* theory, Structure* structure, Vocabulary* outputvoc) {
+	ModelCounting counting(theory, structure, outputvoc);
+	auto result = counting.count(getOption(BoolType::APPROXCOUNTING), getOption(IntType::ENUMERATIONWORKERS));
+	if (result.count < getMaxElem<int>()) {
+		return InternalArgument((int) result.count);
+	}
+	return InternalArgument(result.count);
+}
+
+typedef TypedInference<LIST(AbstractTheory*, Structure*)> CountModelsInferenceBase;
+class CountModelsInference: public CountModelsInferenceBase {
+public:
+	CountModelsInference()
+			: CountModelsInferenceBase("countmodels",
+					"Returns the number of 2-valued models of the theory which are more precise than the given structure, without building them.", false) {
+		setNameSpace(getInternalNamespaceName());
+	}
+
+	InternalArgument execute(const std::vector<InternalArgument>& args) const {
+		return executeCountModelsCommand(get<0>(args), get<1>(args), NULL);
+	}
+};
+
+typedef TypedInference<LIST(AbstractTheory*, Structure*, Vocabulary*)> CountModelsWithVocInferenceBase;
+class CountModelsWithOutputVocInference: public CountModelsWithVocInferenceBase {
+public:
+	CountModelsWithOutputVocInference()
+			: CountModelsWithVocInferenceBase("countmodels",
+					"Returns the number of models of the theory which are more precise than the given structure, "
+							"where models which only differ outside the given vocabulary are counted once.", false) {
+		setNameSpace(getInternalNamespaceName());
+	}
+
+	InternalArgument execute(const std::vector<InternalArgument>& args) const {
+		return executeCountModelsCommand(get<0>(args), get<1>(args), get<2>(args));
+	}
+};
+
+#endif /* COUNTMODELS_HPP_ */
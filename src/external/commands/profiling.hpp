@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef PROFILING_HPP_
+#define PROFILING_HPP_
+
+#include <fstream>
+#include "commandinterface.hpp"
+#include "utils/Profiler.hpp"
+
+class StartProfilingInference: public EmptyBase {
+public:
+	StartProfilingInference()
+			: EmptyBase("startprofiling",
+					"Starts timing the phases of all following inferences and sampling them every 5ms (on Unix).\nThe profile is written by stopprofiling.") {
+	}
+
+	InternalArgument execute(const std::vector<InternalArgument>&) const {
+		if (not Profiler::start(5)) {
+			Warning::warning("Sampling is not supported on this platform, only the time of the phases is measured.");
+		}
+		return nilarg();
+	}
+};
+
+class StopProfilingInference: public StringBase {
+public:
+	StopProfilingInference()
+			: StringBase("stopprofiling",
+					"Stops profiling, writes the sampled stacks of phases as collapsed stacks (the input of flame graph tools) to the given file\nand prints the time spent in each phase.") {
+	}
+
+	InternalArgument execute(const std::vector<InternalArgument>& args) const {
+		if (not Profiler::running()) {
+			Warning::warning("The profiler is not running, start it with startprofiling().");
+			return nilarg();
+		}
+		std::ofstream file(get<0>(args)->c_str());
+		if (not file.is_open()) {
+			Error::error("Could not open file " + *get<0>(args) + " to write the profile to.");
+		}
+		Profiler::stop(file.is_open() ? &file : NULL, std::cout);
+		return nilarg();
+	}
+};
+
+#endif /* PROFILING_HPP_ */
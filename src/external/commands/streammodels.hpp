@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef STREAMMODELS_HPP_
+#define STREAMMODELS_HPP_
+
+#include <iostream>
+#include "commandinterface.hpp"
+
+#include "inferences/modelIteration/ModelIterator.hpp"
+#include "inferences/makeTwoValued/TwoValuedStructureIterator.hpp"
+#include "printers/modelstreamprinter.hpp"
+
+/**
+ * Writes the models to stdout as soon as they are found, in the format given by the modelstream option.
+ * With an output vocabulary, models are written from the tuples the solver made true, without building a structure for them.
+ * Returns the number of models written.
+ */
+inline InternalArgument executeStreamModelsCommand(AbstractTheory* theory, Structure* structure, Vocabulary* outputvoc) {
+	auto binary = getGlobal()->getOptions()->modelStream() == ModelStream::BINARY;
+	ModelStreamPrinter printer(std::cout, binary, getOption(BoolType::MODELSTREAMDIFF));
+	auto nbmodels = getOption(IntType::NBMODELS);
+	auto done = [&]() {return nbmodels != 0 && printer.nbModels() >= (unsigned int) nbmodels;};
+
+	auto iterator = createIterator(theory, structure, outputvoc, NULL);
+	iterator->init();
+	auto nbworkers = getOption(IntType::ENUMERATIONWORKERS);
+	if (nbworkers > 1 && nbmodels != 1) {
+		iterator->enumerateInParallel(nbworkers);
+	}
+	if (outputvoc != NULL && iterator->deltasAreComplete()) {
+		ModelDelta delta;
+		while (not done() && iterator->calculateDelta(delta)) {
+			printer.print(delta.trueatoms, iterator->inputStructure(), outputvoc);
+		}
+		return InternalArgument((int) printer.nbModels());
+	}
+	while (not done()) {
+		auto result = iterator->calculateMonitor();
+		if (result.unsat || result._models.empty()) {
+			break;
+		}
+		auto model = result._models[0];
+		if (outputvoc != NULL) { // Models are two-valued on the output vocabulary
+			printer.print(model, outputvoc);
+		} else {
+			TwoValuedStructureIterator extensions(model);
+			for (auto extension = extensions.next(); extension != NULL; extension = extensions.next()) {
+				printer.print(extension, NULL);
+				delete (extension);
+				if (done()) {
+					break;
+				}
+			}
+		}
+		delete (model);
+	}
+	return InternalArgument((int) printer.nbModels());
+}
+
+typedef TypedInference<LIST(AbstractTheory*, Structure*)> StreamModelsInferenceBase;
+class StreamModelsInference: public StreamModelsInferenceBase {
+public:
+	StreamModelsInference()
+			: StreamModelsInferenceBase("streammodels",
+					"Write 2-valued models of the theory which are more precise than the given structure to stdout as soon as they are found. "
+							"Returns the number of models written.", false) {
+		setNameSpace(getInternalNamespaceName());
+	}
+
+	InternalArgument execute(const std::vector<InternalArgument>& args) const {
+		return executeStreamModelsCommand(get<0>(args), get<1>(args), NULL);
+	}
+};
+
+typedef TypedInference<LIST(AbstractTheory*, Structure*, Vocabulary*)> StreamModelsWithVocInferenceBase;
+class StreamModelsWithOutputVocInference: public StreamModelsWithVocInferenceBase {
+public:
+	StreamModelsWithOutputVocInference()
+			: StreamModelsWithVocInferenceBase("streammodels",
+					"Write models of the theory which are more precise than the given structure and two-valued on the given vocabulary to stdout "
+							"as soon as they are found. Returns the number of models written.", false) {
+		setNameSpace(getInternalNamespaceName());
+	}
+
+	InternalArgument execute(const std::vector<InternalArgument>& args) const {
+		return executeStreamModelsCommand(get<0>(args), get<1>(args), get<2>(args));
+	}
+};
+
+#endif /* STREAMMODELS_HPP_ */
@@ -0,0 +1,54 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum 
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef TABLEVIEWINFERENCE_HPP_
+#define TABLEVIEWINFERENCE_HPP_
+
+#include "commandinterface.hpp"
+#include "IncludeComponents.hpp"
+#include "structure/TableView.hpp"
+
+/**
+ * Returns a lazy view on a given predicate table
+ */
+class PredTableViewInference: public PredTableBase {
+public:
+	PredTableViewInference()
+			: PredTableBase("view", "Create a lazy view on the given predtable. "
+					"Use :count(), :get(i,j), :row(i), :rows(), :project(c1,...), :filter(c,value) and :export() on the view.") {
+		setNameSpace(getStructureNamespaceName());
+	}
+
+	InternalArgument execute(const std::vector<InternalArgument>& args) const {
+		return InternalArgument(new TableView(get<0>(args)));
+	}
+};
+
+/**
+ * Returns a lazy view on the graph of a given two-valued function interpretation
+ */
+class FuncInterViewInference: public TypedInference<LIST(FuncInter*)> {
+public:
+	FuncInterViewInference()
+			: TypedInference<LIST(FuncInter*)>("view", "Create a lazy view on the graph of the given two-valued function interpretation.") {
+		setNameSpace(getStructureNamespaceName());
+	}
+
+	InternalArgument execute(const std::vector<InternalArgument>& args) const {
+		auto funcinter = get<0>(args);
+		if (not funcinter->approxTwoValued()) {
+			throw IdpException("Only two-valued function interpretations can be viewed.");
+		}
+		return InternalArgument(new TableView(funcinter->funcTable()));
+	}
+};
+
+#endif /* TABLEVIEWINFERENCE_HPP_ */
@@ -18,8 +18,10 @@
 #include "common.hpp"
 #include "errorhandling/error.hpp"
 #include "lua/luaconnection.hpp"
+#include "lua/StartupSnapshot.hpp"
 #include "interactive.hpp"
 #include "runidp.hpp"
+#include "serve.hpp"
 #include "insert.hpp"
 #include "GlobalData.hpp"
 #include "utils/ResourceMonitor.hpp"
@@ -63,6 +65,11 @@ static void usage(const char *name) {
 	cout << "    -e \"<proc>\"          run procedure <proc> after parsing\n";
 	cout << "    -d <dirpath>         search for datafiles in the given directory\n";
 	cout << "    --nowarnings         disable warnings\n";
+	cout << "    --nosnapshot         parse the standard library instead of loading its startup snapshot\n";
+	cout << "    --writesnapshot      write the startup snapshot of the standard library and stop\n";
+	cout << "    --snapshot <path>    load or write the startup snapshot at <path> instead of next to the standard library\n";
+	cout << "    --serve              keep the parsed files loaded and answer requests on stdin\n";
+	cout << "    --socket <path>      with --serve, answer requests on the Unix socket <path> instead\n";
 	cout << "    -I                   read from stdin\n";
 	cout << "    -v, --version        show version number and stop\n";
 	cout << "    -h, --help           show this help message\n\n";
@@ -76,9 +83,13 @@ static void usage(const char *name) {
 struct CLOptions {
 	string _exec;
 	bool _interactive;
+	bool _serve;
+	string _socket;
 	CLOptions()
 			: 	_exec(""),
-				_interactive(false) {
+				_interactive(false),
+				_serve(false),
+				_socket("") {
 	}
 };
 
@@ -112,6 +123,28 @@ vector<string> read_options(int argc, char* argv[], CLOptions& cloptions) {
 			argv++;
 		} else if (str == "--nowarnings") {
 			setOption(BoolType::SHOWWARNINGS, false);
+		} else if (str == "--serve") {
+			cloptions._serve = true;
+		} else if (str == "--socket") {
+			if (argc == 0) {
+				Error::error("--socket option should be followed by a path.");
+				continue;
+			}
+			cloptions._socket = argv[0];
+			argc--;
+			argv++;
+		} else if (str == "--nosnapshot") {
+			StartupSnapshot::setMode(SnapshotMode::IGNORE);
+		} else if (str == "--writesnapshot") {
+			StartupSnapshot::setMode(SnapshotMode::WRITE);
+		} else if (str == "--snapshot") {
+			if (argc == 0) {
+				Error::error("--snapshot option should be followed by a path.");
+				continue;
+			}
+			StartupSnapshot::setPath(argv[0]);
+			argc--;
+			argv++;
 		} else if (str == "-v" || str == "--version") {
 			cout << GIDLVERSION << " - (git hash: " << GITHASH << ")\n";
 			exit(0);
@@ -397,6 +430,21 @@ int run(int argc, char* argv[]) {
 	vector<string> inputfiles = read_options(argc, argv, cloptions);
 
 	DataManager m;
+	if (StartupSnapshot::mode() == SnapshotMode::WRITE) { // Written while setting up the data
+		return Error::nr_of_errors() == 0 ? 0 : 1;
+	}
+
+	if (cloptions._serve) { // Requests are read from stdin, so the input can only come from the files
+		try {
+			parse(inputfiles);
+		} catch (const Exception& ex) {
+			Error::error("Exception caught: " + ex.getMessage());
+		}
+		if (Error::nr_of_errors() > 0) {
+			return 1;
+		}
+		return serve(cloptions._socket);
+	}
 
 	bool readfromstdin = false;
 	// Only read from stdin if no inputfiles were provided (otherwise, we would have file ordering issues anyway)
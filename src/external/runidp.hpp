@@ -16,6 +16,8 @@
 #include <vector>
 #include <ostream>
 
+class DomainElement;
+
 enum class Status {
 	SUCCESS, FAIL
 };
@@ -25,6 +27,9 @@ std::ostream& operator<<(std::ostream& stream, Status status);
 int run(int argc, char* argv[]);
 int run(const std::vector<std::string>& inputfiles, bool interact, bool readstdin, const std::string& command);
 
+//! Executes the given Lua chunk, handling signals and resource limits. Returns the value it returns, if any.
+const DomainElement* executeProcedure(const std::string& proc);
+
 Status test(const std::vector<std::string>& inputfileurls, const std::string& executioncommand = "");
 
 #endif /* RUNGIDL_HPP_ */
@@ -0,0 +1,437 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "serve.hpp"
+#include <algorithm>
+#include <chrono>
+#include "common.hpp"
+#include "errorhandling/error.hpp"
+#include "lua/luaconnection.hpp"
+#include "GlobalData.hpp"
+#include "options.hpp"
+#include "runidp.hpp"
+#include "utils/StringUtils.hpp"
+
+#ifdef UNIX
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+// Name of the Lua global through which the value of a request is passed back
+const char* resultglobal = "__idp_serve_result";
+
+double wallclock() {
+	return chrono::duration<double, milli>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Sets an option of the global options from its textual value. Returns false if the option or the value is not valid.
+bool setRequestOption(const string& name, const string& value, string& error) {
+	auto options = getGlobal()->getOptions();
+	if (not options->isOption(name)) {
+		error = "There is no option named " + name + ".";
+		return false;
+	}
+	bool allowed = false;
+	if (options->isOptionOfType<bool>(name) && (value == "true" || value == "false")) {
+		allowed = options->isAllowedValue(name, value == "true");
+		if (allowed) {
+			options->setValue(name, value == "true");
+		}
+	} else if (options->isOptionOfType<int>(name) && isInt(value)) {
+		allowed = options->isAllowedValue(name, toInt(value));
+		if (allowed) {
+			options->setValue(name, toInt(value));
+		}
+	} else if (options->isOptionOfType<double>(name) && isDouble(value)) {
+		allowed = options->isAllowedValue(name, toDouble(value));
+		if (allowed) {
+			options->setValue(name, toDouble(value));
+		}
+	} else if (options->isOptionOfType<string>(name)) {
+		allowed = options->isAllowedValue(name, value);
+		if (allowed) {
+			options->setValue(name, value);
+		}
+	}
+	if (not allowed) {
+		error = "\"" + value + "\" is not a valid value for option " + name + ".\n" + options->printAllowedValues(name) + ".";
+	}
+	return allowed;
+}
+
+}
+
+Response::Response(const string& id)
+		: 	id(id),
+			status("ok"),
+			time(0) {
+}
+
+bool RequestReader::addLine(string line, Request& request) {
+	if (not line.empty() && line[line.size() - 1] == '\r') {
+		line.erase(line.size() - 1);
+	}
+	if (_inchunk) {
+		if (line == ".") {
+			_inchunk = false;
+			_current.chunk = _chunk.str();
+			request = _current;
+			return true;
+		}
+		if (startsWith(line, "..")) {
+			line = line.substr(1);
+		}
+		_chunk << line << "\n";
+		return false;
+	}
+	auto words = split(trim(line), " ");
+	words.erase(remove(words.begin(), words.end(), ""), words.end());
+	if (words.empty()) {
+		return false;
+	}
+	_current = Request();
+	_current.command = words[0];
+	_current.id = words.size() > 1 ? words[1] : "-";
+	for (size_t i = 2; i < words.size(); ++i) {
+		auto pos = words[i].find('=');
+		if (pos == string::npos) {
+			_current.options.push_back( { words[i], "" });
+		} else {
+			_current.options.push_back( { words[i].substr(0, pos), words[i].substr(pos + 1) });
+		}
+	}
+	if (_current.command == "request") {
+		_inchunk = true;
+		_chunk.str("");
+		return false;
+	}
+	request = _current;
+	return true;
+}
+
+Response handle(const Request& request) {
+	Response response(request.id);
+	auto start = wallclock();
+
+	auto backup = new Options(false);
+	backup->copyValues(*getGlobal()->getOptions());
+	bool valid = true;
+	for (auto& option : request.options) {
+		string error;
+		if (not setRequestOption(option.first, option.second, error)) {
+			response.payload.push_back(error);
+			valid = false;
+		}
+	}
+
+	if (not valid) {
+		response.status = "error";
+	} else {
+		stringstream ss;
+		ss << "local __results = {(function()\n" << request.chunk << "\nend)()}\n";
+		ss << "if #__results > 0 then " << resultglobal << " = tostring(__results[1]) end";
+		executeProcedure(ss.str());
+
+		auto state = LuaConnection::getState();
+		lua_getglobal(state, resultglobal);
+		if (lua_isstring(state, -1)) {
+			response.payload = split(lua_tostring(state, -1), "\n");
+		}
+		lua_pop(state, 1);
+		lua_pushnil(state);
+		lua_setglobal(state, resultglobal);
+
+		if (getGlobal()->timedout()) {
+			response.status = "timeout";
+			response.payload.clear();
+		} else if (Error::nr_of_errors() > 0) {
+			response.status = "error";
+			response.payload.clear();
+			for (auto& error : getGlobal()->getErrors()) {
+				response.payload.push_back(trim(error));
+			}
+		}
+	}
+
+	getGlobal()->getOptions()->copyValues(*backup);
+	delete (backup);
+	getGlobal()->clearStats();
+	response.time = wallclock() - start;
+	return response;
+}
+
+#ifndef UNIX
+
+int serve(const string&) {
+	Error::error("Serve mode is only supported on Unix systems.");
+	return 1;
+}
+
+#else
+
+namespace {
+
+struct ServeStatistics {
+	double start;
+	unsigned int nbrequests, nberrors, nbtimeouts;
+	double totaltime, maxtime;
+	ServeStatistics()
+			: 	start(wallclock()),
+				nbrequests(0),
+				nberrors(0),
+				nbtimeouts(0),
+				totaltime(0),
+				maxtime(0) {
+	}
+	void add(const Response& response) {
+		++nbrequests;
+		if (response.status == "error") {
+			++nberrors;
+		} else if (response.status == "timeout") {
+			++nbtimeouts;
+		}
+		totaltime += response.time;
+		maxtime = max(maxtime, response.time);
+	}
+	vector<string> print() const {
+		auto uptime = (wallclock() - start) / 1000;
+		vector<string> lines;
+		lines.push_back("requests: " + convertToString(nbrequests));
+		lines.push_back("errors: " + convertToString(nberrors));
+		lines.push_back("timeouts: " + convertToString(nbtimeouts));
+		lines.push_back("average latency (ms): " + convertToString(nbrequests == 0 ? 0 : totaltime / nbrequests));
+		lines.push_back("maximum latency (ms): " + convertToString(maxtime));
+		lines.push_back("uptime (s): " + convertToString(uptime));
+		lines.push_back("throughput (requests/s): " + convertToString(uptime == 0 ? 0 : nbrequests / uptime));
+		return lines;
+	}
+};
+
+bool writeAll(int fd, const string& text) {
+	size_t written = 0;
+	while (written < text.size()) {
+		auto n = write(fd, text.data() + written, text.size() - written);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		written += n;
+	}
+	return true;
+}
+
+bool send(int fd, const Response& response) {
+	stringstream ss;
+	ss << "response " << response.id << " " << response.status << " " << (long long) response.time << "\n";
+	for (auto line : response.payload) {
+		if (startsWith(line, ".")) {
+			line = "." + line;
+		}
+		ss << line << "\n";
+	}
+	ss << ".\n";
+	return writeAll(fd, ss.str());
+}
+
+/**
+ * Handles any command. Returns false if the server should shut down.
+ */
+bool dispatch(const Request& request, ServeStatistics& statistics, int fd) {
+	if (request.command == "request") {
+		auto response = handle(request);
+		statistics.add(response);
+		send(fd, response);
+		return true;
+	}
+	Response response(request.id);
+	if (request.command == "stats") {
+		response.payload = statistics.print();
+	} else if (request.command == "shutdown") {
+		send(fd, response);
+		return false;
+	} else {
+		response.status = "error";
+		response.payload.push_back("Unknown command " + request.command + ", expected request, stats or shutdown.");
+	}
+	send(fd, response);
+	return true;
+}
+
+int serveStdin(ServeStatistics& statistics) {
+	// Answers go to the original stdout, everything printed while handling a request goes to stderr
+	auto out = dup(STDOUT_FILENO);
+	dup2(STDERR_FILENO, STDOUT_FILENO);
+
+	RequestReader reader;
+	string line;
+	Request request;
+	bool running = true;
+	while (running && getline(cin, line)) {
+		if (reader.addLine(line, request)) {
+			running = dispatch(request, statistics, out);
+		}
+	}
+	close(out);
+	return 0;
+}
+
+struct Connection {
+	int fd;
+	string buffer; //!< Received text which has not been processed yet
+	RequestReader reader;
+	bool closed;
+	Connection(int fd)
+			: 	fd(fd),
+				closed(false) {
+	}
+
+	// Returns true if a complete request was found in the received text
+	bool nextRequest(Request& request) {
+		size_t pos;
+		while ((pos = buffer.find('\n')) != string::npos) {
+			auto line = buffer.substr(0, pos);
+			buffer.erase(0, pos + 1);
+			if (reader.addLine(line, request)) {
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+/**
+ * Accepts any number of connections, each sending any number of requests.
+ * NOTE: requests are handled one at a time, in round-robin order over the connections.
+ * All requests share the one Lua state and the global data (options, errors, termination), which are not thread-safe,
+ * so even read-only requests cannot be handled concurrently.
+ */
+int serveSocket(const string& socketpath, ServeStatistics& statistics) {
+	sockaddr_un address;
+	if (socketpath.size() >= sizeof(address.sun_path)) {
+		Error::error("The socket path " + socketpath + " is too long.");
+		return 1;
+	}
+	// A socket left behind by an earlier server is replaced, but any other file at the path is not touched
+	struct stat info;
+	if (lstat(socketpath.c_str(), &info) == 0) {
+		if (not S_ISSOCK(info.st_mode)) {
+			Error::error("The socket path " + socketpath + " exists and is not a socket.");
+			return 1;
+		}
+		if (unlink(socketpath.c_str()) != 0) {
+			Error::error("Could not remove the old socket " + socketpath + ": " + string(strerror(errno)));
+			return 1;
+		}
+	} else if (errno != ENOENT) {
+		Error::error("Could not inspect the socket path " + socketpath + ": " + string(strerror(errno)));
+		return 1;
+	}
+	auto listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0) {
+		Error::error("Could not create a socket: " + string(strerror(errno)));
+		return 1;
+	}
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, socketpath.c_str());
+	if (bind(listener, (sockaddr*) &address, sizeof(address)) != 0 || listen(listener, 16) != 0) {
+		Error::error("Could not listen on socket " + socketpath + ": " + string(strerror(errno)));
+		close(listener);
+		return 1;
+	}
+	clog << "Serving on " << socketpath << "\n";
+
+	vector<Connection> connections;
+	bool running = true;
+	bool pending = false; // Whether there are received requests which have not been handled yet
+	while (running) {
+		vector<pollfd> fds(connections.size() + 1);
+		fds[0] = {listener, POLLIN, 0};
+		for (size_t i = 0; i < connections.size(); ++i) {
+			fds[i + 1] = {connections[i].fd, POLLIN, 0};
+		}
+		if (poll(fds.data(), fds.size(), pending ? 0 : -1) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			Error::error("Polling the socket failed: " + string(strerror(errno)));
+			break;
+		}
+		for (size_t i = 0; i < connections.size(); ++i) {
+			if ((fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR)) == 0) {
+				continue;
+			}
+			char data[4096];
+			auto n = read(connections[i].fd, data, sizeof(data));
+			if (n <= 0) {
+				connections[i].closed = true;
+			} else {
+				connections[i].buffer.append(data, n);
+			}
+		}
+		if ((fds[0].revents & POLLIN) != 0) {
+			auto fd = accept(listener, NULL, NULL);
+			if (fd >= 0) {
+				connections.push_back(Connection(fd));
+			}
+		}
+
+		pending = false;
+		for (auto i = connections.begin(); running && i < connections.end(); ++i) {
+			Request request;
+			if (i->nextRequest(request)) {
+				running = dispatch(request, statistics, i->fd);
+				pending = pending || i->buffer.find('\n') != string::npos;
+			}
+		}
+		for (auto i = connections.begin(); i < connections.end();) {
+			if (i->closed && i->buffer.find('\n') == string::npos) {
+				close(i->fd);
+				i = connections.erase(i);
+			} else {
+				++i;
+			}
+		}
+	}
+
+	for (auto& connection : connections) {
+		close(connection.fd);
+	}
+	close(listener);
+	unlink(socketpath.c_str());
+	return 0;
+}
+
+}
+
+int serve(const string& socketpath) {
+	signal(SIGPIPE, SIG_IGN); // A client closing its connection should not stop the server
+	ServeStatistics statistics;
+	auto result = socketpath.empty() ? serveStdin(statistics) : serveSocket(socketpath, statistics);
+	for (auto& line : statistics.print()) {
+		clog << line << "\n";
+	}
+	return result;
+}
+
+#endif
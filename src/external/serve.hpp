@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef SERVE_HPP_
+#define SERVE_HPP_
+
+#include <string>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+/**
+ * Serve mode: keeps the parsed namespaces loaded and answers requests until shutdown.
+ *
+ * Requests are read from the Unix socket at socketpath, or from stdin (answers on stdout) if socketpath is empty.
+ * A socket left at socketpath is replaced, any other file there is an error.
+ * A request is a header line, the lines of a Lua chunk and a line containing a single dot:
+ *
+ *     request <id> [<option>=<value> ...]
+ *     <lua chunk>
+ *     .
+ *
+ * Lines of the chunk starting with a dot get an extra dot prepended (as in SMTP).
+ * The options only hold for that request, e.g. timeout=5 or verbosity=0.
+ * Besides request, the commands "stats <id>" and "shutdown <id>" (a single line, no chunk) are accepted.
+ * Every command is answered with
+ *
+ *     response <id> ok|error|timeout <milliseconds>
+ *     <payload>
+ *     .
+ *
+ * where the payload is the tostring of the value returned by the chunk, the errors, or the statistics.
+ *
+ * @return the exit code of the system
+ */
+int serve(const std::string& socketpath);
+
+struct Request {
+	std::string command, id;
+	std::vector<std::pair<std::string, std::string> > options; //!< Name and textual value, in the order of the header
+	std::string chunk;
+};
+
+struct Response {
+	std::string id, status;
+	double time; //!< In milliseconds
+	std::vector<std::string> payload;
+	Response(const std::string& id);
+};
+
+/**
+ * Collects lines into requests, undoing the dot-stuffing of their chunks
+ */
+class RequestReader {
+private:
+	bool _inchunk;
+	Request _current;
+	std::stringstream _chunk;
+
+public:
+	RequestReader()
+			: _inchunk(false) {
+	}
+
+	//! Returns true if the line completed a request, which is then stored in request
+	bool addLine(std::string line, Request& request);
+};
+
+/**
+ * Runs the chunk of a request with the options of the request.
+ * The options are restored and the errors are cleared afterwards, so requests do not influence each other
+ * (except through the Lua globals they assign, which is what keeps objects loaded between requests).
+ */
+Response handle(const Request& request);
+
+#endif /* SERVE_HPP_ */
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include "structure/information/EstimateBDDInferenceCost.hpp"
 #include "utils/ListUtils.hpp"
+#include "structure/TableStatistics.hpp"
 
 using namespace std;
 
@@ -108,11 +109,17 @@ double BddStatistics::estimateNrAnswers(const FOBDD* bdd, const fobddvarset& var
 	return chance * toDouble(univanswers);
 }
 double BddStatistics::estimateNrAnswers(const FOBDDKernel* kernel, const fobddvarset& vars, const indexset& indices) {
+	auto univanswers = univNrAnswers(vars, indices, structure);
+	if (isa<FOBDDAtomKernel>(*kernel)) {
+		auto answers = estimateNrAnswersFromStatistics(dynamic_cast<const FOBDDAtomKernel*>(kernel), vars, indices);
+		if (answers >= 0) {
+			return univanswers.isInfinite() ? answers : min(answers, toDouble(univanswers));
+		}
+	}
 	auto chance = tabledEstimateChance(kernel);
 	if (chance <= 0) {
 		return 0;
 	}
-	auto univanswers = univNrAnswers(vars, indices, structure);
 	return chance * toDouble(univanswers);
 }
 
@@ -122,6 +129,60 @@ bool isArithmetic(const BddNode* k, std::shared_ptr<FOBDDManager> manager) {
 	return ac.isArithmeticFormula(k);
 }
 
+/**
+ * Returns for each argument of the atom whether it is input, i.e., it contains none of the given variables and indices
+ */
+vector<bool> inputPattern(const FOBDDAtomKernel* atomkernel, const fobddvarset& vars, const indexset& ind, std::shared_ptr<FOBDDManager> manager) {
+	vector<bool> pattern;
+	for (auto it = atomkernel->args().cbegin(); it != atomkernel->args().cend(); ++it) {
+		bool input = true;
+		for (auto jt = vars.cbegin(); jt != vars.cend(); ++jt) {
+			if (manager->contains(*it, *jt)) {
+				input = false;
+				break;
+			}
+		}
+		if (input) {
+			for (auto jt = ind.cbegin(); jt != ind.cend(); ++jt) {
+				if ((*it)->containsDeBruijnIndex((*jt)->index())) {
+					input = false;
+					break;
+				}
+			}
+		}
+		pattern.push_back(input);
+	}
+	return pattern;
+}
+
+/**
+ * Estimates the number of answers of an atom over an enumerated table from the statistics of that table,
+ * which, unlike the chance of the atom, take skew in the data into account.
+ * Returns a negative number if no statistics are available.
+ */
+double BddStatistics::estimateNrAnswersFromStatistics(const FOBDDAtomKernel* atomkernel, const fobddvarset& vars, const indexset& indices) {
+	if (atomkernel->type() == AtomKernelType::AKT_CF || isArithmetic(atomkernel, manager)) {
+		return -1;
+	}
+	for (auto arg : atomkernel->args()) {
+		if (not isa<FOBDDVariable>(*arg) && not isa<FOBDDDeBruijnIndex>(*arg)) {
+			return -1; // Lookups on nested terms do not follow the distribution of the column
+		}
+	}
+	auto symbol = atomkernel->symbol();
+	PredInter* pinter;
+	if (symbol->isPredicate()) {
+		pinter = structure->inter(dynamic_cast<Predicate*>(symbol));
+	} else {
+		pinter = structure->inter(dynamic_cast<Function*>(symbol))->graphInter();
+	}
+	auto statistics = TableStatistics::get(pinter->ct());
+	if (statistics == NULL) {
+		return -1;
+	}
+	return statistics->expectedMatches(inputPattern(atomkernel, vars, indices, manager));
+}
+
 double BddStatistics::calculateEqualityChance(const FOBDDTerm* term1, Sort* term2sort, bool ineq) {
 	//We now have something of the form x=y.
 	//In general, the chance of this succeeding is:
@@ -540,28 +601,8 @@ double BddStatistics::estimateCostAll(bool sign, const FOBDDKernel* kernel, cons
 			}
 		}
 
-		vector<bool> pattern;
-		for (auto it = atomkernel->args().cbegin(); it != atomkernel->args().cend(); ++it) {
-			bool input = true;
-			for (auto jt = vars.cbegin(); jt != vars.cend(); ++jt) {
-				if (manager->contains(*it, *jt)) {
-					input = false;
-					break;
-				}
-			}
-			if (input) {
-				for (auto jt = ind.cbegin(); jt != ind.cend(); ++jt) {
-					if ((*it)->containsDeBruijnIndex((*jt)->index())) {
-						input = false;
-						break;
-					}
-				}
-			}
-			pattern.push_back(input);
-		}
-
 		EstimateEnumerationCost tce;
-		auto result = tce.run(pt, pattern);
+		auto result = tce.run(pt, inputPattern(atomkernel, vars, ind, manager));
 		kernelstorage[sign][kernel][vars][ind] = result;
 		return result;
 	} else {
@@ -21,6 +21,7 @@ class Structure;
 class FOBDDManager;
 class FOBDDDeBruijnIndex;
 class FOBDDKernel;
+class FOBDDAtomKernel;
 class FOBDD;
 
 typedef fobddindexset indexset;
@@ -117,6 +118,7 @@ private:
 	}
 	double estimateNrAnswers(const FOBDD* bdd, const fobddvarset& vars, const indexset& indices);
 	double estimateNrAnswers(const FOBDDKernel* kernel, const fobddvarset& vars, const indexset& indices);
+	double estimateNrAnswersFromStatistics(const FOBDDAtomKernel* atomkernel, const fobddvarset& vars, const indexset& indices);
 
 private:
 	std::map<const FOBDD*, std::map<fobddvarset, std::map<indexset, double> > > bddcosts;
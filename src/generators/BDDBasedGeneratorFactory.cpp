@@ -35,10 +35,14 @@
 #include "ComparisonGenerator.hpp"
 #include "GeneratorFactory.hpp"
 #include "QuantKernelGenerators.hpp"
+#include "LeapfrogJoinGenerator.hpp"
+#include "structure/StructureComponents.hpp"
 #include "errorhandling/error.hpp"
 
 #include "theory/TheoryUtils.hpp"
 
+#include <algorithm>
+
 #ifdef __APPLE__
 #include <sys/types.h>
 #endif
@@ -200,6 +204,15 @@ InstGenerator* BDDToGenerator::createFromBDD(const BddGeneratorData& data, bool
 		//IMPORTANT!!! every return should reset the _manager!!!
 		_manager = optimizemanager;
 	}
+	auto joingenerator = createJoinGenerator(newdata);
+	if (joingenerator != NULL) {
+		if (getOption(VERBOSE_GEN_AND_CHECK) > 1) {
+			clog << "Creating leapfrog join generator\n";
+		}
+		_manager = backupmanager;
+		return joingenerator;
+	}
+
 	// Copy data to branchdata.  This data will be used for one of the branches.
 	// It is practically the same as data except for the pattern (since the kernel might set some variables)
 	BddGeneratorData branchdata = newdata;
@@ -318,6 +331,150 @@ InstGenerator* BDDToGenerator::createFromBDD(const BddGeneratorData& data, bool
 	return new TwoChildGenerator(kernelchecker, kernelgenerator, falsegenerator, truegenerator);
 }
 
+/*
+ * Returns true iff the hypergraph with the given edges is cyclic, using GYO-reduction:
+ * repeatedly remove vertices that occur in only one edge and edges that are contained in another edge.
+ * The hypergraph is acyclic iff this removes all but one edge.
+ */
+bool isCyclic(vector<set<unsigned int> > edges) {
+	bool changed = true;
+	while (changed && edges.size() > 1) {
+		changed = false;
+		map<unsigned int, unsigned int> occurrences;
+		for (auto edge = edges.cbegin(); edge < edges.cend(); ++edge) {
+			for (auto vertex = edge->cbegin(); vertex != edge->cend(); ++vertex) {
+				++occurrences[*vertex];
+			}
+		}
+		for (auto edge = edges.begin(); edge < edges.end(); ++edge) {
+			for (auto vertex = edge->begin(); vertex != edge->end();) {
+				if (occurrences[*vertex] == 1) {
+					edge->erase(vertex++);
+					changed = true;
+				} else {
+					++vertex;
+				}
+			}
+		}
+		for (unsigned int n = 0; n < edges.size(); ++n) {
+			for (unsigned int m = 0; m < edges.size(); ++m) {
+				if (n != m && includes(edges[m].cbegin(), edges[m].cend(), edges[n].cbegin(), edges[n].cend())) {
+					edges.erase(edges.begin() + n);
+					changed = true;
+					--n;
+					break;
+				}
+			}
+		}
+	}
+	return edges.size() > 1;
+}
+
+InstGenerator* BDDToGenerator::createJoinGenerator(const BddGeneratorData& data) {
+	// Collect the conjunction of atoms
+	vector<const FOBDDAtomKernel*> kernels;
+	for (auto bdd = data.bdd; bdd != _manager->truebdd(); bdd = bdd->truebranch()) {
+		if (bdd == _manager->falsebdd() || bdd->falsebranch() != _manager->falsebdd() || not isa<FOBDDAtomKernel>(*bdd->kernel())) {
+			return NULL;
+		}
+		kernels.push_back(dynamic_cast<const FOBDDAtomKernel*>(bdd->kernel()));
+	}
+	if (kernels.size() < 3) {
+		return NULL;
+	}
+
+	auto firstocc = getFirstOccurences(data.vars);
+	for (unsigned int n = 0; n < firstocc.size(); ++n) {
+		if (firstocc[n] != n) {
+			return NULL;
+		}
+	}
+
+	// Check that all atoms are over enumerated tables and only have variables as arguments
+	vector<const PredTable*> tables;
+	vector<vector<unsigned int> > atomvars;
+	vector<bool> occurs(data.vars.size(), false);
+	for (auto kernel = kernels.cbegin(); kernel < kernels.cend(); ++kernel) {
+		auto symbol = (*kernel)->symbol();
+		if ((*kernel)->type() == AtomKernelType::AKT_CF || symbol->builtin()) {
+			return NULL;
+		}
+		if (symbol->isPredicate() && dynamic_cast<Predicate*>(symbol)->type() != SymbolType::ST_NONE) {
+			return NULL;
+		}
+		auto table = data.structure->inter(symbol)->ct();
+		if (not isa<EnumeratedInternalPredTable>(*table->internTable())) {
+			return NULL;
+		}
+		vector<unsigned int> vars;
+		for (auto arg = (*kernel)->args().cbegin(); arg < (*kernel)->args().cend(); ++arg) {
+			if (not isa<FOBDDVariable>(**arg)) {
+				return NULL;
+			}
+			auto position = find(data.bddvars.cbegin(), data.bddvars.cend(), dynamic_cast<const FOBDDVariable*>(*arg));
+			if (position == data.bddvars.cend()) {
+				return NULL;
+			}
+			vars.push_back(position - data.bddvars.cbegin());
+			occurs[vars.back()] = true;
+		}
+		tables.push_back(table);
+		atomvars.push_back(vars);
+	}
+
+	// Inputs become the first levels, outputs the others, ordered on the number of atoms containing them
+	vector<unsigned int> inputs, outputs;
+	vector<unsigned int> nratoms(data.vars.size(), 0);
+	for (auto vars = atomvars.cbegin(); vars < atomvars.cend(); ++vars) {
+		set<unsigned int> unique(vars->cbegin(), vars->cend());
+		for (auto var = unique.cbegin(); var != unique.cend(); ++var) {
+			++nratoms[*var];
+		}
+	}
+	for (unsigned int n = 0; n < data.vars.size(); ++n) {
+		if (data.pattern[n] == Pattern::OUTPUT) {
+			if (not occurs[n]) {
+				return NULL;
+			}
+			outputs.push_back(n);
+		} else if (occurs[n]) {
+			inputs.push_back(n);
+		}
+	}
+	stable_sort(outputs.begin(), outputs.end(), [&nratoms](unsigned int a, unsigned int b) {return nratoms[a] > nratoms[b];});
+
+	vector<unsigned int> levelof(data.vars.size(), 0);
+	vector<const DomElemContainer*> invars, outvars;
+	vector<SortTable*> outsorts;
+	for (auto n = inputs.cbegin(); n < inputs.cend(); ++n) {
+		levelof[*n] = invars.size();
+		invars.push_back(data.vars[*n]);
+	}
+	for (auto n = outputs.cbegin(); n < outputs.cend(); ++n) {
+		levelof[*n] = invars.size() + outvars.size();
+		outvars.push_back(data.vars[*n]);
+		outsorts.push_back(data.universe.tables()[*n]);
+	}
+
+	vector<set<unsigned int> > edges;
+	for (auto vars = atomvars.begin(); vars < atomvars.end(); ++vars) {
+		set<unsigned int> edge;
+		for (auto var = vars->begin(); var < vars->end(); ++var) {
+			*var = levelof[*var];
+			if (*var >= inputs.size()) {
+				edge.insert(*var);
+			}
+		}
+		edges.push_back(edge);
+	}
+	if (not isCyclic(edges)) { // The existing generators are already optimal for acyclic patterns
+		return NULL;
+	}
+
+	auto atoms = LeapfrogJoinGenerator::createAtoms(tables, atomvars, invars.size() + outvars.size());
+	return new LeapfrogJoinGenerator(atoms, invars, outvars, outsorts);
+}
+
 /*
  * Given matchingPattern (input or output), try to rewrite atom as ... op x
  * with x a variable with the right pattern
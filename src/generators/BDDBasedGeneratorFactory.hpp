@@ -115,6 +115,12 @@ private:
 			const std::vector<Variable*> & atomvars, const Universe & universe, QuantForm *quantform, const Structure *structure,
 			std::vector<Formula*> conjunction, Formula *origatom, BRANCH branchToGenerate);
 
+	/**
+	 * Returns a leapfrog join generator if the bdd is a conjunction of at least three enumerated atoms
+	 * whose output variables form a cyclic pattern, NULL otherwise.
+	 */
+	InstGenerator* createJoinGenerator(const BddGeneratorData& data);
+
 	/**
 	 * The boolean represents whether or not we should optimze the Bdd. In general: we optimize every time we enter a quantkernel (and initially)
 	 * --> Every time an extra variable is queried
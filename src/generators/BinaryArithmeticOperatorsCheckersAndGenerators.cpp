@@ -155,27 +155,45 @@ DomainElementType ArithOpGenerator::getOutType() {
 }
 
 ArithOpGenerator::ArithOpGenerator(const DomElemContainer* in1, const DomElemContainer* in2, const DomElemContainer* out, NumType requestedType, SortTable* dom)
-		: _in1(in1), _in2(in2), _out(out), _outdom(dom), _requestedType(requestedType), alreadyrun(false) {
+		: _in1(in1), _in2(in2), _out(out), _outdom(dom), _requestedType(requestedType), alreadyrun(false), _outrange(dom->isIntRange()), _outmin(0), _outmax(0) {
+	if (_outrange) {
+		_outmin = dom->first()->value()._int;
+		_outmax = dom->last()->value()._int;
+	}
 }
 
 void ArithOpGenerator::reset() {
 	alreadyrun = false;
 }
 
-void ArithOpGenerator::internalSetVarsAgain(){ // NOTE: duplication with next()
+// Returns the result of the operation on the current input, NULL if it is undefined or not in the output domain
+// NOTE: integer results outside an integer range output domain are rejected before they are turned into a domain element
+const DomainElement* ArithOpGenerator::calculate() {
 	double result;
+	// FIXME code duplication with calculations with overflow checking in NumericOperations.hpp (add outputtype to those functions)
 	ARITHRESULT status = doCalculation(getValue(_in1), getValue(_in2), result);
-	if (getOutType() == DET_INT && not isInt(result)) { // NOTE: checks whether no overflow occurred
+	auto outtype = getOutType();
+	if (outtype == DET_INT && not isInt(result)) { // NOTE: checks whether no overflow occurred
 		status = ARITHRESULT::INVALID;
 	}
 	if (status != ARITHRESULT::VALID) {
-		*_out = (const DomainElement*) NULL;
-	}else{
-		*_out = createDomElem(getOutType() == DET_INT ? int(result) : result, _requestedType);
-		if (not _outdom->contains(_out->get())) {
-			*_out = (const DomainElement*) NULL;
+		return NULL;
+	}
+	if (outtype == DET_INT && _outrange) {
+		if (result < _outmin || result > _outmax) {
+			return NULL;
 		}
+		return createDomElem(int(result), _requestedType);
+	}
+	auto value = createDomElem(outtype == DET_INT ? int(result) : result, _requestedType);
+	if (not _outdom->contains(value)) {
+		return NULL;
 	}
+	return value;
+}
+
+void ArithOpGenerator::internalSetVarsAgain(){
+	*_out = calculate();
 }
 
 void ArithOpGenerator::next() {
@@ -183,22 +201,11 @@ void ArithOpGenerator::next() {
 		notifyAtEnd();
 		return;
 	}
-	double result;
-	// FIXME code duplication with calculations with overflow checking in NumericOperations.hpp (add outputtype to those functions)
-	ARITHRESULT status = doCalculation(getValue(_in1), getValue(_in2), result);
-	if (getOutType() == DET_INT && not isInt(result)) { // NOTE: checks whether no overflow occurred
-		status = ARITHRESULT::INVALID;
-	}
-	if (status != ARITHRESULT::VALID) {
+	*_out = calculate();
+	if (_out->get() == NULL) {
 		notifyAtEnd();
-		*_out = (const DomainElement*) NULL;
 		return;
 	}
-	*_out = createDomElem(getOutType() == DET_INT ? int(result) : result, _requestedType);
-	if (not _outdom->contains(_out->get())) {
-		notifyAtEnd();
-		*_out = (const DomainElement*) NULL;
-	}
 	alreadyrun = true;
 }
 
@@ -38,6 +38,8 @@ private:
 	SortTable* _outdom;
 	NumType _requestedType;
 	bool alreadyrun;
+	bool _outrange; //!< Whether the output domain is a finite integer range, which is then checked on the unboxed result
+	double _outmin, _outmax;
 protected:
 	virtual ARITHRESULT doCalculation(double left, double right, double& result) const = 0;
 	virtual DomainElementType getOutType();
@@ -64,6 +66,7 @@ public:
 	void internalSetVarsAgain();
 private:
 	double getValue(const DomElemContainer* cont) const;
+	const DomainElement* calculate();
 };
 
 class DivGenerator: public ArithOpGenerator {
@@ -15,7 +15,8 @@ ComparisonGenerator::ComparisonGenerator(SortTable* leftsort, SortTable* rightso
 		const DomElemContainer* leftvalue, const DomElemContainer* rightvalue,
 		Input input, CompType type)
 		: _leftsort(leftsort), _rightsort(rightsort), _leftvar(leftvalue), _rightvar(rightvalue), _comparison(type), _input(input),
-			_left(leftsort->sortBegin()), _right(rightsort->sortBegin()), _reset(true), increaseouter(false) {
+			_left(leftsort->sortBegin()), _right(rightsort->sortBegin()), _reset(true), increaseouter(false), _ranges(false), _inranges(false),
+			_leftmin(0), _leftmax(0), _rightmin(0), _rightmax(0), _x(0), _xmax(0), _y(0), _ymax(0) {
 	if (_input == Input::RIGHT) {
 		_leftsort = rightsort;
 		_rightsort = leftsort;
@@ -30,6 +31,15 @@ ComparisonGenerator::ComparisonGenerator(SortTable* leftsort, SortTable* rightso
 	if (not rightIsInput() && not _right.isAtEnd()) {
 		_latestright = *_right;
 	}
+	if (_input != Input::BOTH && _comparison != CompType::NEQ && _rightsort->isIntRange() && (leftIsInput() || _leftsort->isIntRange())) {
+		_ranges = true;
+		_rightmin = _rightsort->first()->value()._int;
+		_rightmax = _rightsort->last()->value()._int;
+		if (not leftIsInput()) {
+			_leftmin = _leftsort->first()->value()._int;
+			_leftmax = _leftsort->last()->value()._int;
+		}
+	}
 }
 
 void ComparisonGenerator::put(std::ostream& stream) const {
@@ -90,7 +100,95 @@ void ComparisonGenerator::findNext(SortIterator* finiteside, SortIterator* undef
 	}
 }
 
+bool ComparisonGenerator::useRanges() const {
+	return _ranges && (not leftIsInput() || _leftvar->get()->type() == DomainElementType::DET_INT);
+}
+
+/**
+ * Enumerates x op y for x in [_x, _xmax] and, for each x, y in the interval of the right range satisfying the comparison.
+ * The bounds of x are narrowed beforehand such that the interval of y is never empty.
+ */
+void ComparisonGenerator::nextInRanges() {
+	if (_reset) {
+		_reset = false;
+		if (leftIsInput()) {
+			_x = _xmax = _leftvar->get()->value()._int;
+		} else {
+			_x = _leftmin;
+			_xmax = _leftmax;
+		}
+		switch (_comparison) {
+		case CompType::LT:
+			_xmax = std::min(_xmax, _rightmax - 1);
+			break;
+		case CompType::LEQ:
+			_xmax = std::min(_xmax, _rightmax);
+			break;
+		case CompType::GT:
+			_x = std::max(_x, _rightmin + 1);
+			break;
+		case CompType::GEQ:
+			_x = std::max(_x, _rightmin);
+			break;
+		case CompType::EQ:
+			_x = std::max(_x, _rightmin);
+			_xmax = std::min(_xmax, _rightmax);
+			break;
+		case CompType::NEQ:
+			throw InternalIdpException("Invalid code path in comparisongenerator.");
+		}
+	} else if (_y < _ymax) {
+		++_y;
+		*_rightvar = createDomElem((int) _y);
+		return;
+	} else {
+		++_x;
+	}
+	if (_x > _xmax) {
+		notifyAtEnd();
+		return;
+	}
+	switch (_comparison) {
+	case CompType::LT:
+		_y = std::max(_x + 1, _rightmin);
+		_ymax = _rightmax;
+		break;
+	case CompType::LEQ:
+		_y = std::max(_x, _rightmin);
+		_ymax = _rightmax;
+		break;
+	case CompType::GT:
+		_y = _rightmin;
+		_ymax = std::min(_x - 1, _rightmax);
+		break;
+	case CompType::GEQ:
+		_y = _rightmin;
+		_ymax = std::min(_x, _rightmax);
+		break;
+	case CompType::EQ:
+		_y = _ymax = _x;
+		break;
+	case CompType::NEQ:
+		throw InternalIdpException("Invalid code path in comparisongenerator.");
+	}
+	if (not leftIsInput()) {
+		*_leftvar = createDomElem((int) _x);
+	}
+	*_rightvar = createDomElem((int) _y);
+}
+
 void ComparisonGenerator::next() {
+	if (_reset) {
+		_inranges = useRanges();
+	}
+	if (_inranges) {
+		nextInRanges();
+		if (not isAtEnd()) {
+			_latestleft = _leftvar->get();
+			_latestright = _rightvar->get();
+		}
+		return;
+	}
 	switch (_input) {
 	case Input::BOTH:
 		if (_reset && correct()) {
@@ -40,6 +40,13 @@ private:
 
 	bool _reset, increaseouter;
 
+	// Unboxed fast path, used if the generated sides are integer ranges and the comparison is not ~=
+	// The values are enumerated as plain integers and only the generated values are turned into domain elements
+	bool _ranges; //!< Whether the generated sides are integer ranges
+	bool _inranges; //!< Whether the fast path is used since the last reset
+	long long _leftmin, _leftmax, _rightmin, _rightmax; //!< Bounds of the ranges, only valid if _ranges
+	long long _x, _xmax, _y, _ymax; //!< Current values and their last values (_y only up to _ymax for the current _x)
+
 	/**
 	 * The first argument is the finite one of such is available.
 	 * NOTE: optimized for EQ comparison
@@ -59,6 +66,9 @@ public:
 	void next();
 
 private:
+	bool useRanges() const;
+	void nextInRanges();
+
 	bool leftIsInput() const;
 	bool rightIsInput() const;
 
@@ -10,11 +10,8 @@
  ****************************************************************************/
 
 #include "EnumLookupGenerator.hpp"
-#include <unordered_map>
 #include "structure/MainStructureComponents.hpp"
 
-typedef std::unordered_map<ElementTuple, std::vector<ElementTuple>, HashTuple> LookupTable;
-
 EnumLookupGenerator::EnumLookupGenerator(std::shared_ptr<const LookupTable> t, const std::vector<const DomElemContainer*>& in, const std::vector<const DomElemContainer*>& out)
 		: _table(t), _currpos(_table->cend()), _invars(in), _outvars(out), _reset(true), _currargs(_invars.size()) {
 #ifdef DEBUG
@@ -13,9 +13,7 @@
 #define ENUMLOOKUPGENERATOR_HPP_
 
 #include "InstGenerator.hpp"
-#include "structure/HashElementTuple.hpp"
-
-typedef std::unordered_map<ElementTuple, std::vector<ElementTuple>, HashTuple> LookupTable;
+#include "structure/TableIndexes.hpp"
 
 /**
  * Given a map from tuples to a list of tuples, with given input variables and output variables, go over the list of tuples of the corresponding input tuple.
@@ -24,10 +22,10 @@ class EnumLookupGenerator: public InstGenerator {
 private:
 	std::shared_ptr<const LookupTable> _table;
 	LookupTable::const_iterator _currpos;
-	std::vector<ElementTuple>::const_iterator _iter;
+	std::vector<SmallElementTuple>::const_iterator _iter;
 	std::vector<const DomElemContainer*> _invars, _outvars;
 	bool _reset;
-	mutable ElementTuple _currargs;
+	mutable SmallElementTuple _currargs;
 public:
 	EnumLookupGenerator(std::shared_ptr<const LookupTable> t, const std::vector<const DomElemContainer*>& in, const std::vector<const DomElemContainer*>& out);
 
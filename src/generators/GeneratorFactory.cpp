@@ -483,57 +483,65 @@ void GeneratorFactory::visit(const IntRangeInternalSortTable* t) {
 	}
 }
 
-void GeneratorFactory::visit(const EnumeratedInternalPredTable*) {
-	auto lookuptab = shared_ptr<LookupTable>(new LookupTable());
+void GeneratorFactory::visit(const EnumeratedInternalPredTable* t) {
+	createLookupGenerator(static_cast<const InternalPredTable*>(t)->begin(_universe), t->indexes());
+}
+
+/**
+ * Creates a generator looking up the output values for the input values in an index on the visited enumerated table,
+ * of which tuples iterates over the tuples and indexes are the cached indexes.
+ * The index is shared with all other generators on the same table and pattern.
+ * NOTE: the visited table can be part of _table (e.g. of a union), so the index is built from its own tuples, not from those of _table.
+ */
+void GeneratorFactory::createLookupGenerator(InternalTableIterator* tuples, TableIndexes& indexes) {
+	TableIterator tupleit(tuples); // Deletes tuples
 	vector<const DomElemContainer*> invars, outvars;
-
+	IndexPattern indexpattern;
 	for (unsigned int n = 0; n < _pattern.size(); ++n) {
 		if (_firstocc[n] != n) {
-			continue;
-		}
-		if (_pattern[n] == Pattern::INPUT) {
+			indexpattern.push_back(_firstocc[n]);
+		} else if (_pattern[n] == Pattern::INPUT) {
+			indexpattern.push_back(TableIndexes::INPUTCOLUMN);
 			invars.push_back(_vars[n]);
 		} else {
+			indexpattern.push_back(TableIndexes::OUTPUTCOLUMN);
 			outvars.push_back(_vars[n]);
 		}
 	}
 
-	// TODO make this cheaper by adding domelem to index mappings
-	// TODO only create generator ONCE instead of multiple times if possible
-
-	//TODO: this doesn't work currently (wrong version of gcc? thus it is commented)
-	/*if(_pattern.size()>0 && invars.size()>0){
-	 lookuptab.reserve(_table->size()._size* (invars.size()/_pattern.size())); // Prevents too many rehashes
-	 }*/
+	auto lookuptab = indexes.get(indexpattern);
+	if (lookuptab == NULL) {
+		auto newtab = shared_ptr<LookupTable>(new LookupTable());
+		for (; not tupleit.isAtEnd(); ++tupleit) {
+			CHECKTERMINATION
 
-	for (auto it = _table->begin(); not it.isAtEnd(); ++it) {
-		CHECKTERMINATION
-
-		auto tuple = *it;
-		bool validunderocc = true;
-		for (unsigned int n = 0; n < _pattern.size(); ++n) {
-			// Skip tuples which do no have the same values for multiple occurrences of some variable
-			// TODO: Use dynamic programming to improve this
-			if (_firstocc[n] != n && tuple[n] != tuple[_firstocc[n]]) {
-				validunderocc = false;
-				break;
+			const auto& tuple = *tupleit;
+			bool validunderocc = true;
+			for (unsigned int n = 0; n < _pattern.size(); ++n) {
+				// Skip tuples which do no have the same values for multiple occurrences of some variable
+				if (_firstocc[n] != n && tuple[n] != tuple[_firstocc[n]]) {
+					validunderocc = false;
+					break;
+				}
 			}
-		}
-		if (not validunderocc) {
-			continue;
-		}
-		ElementTuple intuple, outtuple;
-		for (unsigned int n = 0; n < _pattern.size(); ++n) {
-			if (_firstocc[n] != n) {
+			if (not validunderocc) {
 				continue;
 			}
-			if (_pattern[n] == Pattern::INPUT) {
-				intuple.push_back(tuple[n]);
-			} else if (_firstocc[n] == n) {
-				outtuple.push_back(tuple[n]);
+			SmallElementTuple intuple, outtuple;
+			for (unsigned int n = 0; n < _pattern.size(); ++n) {
+				if (_firstocc[n] != n) {
+					continue;
+				}
+				if (_pattern[n] == Pattern::INPUT) {
+					intuple.push_back(tuple[n]);
+				} else {
+					outtuple.push_back(tuple[n]);
+				}
 			}
+			newtab->operator [](intuple).push_back(outtuple);
 		}
-		lookuptab->operator [](intuple).push_back(outtuple);
+		indexes.add(indexpattern, newtab);
+		lookuptab = newtab;
 	}
 	_generator = new EnumLookupGenerator(lookuptab, invars, outvars);
 }
@@ -662,45 +670,8 @@ void GeneratorFactory::visit(const UNAInternalFuncTable* table) {
 	_generator = new InverseUNAFuncGenerator(table->getFunction(), _pattern, _vars, _universe);
 }
 
-void GeneratorFactory::visit(const EnumeratedInternalFuncTable*) {
-	// TODO: Use dynamic programming to improve this
-	auto lookuptab = shared_ptr<LookupTable>(new LookupTable());
-	vector<const DomElemContainer*> invars;
-	vector<const DomElemContainer*> outvars;
-	for (unsigned int n = 0; n < _pattern.size(); ++n) {
-		if (_firstocc[n] == n) {
-			if (_pattern[n] == Pattern::INPUT) {
-				invars.push_back(_vars[n]);
-			} else {
-				outvars.push_back(_vars[n]);
-			}
-		}
-	}
-	for (TableIterator it = _table->begin(); not it.isAtEnd(); ++it) {
-		const ElementTuple& tuple = *it;
-		bool ok = true;
-		for (unsigned int n = 0; n < _pattern.size(); ++n) {
-			if (_firstocc[n] != n && tuple[n] != tuple[_firstocc[n]]) {
-				ok = false;
-				break;
-			}
-		}
-		if (ok) {
-			ElementTuple intuple;
-			ElementTuple outtuple;
-			for (unsigned int n = 0; n < _pattern.size(); ++n) {
-				if (_firstocc[n] == n) {
-					if (_pattern[n] == Pattern::INPUT) {
-						intuple.push_back(tuple[n]);
-					} else {
-						outtuple.push_back(tuple[n]);
-					}
-				}
-			}
-			lookuptab->operator [](intuple).push_back(outtuple);
-		}
-	}
-	_generator = new EnumLookupGenerator(lookuptab, invars, outvars);
+void GeneratorFactory::visit(const EnumeratedInternalFuncTable* t) {
+	createLookupGenerator(static_cast<const InternalFuncTable*>(t)->begin(_universe), t->indexes());
 }
 
 void GeneratorFactory::visit(const PlusInternalFuncTable* pift) {
@@ -26,6 +26,7 @@ class Universe;
 class PredForm;
 class Structure;
 class PFSymbol;
+class TableIndexes;
 
 class GeneratorFactory: public StructureVisitor {
 private:
@@ -37,6 +38,8 @@ private:
 										 //!< variable occurs first
 	InstGenerator* _generator;
 
+	void createLookupGenerator(InternalTableIterator* tuples, TableIndexes& indexes);
+
 	// NOTE: for any function, if the range is an output variable, we can use the simple func generator
 	// if the range is input, we need more specialized generators depending on the function type
 	void visit(const FuncTable* ft);
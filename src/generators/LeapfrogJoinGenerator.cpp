@@ -0,0 +1,243 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "LeapfrogJoinGenerator.hpp"
+#include <algorithm>
+#include "common.hpp"
+#include "structure/DomainElement.hpp"
+#include "structure/StructureComponents.hpp"
+
+using namespace std;
+
+// Returns the tuples of table with column i moved to column pattern[i], sorted, dropping tuples where columns moved to the same column differ
+static SortedTrie* createTrie(const PredTable* table, const TriePattern& pattern, unsigned int nrcolumns) {
+	auto trie = new SortedTrie();
+	for (auto it = table->begin(); not it.isAtEnd(); ++it) {
+		const auto& tuple = *it;
+		ElementTuple row(nrcolumns, NULL);
+		bool keep = true;
+		for (unsigned int i = 0; i < pattern.size() && keep; ++i) {
+			auto& value = row[pattern[i]];
+			if (value == NULL) {
+				value = tuple[i];
+			} else if (value != tuple[i]) { // Repeated variable with a different value
+				keep = false;
+			}
+		}
+		if (keep) {
+			trie->push_back(row);
+		}
+	}
+	sort(trie->begin(), trie->end(), Compare<ElementTuple>());
+	return trie;
+}
+
+shared_ptr<const vector<JoinAtom> > LeapfrogJoinGenerator::createAtoms(const vector<const PredTable*>& tables, const vector<vector<unsigned int> >& args,
+		unsigned int nrlevels) {
+	Assert(tables.size() == args.size());
+	auto atoms = new vector<JoinAtom>(tables.size());
+	for (size_t n = 0; n < tables.size(); ++n) {
+		auto& atom = (*atoms)[n];
+		const auto& atomargs = args[n];
+		Assert(tables[n]->arity() == atomargs.size());
+
+		// Each level occurring in the atom gets a column, in order of the levels
+		unsigned int nrcolumns = 0;
+		atom.columns = vector<int>(nrlevels, -1);
+		for (unsigned int level = 0; level < nrlevels; ++level) {
+			if (find(atomargs.cbegin(), atomargs.cend(), level) != atomargs.cend()) {
+				atom.columns[level] = nrcolumns++;
+			}
+		}
+		TriePattern pattern;
+		for (auto level = atomargs.cbegin(); level < atomargs.cend(); ++level) {
+			pattern.push_back(atom.columns[*level]);
+		}
+
+		Assert(isa<EnumeratedInternalPredTable>(*tables[n]->internTable()));
+		auto& indexes = dynamic_cast<EnumeratedInternalPredTable*>(tables[n]->internTable())->indexes();
+		atom.rows = indexes.getTrie(pattern);
+		if (atom.rows == NULL) {
+			atom.rows = shared_ptr<const SortedTrie>(createTrie(tables[n], pattern, nrcolumns));
+			indexes.addTrie(pattern, atom.rows);
+		}
+	}
+	return shared_ptr<const vector<JoinAtom> >(atoms);
+}
+
+LeapfrogJoinGenerator::LeapfrogJoinGenerator(shared_ptr<const vector<JoinAtom> > atoms, const vector<const DomElemContainer*>& invars,
+		const vector<const DomElemContainer*>& outvars, const vector<SortTable*>& outsorts)
+		: 	_atoms(atoms),
+			_invars(invars),
+			_outvars(outvars),
+			_outsorts(outsorts),
+			_participants(outvars.size()),
+			_ranges(outvars.size() + 1, vector<Range>(atoms->size())),
+			_invalues(invars.size()),
+			_outvalues(outvars.size()),
+			_reset(true) {
+	Assert(_outsorts.size() == _outvars.size());
+	for (unsigned int level = 0; level < _outvars.size(); ++level) {
+		for (unsigned int a = 0; a < _atoms->size(); ++a) {
+			if ((*_atoms)[a].columns[_invars.size() + level] >= 0) {
+				_participants[level].push_back(a);
+			}
+		}
+		Assert(not _participants[level].empty());
+	}
+}
+
+LeapfrogJoinGenerator* LeapfrogJoinGenerator::clone() const {
+	return new LeapfrogJoinGenerator(*this);
+}
+
+void LeapfrogJoinGenerator::reset() {
+	_reset = true;
+}
+
+bool LeapfrogJoinGenerator::bindInputs() {
+	for (unsigned int i = 0; i < _invars.size(); ++i) {
+		_invalues[i] = _invars[i]->get();
+	}
+	for (unsigned int a = 0; a < _atoms->size(); ++a) {
+		const auto& atom = (*_atoms)[a];
+		Range range(0, atom.rows->size());
+		for (unsigned int level = 0; level < _invars.size(); ++level) {
+			auto column = atom.columns[level];
+			if (column < 0) {
+				continue;
+			}
+			range = Range(seek(atom, range, column, _invalues[level], false), seek(atom, range, column, _invalues[level], true));
+			if (range.first == range.second) {
+				return false;
+			}
+		}
+		_ranges[0][a] = range;
+	}
+	return true;
+}
+
+// Returns the first row in range with a value larger than (strict) or at least (not strict) value in the given column.
+// PRECONDITION: all rows in range agree on the columns before the given column
+size_t LeapfrogJoinGenerator::seek(const JoinAtom& atom, const Range& range, int column, const DomainElement* value, bool strict) const {
+	auto begin = atom.rows->cbegin() + range.first;
+	auto end = atom.rows->cbegin() + range.second;
+	vector<ElementTuple>::const_iterator result;
+	if (strict) {
+		result = upper_bound(begin, end, value, [column](const DomainElement* v, const ElementTuple& row) {return *v < *row[column];});
+	} else {
+		result = lower_bound(begin, end, value, [column](const ElementTuple& row, const DomainElement* v) {return *row[column] < *v;});
+	}
+	return result - atom.rows->cbegin();
+}
+
+bool LeapfrogJoinGenerator::seek(unsigned int level, const DomainElement* after) {
+	const auto& participants = _participants[level];
+	const auto& ranges = _ranges[level];
+	auto index = _invars.size() + level; // The index of the level among all levels
+
+	auto candidate = after;
+	bool strict = after != NULL;
+	while (true) {
+		const DomainElement* max = NULL;
+		bool agree = true;
+		for (auto a = participants.cbegin(); a < participants.cend(); ++a) {
+			const auto& atom = (*_atoms)[*a];
+			const auto& range = ranges[*a];
+			auto position = candidate == NULL ? range.first : seek(atom, range, atom.columns[index], candidate, strict);
+			if (position == range.second) {
+				return false;
+			}
+			auto value = (*atom.rows)[position][atom.columns[index]];
+			if (max == NULL) {
+				max = value;
+			} else if (value != max) {
+				agree = false;
+				if (*max < *value) {
+					max = value;
+				}
+			}
+		}
+		candidate = max;
+		if (not agree) {
+			strict = false;
+		} else if (_outsorts[level]->contains(candidate)) {
+			break;
+		} else { // Skip values outside the sort of the level
+			strict = true;
+		}
+	}
+
+	auto& childranges = _ranges[level + 1];
+	childranges = ranges;
+	for (auto a = participants.cbegin(); a < participants.cend(); ++a) {
+		const auto& atom = (*_atoms)[*a];
+		auto atomcolumn = atom.columns[index];
+		childranges[*a] = Range(seek(atom, ranges[*a], atomcolumn, candidate, false), seek(atom, ranges[*a], atomcolumn, candidate, true));
+	}
+	_outvalues[level] = candidate;
+	*(_outvars[level]) = candidate;
+	return true;
+}
+
+void LeapfrogJoinGenerator::next() {
+	int level;
+	const DomainElement* after;
+	if (_reset) {
+		_reset = false;
+		if (not bindInputs()) {
+			notifyAtEnd();
+			return;
+		}
+		if (_outvars.empty()) { // Every atom matches the input
+			return;
+		}
+		level = 0;
+		after = NULL;
+	} else {
+		if (_outvars.empty()) {
+			notifyAtEnd();
+			return;
+		}
+		level = _outvars.size() - 1;
+		after = _outvalues[level];
+	}
+
+	while (true) {
+		if (seek(level, after)) {
+			if (level + 1 == (int) _outvars.size()) {
+				return;
+			}
+			++level;
+			after = NULL;
+		} else {
+			if (level == 0) {
+				notifyAtEnd();
+				return;
+			}
+			--level;
+			after = _outvalues[level];
+		}
+	}
+}
+
+void LeapfrogJoinGenerator::internalSetVarsAgain() {
+	for (unsigned int i = 0; i < _invars.size(); ++i) {
+		*(_invars[i]) = _invalues[i];
+	}
+	for (unsigned int n = 0; n < _outvars.size(); ++n) {
+		*(_outvars[n]) = _outvalues[n];
+	}
+}
+
+void LeapfrogJoinGenerator::put(std::ostream& stream) const {
+	stream << "leapfrog join of " << _atoms->size() << " atoms over " << _outvars.size() << " output variable(s)";
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef LEAPFROGJOINGENERATOR_HPP_
+#define LEAPFROGJOINGENERATOR_HPP_
+
+#include <memory>
+#include "InstGenerator.hpp"
+#include "structure/MainStructureComponents.hpp"
+#include "structure/TableIndexes.hpp"
+
+/**
+ * One atom of a leapfrog join: the tuples of its table, with the columns permuted such that they bind the levels in increasing order.
+ */
+struct JoinAtom {
+	std::vector<int> columns; //!< For each level, the column of rows binding it, -1 if the atom does not contain the variable of that level
+	std::shared_ptr<const SortedTrie> rows; //!< Shared with the cache of the table, so it is only built once per table
+};
+
+/**
+ * Worst-case optimal (leapfrog triejoin) generator for a conjunction of enumerated atoms over shared variables.
+ * The variables are bound one level at a time: first all input variables, then the output variables in a fixed order.
+ * At each output level, the atoms containing the variable of that level repeatedly seek the largest value proposed by any of them,
+ * until they all agree on a value. Instead of enumerating pairwise joins, the work done is bounded by the size of the largest possible result,
+ * which matters for cyclic patterns like triangles, where every pairwise join can be much larger than the answer.
+ */
+class LeapfrogJoinGenerator: public InstGenerator {
+private:
+	typedef std::pair<size_t, size_t> Range; //!< The rows [first, second) of an atom
+
+	std::shared_ptr<const std::vector<JoinAtom> > _atoms;
+	std::vector<const DomElemContainer*> _invars, _outvars;
+	std::vector<SortTable*> _outsorts; //!< The values of each output level are restricted to its sort
+	std::vector<std::vector<unsigned int> > _participants; //!< For each output level, the atoms containing the variable of that level
+	std::vector<std::vector<Range> > _ranges; //!< _ranges[l][a]: the rows of atom a matching the values of all levels before output level l
+	ElementTuple _invalues, _outvalues;
+	bool _reset;
+
+	bool bindInputs();
+	size_t seek(const JoinAtom& atom, const Range& range, int column, const DomainElement* value, bool strict) const;
+	// Sets output level l to the least value larger than after (any value if after is NULL) on which all its atoms agree
+	// and that is in the sort of the level. Returns false if there is none.
+	bool seek(unsigned int level, const DomainElement* after);
+
+public:
+	LeapfrogJoinGenerator(std::shared_ptr<const std::vector<JoinAtom> > atoms, const std::vector<const DomElemContainer*>& invars,
+			const std::vector<const DomElemContainer*>& outvars, const std::vector<SortTable*>& outsorts);
+
+	/**
+	 * Builds the atoms of a join over nrlevels levels.
+	 * Atom n takes its tuples from tables[n] and binds level args[n][i] in its i'th argument.
+	 * Tuples with different values for a repeated variable are dropped.
+	 * The sorted rows are cached on the tables, and rebuilt after a table changes.
+	 * NOTE: the tables should be enumerated.
+	 */
+	static std::shared_ptr<const std::vector<JoinAtom> > createAtoms(const std::vector<const PredTable*>& tables,
+			const std::vector<std::vector<unsigned int> >& args, unsigned int nrlevels);
+
+	LeapfrogJoinGenerator* clone() const;
+	void reset();
+	void next();
+	void internalSetVarsAgain();
+	virtual void put(std::ostream& stream) const;
+};
+
+#endif /* LEAPFROGJOINGENERATOR_HPP_ */
@@ -0,0 +1,377 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "AggregateEncoder.hpp"
+#include <algorithm>
+#include <cmath>
+#include "AbstractGroundTheory.hpp"
+#include "theory/ecnf.hpp"
+#include "inferences/grounding/GroundTranslator.hpp"
+#include "utils/NumericLimits.hpp"
+
+using namespace std;
+
+namespace {
+const long long maxweight = 1LL << 40; //!< Aggregates with larger weights or bounds are left to the solver, to avoid overflows
+const long long maxunarysize = 100000; //!< Maximum sum of the weights for the encodings which repeat literals according to their weight
+const long long maxclauses = 1000000; //!< Aggregates of which the requested encoding (in auto mode: every encoding) is larger are left to the solver
+
+// The product of two non-negative numbers, or the largest long long if it would overflow
+long long saturatingProduct(long long a, long long b) {
+	if (a != 0 && b > getMaxElem<long long>() / a) {
+		return getMaxElem<long long>();
+	}
+	return a * b;
+}
+
+// The sum of non-negative numbers, or the largest long long if it would overflow
+long long saturatingSum(const vector<long long>& numbers) {
+	long long result = 0;
+	for (auto number : numbers) {
+		if (number > getMaxElem<long long>() - result) {
+			return getMaxElem<long long>();
+		}
+		result += number;
+	}
+	return result;
+}
+
+long long totalizerSize(long long size, long long k, map<long long, long long>& sizes) {
+	if (size <= 1) {
+		return 0;
+	}
+	auto it = sizes.find(size);
+	if (it != sizes.cend()) {
+		return it->second;
+	}
+	auto left = size / 2, right = size - size / 2;
+	auto result = totalizerSize(left, k, sizes) + totalizerSize(right, k, sizes) + 2 * (min(left, k) + 1) * (min(right, k) + 1);
+	sizes[size] = result;
+	return result;
+}
+}
+
+AggregateEncoder::AggregateEncoder(AbstractGroundTheory* theory)
+		: 	_theory(theory),
+			_truelit(theory->translator()->trueLit()) {
+}
+
+long long AggregateEncoder::Normalized::total() const {
+	return saturatingSum(weights);
+}
+
+bool AggregateEncoder::normalize(const AggTsBody& body, const TsSet& set, Normalized& aggregate) {
+	if (body.aggtype() != AggFunction::CARD && body.aggtype() != AggFunction::SUM) {
+		return false;
+	}
+	long long offset = 0;
+	for (size_t i = 0; i < set.size(); ++i) {
+		auto weight = body.aggtype() == AggFunction::CARD ? 1 : set.weight(i);
+		if (weight != floor(weight) || abs(weight) > maxweight) {
+			return false;
+		}
+		auto w = (long long) weight;
+		auto lit = set.literal(i);
+		if (w == 0) {
+			continue;
+		}
+		if (w < 0) { // w*l == w + (-w)*(~l)
+			offset += w;
+			w = -w;
+			lit = -lit;
+		}
+		aggregate.lits.push_back(lit);
+		aggregate.weights.push_back(w);
+	}
+	auto bound = body.bound();
+	if (not (abs(bound) <= maxweight)) { // Also fails for infinite bounds
+		return false;
+	}
+	if (body.lower()) { // bound =< sum
+		aggregate.atleast = (long long) ceil(bound) - offset;
+		aggregate.negate = false;
+	} else { // sum =< bound, so not (sum >= floor(bound)+1)
+		aggregate.atleast = (long long) floor(bound) + 1 - offset;
+		aggregate.negate = true;
+	}
+	return true;
+}
+
+long long AggregateEncoder::estimateSize(AggEncoding encoding, const vector<long long>& weights, long long atleast) {
+	auto total = saturatingSum(weights);
+	if (atleast <= 0 || atleast > total) {
+		return 0;
+	}
+	if (encoding != AggEncoding::BDD && total > maxunarysize) {
+		return getMaxElem<long long>();
+	}
+	switch (encoding) {
+	case AggEncoding::SEQUENTIAL:
+		return saturatingProduct(6 * total, atleast);
+	case AggEncoding::TOTALIZER: {
+		map<long long, long long> sizes;
+		return totalizerSize(total, atleast, sizes);
+	}
+	case AggEncoding::SORTINGNETWORK: {
+		long long padded = 1, depth = 0;
+		while (padded < total) {
+			padded *= 2;
+			++depth;
+		}
+		auto nbcomparators = padded == 1 ? 0 : ((depth * depth - depth + 4) * padded) / 4 - 1;
+		return 6 * nbcomparators;
+	}
+	case AggEncoding::BDD:
+		return saturatingProduct(6 * (long long) weights.size(), atleast);
+	default:
+		throw IdpException("Invalid code path.");
+	}
+}
+
+AggEncoding AggregateEncoder::choose(AggEncoding requested, const Normalized& aggregate) {
+	if (requested == AggEncoding::NATIVE) {
+		return requested;
+	}
+	if (requested != AggEncoding::AUTO) {
+		// Also for too many repeated literals, as the estimate of the unary encodings is then infinite
+		return estimateSize(requested, aggregate.weights, aggregate.atleast) <= maxclauses ? requested : AggEncoding::NATIVE;
+	}
+	auto best = AggEncoding::NATIVE;
+	auto bestsize = maxclauses;
+	for (auto encoding : { AggEncoding::SEQUENTIAL, AggEncoding::TOTALIZER, AggEncoding::SORTINGNETWORK, AggEncoding::BDD }) {
+		auto size = estimateSize(encoding, aggregate.weights, aggregate.atleast);
+		if (size <= bestsize) {
+			best = encoding;
+			bestsize = size;
+		}
+	}
+	return best;
+}
+
+void AggregateEncoder::addClause(const litlist& clause) {
+	litlist simplified;
+	for (auto lit : clause) {
+		if (lit == _truelit) {
+			return;
+		}
+		if (lit == -_truelit || find(simplified.cbegin(), simplified.cend(), lit) != simplified.cend()) {
+			continue;
+		}
+		if (find(simplified.cbegin(), simplified.cend(), -lit) != simplified.cend()) {
+			return;
+		}
+		simplified.push_back(lit);
+	}
+	if (simplified.empty()) {
+		simplified.push_back(-_truelit);
+	}
+	_theory->add(simplified);
+}
+
+Lit AggregateEncoder::newLit() {
+	return _theory->translator()->createNewUninterpretedNumber();
+}
+
+Lit AggregateEncoder::conjunction(Lit a, Lit b) {
+	if (a == -_truelit || b == -_truelit || a == -b) {
+		return -_truelit;
+	}
+	if (a == _truelit) {
+		return b;
+	}
+	if (b == _truelit || a == b) {
+		return a;
+	}
+	auto key = a < b ? make_pair(a, b) : make_pair(b, a);
+	auto it = _conjunctions.find(key);
+	if (it != _conjunctions.cend()) {
+		return it->second;
+	}
+	auto gate = newLit();
+	addClause( { -gate, a });
+	addClause( { -gate, b });
+	addClause( { gate, -a, -b });
+	_conjunctions[key] = gate;
+	return gate;
+}
+
+// counters[j] is true iff at least j of the inputs seen so far are true
+Lit AggregateEncoder::sequentialCounter(const litlist& inputs, size_t k) {
+	litlist counters(k + 1, -_truelit);
+	counters[0] = _truelit;
+	for (auto input : inputs) {
+		for (auto j = k; j > 0; --j) {
+			counters[j] = disjunction(counters[j], conjunction(input, counters[j - 1]));
+		}
+	}
+	return counters[k];
+}
+
+// Returns the outputs of the totalizer of inputs[begin, end), of which output i is true iff at least i+1 inputs are true, truncated at k
+litlist AggregateEncoder::totalizer(const litlist& inputs, size_t begin, size_t end, size_t k) {
+	if (end - begin == 1) {
+		return {inputs[begin]};
+	}
+	auto middle = begin + (end - begin) / 2;
+	auto left = totalizer(inputs, begin, middle, k);
+	auto right = totalizer(inputs, middle, end, k);
+	auto size = min(left.size() + right.size(), k);
+	litlist outputs;
+	for (size_t i = 0; i < size; ++i) {
+		outputs.push_back(newLit());
+	}
+	for (size_t i = 0; i <= left.size(); ++i) {
+		for (size_t j = 0; j <= right.size(); ++j) {
+			if (i + j > 0) { // At least i left and j right, so at least i+j
+				litlist clause;
+				if (i > 0) {
+					clause.push_back(-left[i - 1]);
+				}
+				if (j > 0) {
+					clause.push_back(-right[j - 1]);
+				}
+				clause.push_back(outputs[min(i + j, size) - 1]);
+				addClause(clause);
+			}
+			if (i + j < size) { // At most i left and j right, so at most i+j
+				litlist clause;
+				if (i < left.size()) {
+					clause.push_back(left[i]);
+				}
+				if (j < right.size()) {
+					clause.push_back(right[j]);
+				}
+				clause.push_back(-outputs[i + j]);
+				addClause(clause);
+			}
+		}
+	}
+	return outputs;
+}
+
+// Batcher's odd-even merge sort, sorting true before false, padded with false up to a power of two
+Lit AggregateEncoder::sortingNetwork(const litlist& inputs, size_t k) {
+	size_t size = 1;
+	while (size < inputs.size()) {
+		size *= 2;
+	}
+	litlist sorted(inputs);
+	sorted.resize(size, -_truelit);
+	for (size_t p = 1; p < size; p *= 2) {
+		for (auto step = p; step >= 1; step /= 2) {
+			for (auto j = step % p; j + step < size; j += 2 * step) {
+				for (size_t i = 0; i < step && i + j + step < size; ++i) {
+					if ((i + j) / (2 * p) == (i + j + step) / (2 * p)) {
+						auto a = sorted[i + j], b = sorted[i + j + step];
+						sorted[i + j] = disjunction(a, b);
+						sorted[i + j + step] = conjunction(a, b);
+					}
+				}
+			}
+		}
+	}
+	return sorted[k - 1];
+}
+
+// The node of literals index..n with remaining bound k, suffixsums[i] is the sum of the weights from i on
+Lit AggregateEncoder::bdd(const Normalized& aggregate, size_t index, long long k, const vector<long long>& suffixsums) {
+	if (k <= 0) {
+		return _truelit;
+	}
+	if (k > suffixsums[index]) {
+		return -_truelit;
+	}
+	auto key = make_pair(index, k);
+	auto it = _bddnodes.find(key);
+	if (it != _bddnodes.cend()) {
+		return it->second;
+	}
+	auto without = bdd(aggregate, index + 1, k, suffixsums);
+	auto with = bdd(aggregate, index + 1, k - aggregate.weights[index], suffixsums);
+	auto result = disjunction(without, conjunction(aggregate.lits[index], with));
+	_bddnodes[key] = result;
+	return result;
+}
+
+Lit AggregateEncoder::encodeAtLeast(AggEncoding encoding, const Normalized& aggregate) {
+	if (aggregate.atleast <= 0) {
+		return _truelit;
+	}
+	if (aggregate.atleast > aggregate.total()) {
+		return -_truelit;
+	}
+	if (encoding == AggEncoding::BDD) {
+		// Large weights first, such that small remaining bounds are reached early and shared
+		vector<size_t> order(aggregate.lits.size());
+		for (size_t i = 0; i < order.size(); ++i) {
+			order[i] = i;
+		}
+		stable_sort(order.begin(), order.end(), [&aggregate](size_t a, size_t b) {return aggregate.weights[a] > aggregate.weights[b];});
+		Normalized sorted;
+		for (auto i : order) {
+			sorted.lits.push_back(aggregate.lits[i]);
+			sorted.weights.push_back(aggregate.weights[i]);
+		}
+		vector<long long> suffixsums(order.size() + 1, 0);
+		for (auto i = order.size(); i > 0; --i) {
+			suffixsums[i - 1] = suffixsums[i] + sorted.weights[i - 1];
+		}
+		auto result = bdd(sorted, 0, aggregate.atleast, suffixsums);
+		_bddnodes.clear();
+		return result;
+	}
+
+	litlist inputs;
+	for (size_t i = 0; i < aggregate.lits.size(); ++i) {
+		inputs.insert(inputs.end(), aggregate.weights[i], aggregate.lits[i]);
+	}
+	auto k = (size_t) aggregate.atleast;
+	switch (encoding) {
+	case AggEncoding::SEQUENTIAL:
+		return sequentialCounter(inputs, k);
+	case AggEncoding::TOTALIZER:
+		return totalizer(inputs, 0, inputs.size(), k)[k - 1];
+	case AggEncoding::SORTINGNETWORK:
+		return sortingNetwork(inputs, k);
+	default:
+		throw IdpException("Invalid code path.");
+	}
+}
+
+bool AggregateEncoder::encode(AggEncoding requested, Lit head, const AggTsBody& body, const TsSet& set) {
+	Normalized aggregate;
+	if (not normalize(body, set, aggregate)) {
+		return false;
+	}
+	auto encoding = choose(requested, aggregate);
+	if (encoding == AggEncoding::NATIVE) {
+		return false;
+	}
+	auto condition = encodeAtLeast(encoding, aggregate);
+	if (aggregate.negate) {
+		condition = -condition;
+	}
+	switch (body.type()) {
+	case TsType::EQ:
+		addClause( { -head, condition });
+		addClause( { head, -condition });
+		break;
+	case TsType::IMPL:
+		addClause( { -head, condition });
+		break;
+	case TsType::RIMPL:
+		addClause( { head, -condition });
+		break;
+	case TsType::RULE:
+		throw IdpException("Invalid code path.");
+	}
+	return true;
+}
@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef GROUNDING_AGGREGATEENCODER_HPP_
+#define GROUNDING_AGGREGATEENCODER_HPP_
+
+#include <map>
+#include <vector>
+#include "common.hpp"
+#include "options.hpp"
+
+class AbstractGroundTheory;
+class AggTsBody;
+class TsSet;
+
+/**
+ * Translates cardinality and sum aggregates into clauses, for exporting to plain (E)CNF or when the native aggregate propagation is weak.
+ *
+ * An aggregate is first normalized to "sum of positive integer weights of true literals >= k".
+ * The literal equivalent to that condition is then built with one of the encodings
+ * 	- sequential counter: the number of true literals among the first i, up to k, O(n.k) clauses
+ * 	- totalizer: a tree of unary counters truncated at k, O(n.log(n).k) clauses
+ * 	- sorting network: Batcher's odd-even merge sort of the literals, O(n.log^2(n)) clauses
+ * 	- bdd: the decision diagram of the pseudo-boolean constraint, O(n.k) clauses, without expanding weights
+ * Weighted literals are repeated according to their weight in the first three encodings.
+ *
+ * All auxiliary atoms are defined as equivalences of the set literals, so the number of models is preserved.
+ * Gates are hashed structurally over all aggregates of the theory, so aggregates over the same set share their counters.
+ */
+class AggregateEncoder {
+private:
+	AbstractGroundTheory* _theory;
+	Lit _truelit;
+	std::map<std::pair<Lit, Lit>, Lit> _conjunctions;
+	std::map<std::pair<size_t, long long>, Lit> _bddnodes; //!< Only valid during the encoding of one aggregate
+
+	// A normalized aggregate: sum(weights[i] for lits[i] true) >= atleast, negated if negate is true
+	struct Normalized {
+		litlist lits;
+		std::vector<long long> weights;
+		long long atleast;
+		bool negate;
+		long long total() const;
+	};
+	static bool normalize(const AggTsBody& body, const TsSet& set, Normalized& aggregate);
+
+	static AggEncoding choose(AggEncoding requested, const Normalized& aggregate);
+
+	void addClause(const litlist& clause);
+	Lit newLit();
+	Lit conjunction(Lit a, Lit b);
+	Lit disjunction(Lit a, Lit b) {
+		return -conjunction(-a, -b);
+	}
+
+	Lit sequentialCounter(const litlist& inputs, size_t k);
+	litlist totalizer(const litlist& inputs, size_t begin, size_t end, size_t k);
+	Lit sortingNetwork(const litlist& inputs, size_t k);
+	Lit bdd(const Normalized& aggregate, size_t index, long long k, const std::vector<long long>& suffixsums);
+
+	//! Returns the literal that is true iff the normalized sum reaches aggregate.atleast
+	Lit encodeAtLeast(AggEncoding encoding, const Normalized& aggregate);
+
+public:
+	AggregateEncoder(AbstractGroundTheory* theory);
+
+	/**
+	 * Adds clauses expressing that head relates to the aggregate as body->type() (EQ, IMPL or RIMPL) prescribes.
+	 * Returns false, without adding anything, if the aggregate should be passed on natively:
+	 * for aggregates other than cardinality and sums of integer weights, and if the requested encoding (in auto mode: every encoding) is too large.
+	 */
+	bool encode(AggEncoding encoding, Lit head, const AggTsBody& body, const TsSet& set);
+
+	//! The estimated number of clauses of encoding the sum of the given positive weights reaching atleast, the largest long long if that overflows
+	static long long estimateSize(AggEncoding encoding, const std::vector<long long>& weights, long long atleast);
+};
+
+#endif /* GROUNDING_AGGREGATEENCODER_HPP_ */
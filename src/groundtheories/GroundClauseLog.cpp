@@ -0,0 +1,168 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum 
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "GroundClauseLog.hpp"
+#include "errorhandling/IdpException.hpp"
+
+using namespace std;
+
+namespace {
+void writeVarint(vector<unsigned char>& out, unsigned long long value) {
+	while (value >= 0x80) {
+		out.push_back((unsigned char) (value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((unsigned char) value);
+}
+
+unsigned long long readVarint(const vector<unsigned char>& in, size_t& position) {
+	unsigned long long value = 0;
+	int shift = 0;
+	while (true) {
+		Assert(position < in.size());
+		auto byte = in[position++];
+		value |= ((unsigned long long) (byte & 0x7F)) << shift;
+		if ((byte & 0x80) == 0) {
+			return value;
+		}
+		shift += 7;
+	}
+}
+
+// Maps small negative and positive differences to small unsigned numbers: 0, -1, 1, -2, 2, ...
+unsigned long long zigzag(long long value) {
+	return (((unsigned long long) value) << 1) ^ (unsigned long long) (value >> 63);
+}
+
+long long unzigzag(unsigned long long value) {
+	return (long long) (value >> 1) ^ -(long long) (value & 1);
+}
+}
+
+GroundClauseLog::GroundClauseLog()
+		: 	_window(0),
+			_nbliterals(0),
+			_file(NULL),
+			_nbspilled(0) {
+}
+
+GroundClauseLog::~GroundClauseLog() {
+	if (_file != NULL) {
+		fclose(_file);
+	}
+}
+
+void GroundClauseLog::setWindow(size_t literals) {
+	_window = literals;
+	if (_window > 0 && _nbliterals > _window) {
+		spill();
+	}
+}
+
+void GroundClauseLog::add(const GroundClause& clause) {
+	_clauses.push_back(clause);
+	_nbliterals += clause.size();
+	if (_window > 0 && _nbliterals > _window) {
+		spill();
+	}
+}
+
+void GroundClauseLog::spill() {
+	if (_clauses.empty()) {
+		return;
+	}
+	if (_file == NULL) {
+		_file = tmpfile();
+		if (_file == NULL) {
+			throw IdpException("Could not create a temporary file to store the grounding.");
+		}
+	}
+	vector<unsigned char> bytes;
+	for (auto& clause : _clauses) {
+		writeVarint(bytes, clause.size());
+		long long previous = 0;
+		for (auto lit : clause) {
+			writeVarint(bytes, zigzag((long long) lit - previous));
+			previous = lit;
+		}
+	}
+	if (fseek(_file, 0, SEEK_END) != 0) {
+		throw IdpException("Could not write the grounding to a temporary file.");
+	}
+	Segment segment { ftell(_file), bytes.size(), _clauses.size() };
+	if (fwrite(bytes.data(), 1, bytes.size(), _file) != bytes.size()) {
+		throw IdpException("Could not write the grounding to a temporary file.");
+	}
+	_segments.push_back(segment);
+	_nbspilled += _clauses.size();
+	_clauses = vector<GroundClause>(); // Also release the memory
+	_nbliterals = 0;
+}
+
+size_t GroundClauseLog::nbSpilledBytes() const {
+	size_t result = 0;
+	for (auto& segment : _segments) {
+		result += segment.bytes;
+	}
+	return result;
+}
+
+GroundClauseLog::const_iterator::const_iterator(const GroundClauseLog* log, size_t index)
+		: 	_log(log),
+			_index(index),
+			_segment(0),
+			_position(0) {
+	if (_index < _log->_nbspilled) {
+		Assert(_index == 0);
+		load();
+		decode();
+	}
+}
+
+void GroundClauseLog::const_iterator::load() {
+	auto& segment = _log->_segments[_segment];
+	_buffer.resize(segment.bytes);
+	_position = 0;
+	if (fseek(_log->_file, segment.offset, SEEK_SET) != 0 || fread(_buffer.data(), 1, segment.bytes, _log->_file) != segment.bytes) {
+		throw IdpException("Could not read the grounding from a temporary file.");
+	}
+}
+
+void GroundClauseLog::const_iterator::decode() {
+	auto size = readVarint(_buffer, _position);
+	_current.clear();
+	long long previous = 0;
+	for (unsigned long long i = 0; i < size; ++i) {
+		previous += unzigzag(readVarint(_buffer, _position));
+		_current.push_back((Lit) previous);
+	}
+}
+
+const GroundClause& GroundClauseLog::const_iterator::operator*() const {
+	Assert(_index < _log->size());
+	if (_index < _log->_nbspilled) {
+		return _current;
+	}
+	return _log->_clauses[_index - _log->_nbspilled];
+}
+
+GroundClauseLog::const_iterator& GroundClauseLog::const_iterator::operator++() {
+	++_index;
+	if (_index >= _log->_nbspilled) {
+		return *this;
+	}
+	if (_position == _buffer.size()) {
+		++_segment;
+		load();
+	}
+	decode();
+	return *this;
+}
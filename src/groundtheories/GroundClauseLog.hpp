@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum 
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdio>
+#include <vector>
+#include "common.hpp"
+
+typedef std::vector<Lit> GroundClause;
+
+/**
+ * Append-only list of ground clauses with a bounded memory footprint.
+ * The most recent clauses are kept in memory. When they contain more literals than the window allows,
+ * they are encoded as one segment of an anonymous temporary file: per clause, its size followed by the
+ * differences between consecutive literals, all as variable-length integers.
+ * Clauses can only be read back sequentially, in the order in which they were added.
+ *
+ * NOTE: with a window of 0, all clauses are kept in memory.
+ */
+class GroundClauseLog {
+private:
+	struct Segment {
+		long offset; //!< Position of the segment in the file
+		size_t bytes;
+		size_t nbclauses;
+	};
+
+	size_t _window; //!< Maximum number of literals kept in memory, 0 if unbounded
+	std::vector<GroundClause> _clauses; //!< The clauses added after the last segment
+	size_t _nbliterals; //!< The number of literals in _clauses
+	FILE* _file; //!< NULL as long as nothing was spilled
+	std::vector<Segment> _segments;
+	size_t _nbspilled; //!< The number of clauses in all segments
+
+	void spill();
+
+public:
+	GroundClauseLog();
+	~GroundClauseLog();
+	GroundClauseLog(const GroundClauseLog&) = delete;
+	GroundClauseLog& operator=(const GroundClauseLog&) = delete;
+
+	//! Sets the maximum number of literals kept in memory, 0 if unbounded
+	void setWindow(size_t literals);
+	void add(const GroundClause& clause);
+
+	size_t size() const {
+		return _nbspilled + _clauses.size();
+	}
+	bool empty() const {
+		return size() == 0;
+	}
+	//! Number of bytes of clauses written to disk
+	size_t nbSpilledBytes() const;
+
+	/**
+	 * Sequential iterator over all clauses. Reads one segment at a time.
+	 * NOTE: the reference returned by operator* is only valid until the iterator is incremented.
+	 */
+	class const_iterator {
+	private:
+		const GroundClauseLog* _log;
+		size_t _index; //!< The number of the current clause among all clauses
+		size_t _segment; //!< The segment containing the current clause, if it was spilled
+		std::vector<unsigned char> _buffer; //!< The bytes of _segment
+		size_t _position; //!< The position of the next clause in _buffer
+		GroundClause _current;
+
+		void load();
+		void decode();
+	public:
+		const_iterator(const GroundClauseLog* log, size_t index);
+		const GroundClause& operator*() const;
+		const GroundClause* operator->() const {
+			return &(**this);
+		}
+		const_iterator& operator++();
+		bool operator==(const const_iterator& other) const {
+			return _index == other._index;
+		}
+		bool operator!=(const const_iterator& other) const {
+			return _index != other._index;
+		}
+	};
+
+	const_iterator begin() const {
+		return const_iterator(this, 0);
+	}
+	const_iterator end() const {
+		return const_iterator(this, size());
+	}
+};
@@ -19,6 +19,7 @@
 
 void GroundPolicy::polStartTheory(GroundTranslator* translator) {
 	_translator = translator;
+	_clauses.setWindow((size_t) getOption(IntType::GROUNDINGWINDOW) * 1024 * 1024 / sizeof(Lit));
 }
 void GroundPolicy::polEndTheory() {
 }
@@ -42,7 +43,7 @@ void GroundPolicy::polRecursiveDelete() {
 }
 
 void GroundPolicy::polAdd(const GroundClause& cl) {
-	_clauses.push_back(cl);
+	_clauses.add(cl);
 }
 
 void GroundPolicy::polAdd(Lit tseitin, AggTsBody* body) {
@@ -14,8 +14,8 @@
 #include "common.hpp"
 #include "structure/fwstructure.hpp"
 #include <sstream>
+#include "GroundClauseLog.hpp"
 
-typedef std::vector<Lit> GroundClause;
 struct GroundEquivalence;
 
 class PFSymbol;
@@ -41,7 +41,7 @@ class DelayGrounder;
 
 class GroundPolicy {
 private:
-	std::vector<GroundClause> _clauses;
+	GroundClauseLog _clauses; //!< Can be (partially) stored on disk, see option groundingwindow
 	std::map<DefId, GroundDefinition*> _definitions;
 	std::vector<GroundFixpDef*> _fixpdefs;
 	std::vector<GroundSet*> _sets;
@@ -74,7 +74,7 @@ protected:
 	}
 
 public:
-	const std::vector<GroundClause>& getClauses() const {
+	const GroundClauseLog& getClauses() const {
 		return _clauses;
 	}
 	const std::vector<GroundSet*>& getSets() const {
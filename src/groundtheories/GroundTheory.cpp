@@ -13,6 +13,7 @@
 
 #include "IncludeComponents.hpp"
 #include "AbstractGroundTheory.hpp"
+#include "AggregateEncoder.hpp"
 #include "inferences/SolverInclude.hpp"
 #include "inferences/grounding/GroundTranslator.hpp"
 #include "visitors/TheoryVisitor.hpp"
@@ -31,6 +32,7 @@ template<class Policy>
 GroundTheory<Policy>::GroundTheory(StructureInfo info, bool nbModelsEquivalent)
 		: AbstractGroundTheory(info),
 		  _nbModelsEquivalent(nbModelsEquivalent),
+		  _aggencoder(NULL),
 		  _nbofatoms(0),
 		  addingTseitins(false) {
 	Policy::polStartTheory(translator());
@@ -40,11 +42,17 @@ template<class Policy>
 GroundTheory<Policy>::GroundTheory(Vocabulary* voc, StructureInfo info, bool nbModelsEquivalent)
 		: AbstractGroundTheory(voc, info),
 		  _nbModelsEquivalent(nbModelsEquivalent),
+		  _aggencoder(NULL),
 		  _nbofatoms(0),
 		  addingTseitins(false) {
 	Policy::polStartTheory(translator());
 }
 
+template<class Policy>
+GroundTheory<Policy>::~GroundTheory() {
+	delete (_aggencoder);
+}
+
 template<class Policy>
 void GroundTheory<Policy>::startLazyFormula(LazyInstantiation* inst, TsType type, bool conjunction){
 	Policy::polStartLazyFormula(inst, type, conjunction);
@@ -201,11 +209,26 @@ void GroundTheory<Policy>::add(SetId setnr, DefId defnr, bool weighted) {
 
 template<class Policy>
 void GroundTheory<Policy>::add(Lit head, AggTsBody* body) {
+	if (encodeAggregate(head, body)) {
+		return;
+	}
 	add(body->setnr(), getIDForUndefined(), (body->aggtype() != AggFunction::CARD));
 	notifyAtomsAdded(2);
 	Policy::polAdd(head, body);
 }
 
+template<class Policy>
+bool GroundTheory<Policy>::encodeAggregate(Lit head, AggTsBody* body) {
+	auto encoding = getGlobal()->getOptions()->aggEncoding();
+	if (encoding == AggEncoding::NATIVE || body->type() == TsType::RULE) {
+		return false;
+	}
+	if (_aggencoder == NULL) {
+		_aggencoder = new AggregateEncoder(this);
+	}
+	return _aggencoder->encode(encoding, head, *body, translator()->groundset(body->setnr()));
+}
+
 template<class Policy>
 void GroundTheory<Policy>::add(const Lit& head, TsType type, const litlist& body, bool conj, DefId defnr) {
 	if (type == TsType::IMPL) {
@@ -17,6 +17,7 @@
 
 struct LazyInstantiation;
 struct GroundTerm;
+class AggregateEncoder;
 
 template<class Policy>
 class GroundTheory: public AbstractGroundTheory, public Policy {
@@ -26,6 +27,7 @@ class GroundTheory: public AbstractGroundTheory, public Policy {
 	std::set<CPTerm*> _foldedterms;
 	std::set<VarId> _printedvarids, _addedvarinterpretation;
 	bool _nbModelsEquivalent;
+	AggregateEncoder* _aggencoder; //!< Only created when aggregates are encoded as clauses, see option aggencoding
 
 	long _nbofatoms;
 	void notifyAtomsAdded(long number){
@@ -36,8 +38,7 @@ public:
 	GroundTheory(StructureInfo structure, bool nbModelsEquivalent);
 	GroundTheory(Vocabulary* voc, StructureInfo structure, bool nbModelsEquivalent);
 
-	virtual ~GroundTheory() {
-	}
+	virtual ~GroundTheory();
 
 	virtual long getSize(){
 		return _nbofatoms;
@@ -108,6 +109,8 @@ protected:
 
 private:
 	void addRangeConstraint(Function* f, const litlist& set, SortTable* outSortTable);
+	//! Returns true if the aggregate was added as clauses instead of being passed on natively
+	bool encodeAggregate(Lit head, AggTsBody* body);
 };
 
 #endif /* GROUNDING_GROUNDTHEORY_HPP_ */
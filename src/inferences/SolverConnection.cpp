@@ -180,18 +180,20 @@ MinisatID::ModelIterationTask* createIteratorSolution(PCSolver* solver, int nbmo
 }
 
 void addLiterals(const MinisatID::Model& model, GroundTranslator* translator, Structure* init) {
+	ElementTuple args;
 	for (auto literal : model.literalinterpretations) {
 		CHECKTERMINATION;
 		int atomnr = var(literal);
 
 		if (translator->isInputAtom(atomnr)) {
 			auto symbol = translator->getSymbol(atomnr);
-			const auto& args = translator->getArgs(atomnr);
+			translator->getArgs(atomnr, args);
 			if (literal.hasSign()) {
 				init->inter(symbol)->makeFalseAtLeast(args);
 			} else {
 				init->inter(symbol)->makeTrueAtLeast(args);
 			}
+			init->notifyChanged(symbol);
 #ifndef NDEBUG
 			if (not init->isConsistent()) {
 				std::cerr << "mx made " << print(symbol) << " inconsistent when adding the element " << print(args) << endl;
@@ -242,6 +244,7 @@ void addTerms(const MinisatID::Model& model, GroundTranslator* translator, Struc
 				tuple.push_back(elem._domelement);
 			}
 		}
+		init->notifyChanged(function);
 		if(cpvar.hasValue()){
 			tuple.push_back(createDomElem(cpvar.getValue()));
 			init->inter(function)->graphInter()->makeTrueAtLeast(tuple);
@@ -104,81 +104,97 @@ DefinitionCalculationResult CalculateDefinitions::doCalculateDefinition(
 }
 
 
-DefinitionCalculationResult CalculateDefinitions::calculateDefinition(const Definition* definition) {
-	if (getOption(IntType::VERBOSE_DEFINITIONS) >= 2) {
-		clog << "Calculating definition: " << toString(definition) << "\n";
-		if (getOption(IntType::VERBOSE_DEFINITIONS) >= 4) {
-			clog << "Using structure " << toString(_structure) << "\n";
-		}
-	}
+#ifdef WITHXSB
+DefinitionCalculationResult CalculateDefinitions::calculateDefinitionWithXSB(const Definition* definition) {
 	DefinitionCalculationResult result(_structure);
 	result._hasModel = true;
-#ifdef WITHXSB
-	auto withxsb = CalculateDefinitions::determineXSBUsage(definition);
-	if (withxsb) {
-		if(_satdelay or getOption(SATISFIABILITYDELAY)) { // TODO implement checking threshold by size estimation (see issue #850)
-			Warning::warning("Lazy threshold is not checked for definitions evaluated with XSB");
-		}
-		if (getOption(IntType::VERBOSE_DEFINITIONS) >= 2) {
-			clog << "Calculating the above definition using XSB\n";
-		}
-		auto xsb_interface = XSBInterface::instance();
-		xsb_interface->load(definition,_structure);
-		auto symbols = definition->defsymbols();
-		if(not _symbolsToQuery.empty()) {
-			for(auto it = symbols.begin(); it != symbols.end();) {
-				auto symbol = *(it++);
-				if(_symbolsToQuery.find(symbol) == _symbolsToQuery.end()) {
-					symbols.erase(symbol);
-				}
+	if(_satdelay or getOption(SATISFIABILITYDELAY)) { // TODO implement checking threshold by size estimation (see issue #850)
+		Warning::warning("Lazy threshold is not checked for definitions evaluated with XSB");
+	}
+	if (getOption(IntType::VERBOSE_DEFINITIONS) >= 2) {
+		clog << "Calculating the above definition using XSB\n";
+	}
+	auto xsb_interface = XSBInterface::instance();
+	xsb_interface->load(definition,_structure);
+	auto symbols = definition->defsymbols();
+	if(not _symbolsToQuery.empty()) {
+		for(auto it = symbols.begin(); it != symbols.end();) {
+			auto symbol = *(it++);
+			if(_symbolsToQuery.find(symbol) == _symbolsToQuery.end()) {
+				symbols.erase(symbol);
 			}
 		}
-		if (definitionDoesNotResultInTwovaluedModel(definition)) {
+	}
+	if (definitionDoesNotResultInTwovaluedModel(definition)) {
+		result._hasModel=false;
+		return result;
+	}
+	for (auto symbol : symbols) {
+		auto sorted = xsb_interface->queryDefinition(symbol);
+		auto internpredtable1 = new EnumeratedInternalPredTable(sorted);
+		auto predtable1 = new PredTable(internpredtable1, _structure->universe(symbol));
+		if(not isConsistentWith(predtable1, _structure->inter(symbol))){
+			delete(predtable1);
+			xsb_interface->reset();
 			result._hasModel=false;
 			return result;
 		}
-		for (auto symbol : symbols) {
-			auto sorted = xsb_interface->queryDefinition(symbol);
-			auto internpredtable1 = new EnumeratedInternalPredTable(sorted);
-			auto predtable1 = new PredTable(internpredtable1, _structure->universe(symbol));
-			if(not isConsistentWith(predtable1, _structure->inter(symbol))){
-				delete(predtable1);
-				xsb_interface->reset();
-				result._hasModel=false;
-				return result;
-			}
-			_structure->inter(symbol)->ctpt(predtable1);
-			delete(predtable1);
-			_structure->clean();
-			if(isa<Function>(*symbol)) {
-				auto fun = dynamic_cast<Function*>(symbol);
-				if(not _structure->inter(fun)->approxTwoValued()){ // E.g. for functions
-					xsb_interface->reset();
-					result._hasModel=false;
-					return result;
-				}
-			}
-			if(not _structure->inter(symbol)->isConsistent()){
+		_structure->inter(symbol)->ctpt(predtable1);
+		_structure->notifyChanged(symbol);
+		delete(predtable1);
+		_structure->clean();
+		if(isa<Function>(*symbol)) {
+			auto fun = dynamic_cast<Function*>(symbol);
+			if(not _structure->inter(fun)->approxTwoValued()){ // E.g. for functions
 				xsb_interface->reset();
 				result._hasModel=false;
 				return result;
 			}
 		}
-
-		xsb_interface->reset();
-		if (not _structure->isConsistent()) {
+		if(not _structure->inter(symbol)->isConsistent()){
+			xsb_interface->reset();
 			result._hasModel=false;
 			return result;
-		} else {
-			result._hasModel=true;
 		}
+	}
+
+	xsb_interface->reset();
+	if (not _structure->isConsistent()) {
+		result._hasModel=false;
+		return result;
+	} else {
+		result._hasModel=true;
+	}
+	return result;
+}
+#endif
+
+/**
+ * Takes ownership of the definition: the ground-and-solve path adds it to the theory it grounds instead of cloning it,
+ * as grounding transforms the theory in place.
+ */
+DefinitionCalculationResult CalculateDefinitions::calculateDefinition(Definition* definition) {
+	if (getOption(IntType::VERBOSE_DEFINITIONS) >= 2) {
+		clog << "Calculating definition: " << toString(definition) << "\n";
+		if (getOption(IntType::VERBOSE_DEFINITIONS) >= 4) {
+			clog << "Using structure " << toString(_structure) << "\n";
+		}
+	}
+#ifdef WITHXSB
+	auto withxsb = CalculateDefinitions::determineXSBUsage(definition);
+	if (withxsb) {
+		auto result = calculateDefinitionWithXSB(definition);
+		definition->recursiveDelete();
 		return result;
 	}
 #endif
 	// Default: Evaluation using ground-and-solve
+	DefinitionCalculationResult result(_structure);
+	result._hasModel = true;
+	auto defsymbols = definition->defsymbols(); // NOTE: the definition might be deleted by transformations during grounding
 	auto data = SolverConnection::createsolver(1);
 	auto theory = new Theory("", _structure->vocabulary(), ParseInfo());
-	theory->add(definition->clone());
+	theory->add(definition);
 	bool LUP = getOption(BoolType::LIFTEDUNITPROPAGATION);
 	bool propagate = LUP || getOption(BoolType::GROUNDWITHBOUNDS);
 	auto symstructure = generateBounds(theory, _structure, propagate, LUP);
@@ -227,7 +243,7 @@ DefinitionCalculationResult CalculateDefinitions::calculateDefinition(const Defi
 		SolverConnection::addTerms(*model, grounding->translator(), _structure);
 		      _structure->clean();
 	}
-	for (auto symbol : definition->defsymbols()) {
+	for (auto symbol : defsymbols) {
 		if (isa<Function>(*symbol)) {
 			auto fun = dynamic_cast<Function*>(symbol);
 			if (not _structure->inter(fun)->approxTwoValued()) { // Check for functions that are defined badly
@@ -296,6 +312,14 @@ DefinitionCalculationResult CalculateDefinitions::calculateKnownDefinitions() {
 			if (currentdefinition->second.empty()) {
 				auto definition = currentdefinition->first;
 				bool tooexpensive = false;
+				std::string printeddefinition;
+				if (getOption(IntType::VERBOSE_DEFINITIONS) >= 1) {
+					printeddefinition = toString(definition);
+				}
+				// The definition is no longer needed when it is calculated, so it is handed over instead of cloned.
+				// If it has no model, the calculation stops anyway.
+				opens.erase(currentdefinition);
+				_theory->remove(definition);
 				auto defCalcResult = calculateDefinition(definition);
 				if (tooexpensive) {
 					continue;
@@ -304,14 +328,11 @@ DefinitionCalculationResult CalculateDefinitions::calculateKnownDefinitions() {
 
 				if (not defCalcResult._hasModel) { // If the definition did not have a model, quit execution (don't set fixpoint to false)
 					if (getOption(IntType::VERBOSE_DEFINITIONS) >= 1) {
-						clog << "The given structure cannot be extended to a model of the definition\n" << toString(definition) << "\n";
+						clog << "The given structure cannot be extended to a model of the definition\n" << printeddefinition << "\n";
 					}
 					result._hasModel = false;
 				} else { // If it did have a model, update result and continue
 					fixpoint = false;
-					opens.erase(currentdefinition);
-					               _theory->remove(definition);
-					definition->recursiveDelete();
 				}
 			}
 		}
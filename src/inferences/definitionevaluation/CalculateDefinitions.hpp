@@ -48,7 +48,7 @@ struct DefinitionCalculationResult {
 class CalculateDefinitions {
 public:
 	/*
-	 * !Removes calculated definitions from the theory.
+	 * !Removes calculated definitions (and the definition without a model, if any) from the theory.
 	 * Also modifies the structure. Clone your theory and structure before doing this!
 	 *
 	 * parameter satdelay:
@@ -85,7 +85,10 @@ private:
 	CalculateDefinitions(Theory*, Structure*, Vocabulary*, bool);
 	
 	DefinitionCalculationResult calculateKnownDefinitions();
-	DefinitionCalculationResult calculateDefinition(const Definition* definition);
+	DefinitionCalculationResult calculateDefinition(Definition* definition);
+#ifdef WITHXSB
+	DefinitionCalculationResult calculateDefinitionWithXSB(const Definition* definition);
+#endif
 
 
 	/** Splitting of definition may have caused the given set of symbolsToQuery to not be enough:
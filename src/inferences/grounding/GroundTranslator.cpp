@@ -51,15 +51,74 @@ CheckerInfo::~CheckerInfo() {
 	delete (ctchecker);
 }
 
-SymbolInfo::SymbolInfo(PFSymbol* symbol, StructureInfo structure)
+SymbolInfo::SymbolInfo(PFSymbol* symbol, StructureInfo structure, bool compact)
 		: 	symbol(symbol),
-			checkers(new CheckerInfo(symbol, structure)) {
+			checkers(new CheckerInfo(symbol, structure)),
+			dense(compact) {
+	if (not dense) {
+		return;
+	}
+	long long nbtuples = 1;
+	for (auto sort : symbol->sorts()) {
+		auto table = structure.concrstructure->inter(sort);
+		if (not table->isIntRange()) {
+			dense = false;
+			break;
+		}
+		auto size = (long long) table->last()->value()._int - table->first()->value()._int + 1;
+		if (nbtuples > getMaxElem<long long>() / size) { // Ranks would overflow
+			dense = false;
+			break;
+		}
+		densefirst.push_back(table->first()->value()._int);
+		densesize.push_back(size);
+		nbtuples *= size;
+	}
+	if (not dense) {
+		densefirst.clear();
+		densesize.clear();
+		return;
+	}
+	densestride.resize(densesize.size());
+	long long stride = 1;
+	for (int i = densesize.size() - 1; i >= 0; --i) { // The last argument varies fastest
+		densestride[i] = stride;
+		stride *= densesize[i];
+	}
 }
 
 SymbolInfo::~SymbolInfo(){
 	delete(checkers);
 }
 
+long long SymbolInfo::rank(const ElementTuple& tuple) const {
+	if (not dense) {
+		return -1;
+	}
+	Assert(tuple.size() == densefirst.size());
+	long long result = 0;
+	for (size_t i = 0; i < tuple.size(); ++i) {
+		if (tuple[i]->type() != DET_INT) {
+			return -1;
+		}
+		auto offset = (long long) tuple[i]->value()._int - densefirst[i];
+		if (offset < 0 || offset >= densesize[i]) {
+			return -1;
+		}
+		result += offset * densestride[i];
+	}
+	return result;
+}
+
+void SymbolInfo::tuple(long long rank, ElementTuple& result) const {
+	Assert(dense && rank >= 0);
+	result.clear();
+	for (size_t i = 0; i < densestride.size(); ++i) {
+		result.push_back(createDomElem((int) (densefirst[i] + rank / densestride[i])));
+		rank %= densestride[i];
+	}
+}
+
 FunctionInfo::FunctionInfo(Function* symbol, StructureInfo structure)
 		: 	symbol(symbol),
 			checkers(new CheckerInfo(symbol, structure)) {
@@ -101,12 +160,16 @@ GroundTranslator::GroundTranslator(StructureInfo structure, AbstractGroundTheory
 		: 	_structure(structure),
 			_grounding(grounding),
 			_groundingmanager(NULL),
+			_compact(getOption(BoolType::COMPACTTRANSLATOR)),
 			_trueLit(0), // IMPORTANT: _trueLit set on initialize!
 			maxquantsetid(1) {
 
 	// Literal 0 is not allowed!
 	atomtype.push_back(AtomType::LONETSEITIN);
 	atom2Tuple.push_back(NULL);
+	if (_compact) {
+		atom2Rank.push_back( { -1, -1 });
+	}
 	atom2TsBody.push_back((TsBody*) NULL);
 }
 
@@ -225,10 +288,22 @@ TruthValue GroundTranslator::checkApplication(const DomainElement* domelem, Sort
  * 			or first search for the literal, and run the checkers if it was not yet grounded.
  */
 Lit GroundTranslator::translate(const SymbolOffset& offset, const ElementTuple& args, bool reduced) { // reduction should not be allowed in recursive context or when reducedgrounding is off
-	auto& known = knownlits[reduced][offset.functionlist][offset.offset];
-	auto findknown = known.find(args);
-	if(findknown!=known.cend()){
-		return findknown->second;
+	long long rank = -1;
+	if (_compact && not offset.functionlist) {
+		rank = symbols[offset.offset]->rank(args);
+	}
+	if (rank != -1) { // Known literals of dense symbols are stored by rank, to avoid storing the tuple
+		auto& knownranks = symbols[offset.offset]->knownranks[reduced];
+		auto findknown = knownranks.find(rank);
+		if (findknown != knownranks.cend()) {
+			return findknown->second;
+		}
+	} else {
+		auto& known = knownlits[reduced][offset.functionlist][offset.offset];
+		auto findknown = known.find(SmallElementTuple::view(args));
+		if (findknown != known.cend()) {
+			return findknown->second;
+		}
 	}
 	CheckerInfo* checkers = NULL;
 	if (offset.functionlist) {
@@ -265,24 +340,23 @@ Lit GroundTranslator::translate(const SymbolOffset& offset, const ElementTuple&
 		throw UnsatException();
 	}
 
-	if (reduced) {
+	Lit lit;
+	if (reduced && (littrue || litfalse)) {
+		lit = littrue ? trueLit() : falseLit();
+	} else {
+		lit = getLiteral(offset, args, rank);
+		Assert(lit!=trueLit() && lit!=falseLit());
 		if (littrue) {
-			known[args] = trueLit();
-			return trueLit();
+			_grounding->addUnitClause(lit);
 		} else if (litfalse) {
-			known[args] = falseLit();
-			return falseLit();
+			_grounding->addUnitClause(-lit);
 		}
 	}
-
-	auto lit = getLiteral(offset, args);
-	Assert(lit!=trueLit() && lit!=falseLit());
-	if (littrue) {
-		_grounding->addUnitClause(lit);
-	} else if (litfalse) {
-		_grounding->addUnitClause(-lit);
+	if (rank != -1) {
+		symbols[offset.offset]->knownranks[reduced][rank] = lit;
+	} else {
+		knownlits[reduced][offset.functionlist][offset.offset][args] = lit;
 	}
-	known[args] = lit;
 	return lit;
 }
 
@@ -356,7 +430,7 @@ Lit GroundTranslator::addLazyElement(PFSymbol* symbol, const std::vector<GroundT
 }
 
 // TODO this can probably be optimized by storing trueLit()/falseLit() wherever applicable instead of lit
-Lit GroundTranslator::getLiteral(SymbolOffset symboloffset, const ElementTuple& args) {
+Lit GroundTranslator::getLiteral(SymbolOffset symboloffset, const ElementTuple& args, long long rank) {
 	if (symboloffset.functionlist) {
 		std::vector<GroundTerm> terms;
 		for (auto i = args.cbegin(); i < args.cend(); ++i) {
@@ -369,6 +443,9 @@ Lit GroundTranslator::getLiteral(SymbolOffset symboloffset, const ElementTuple&
 		terms.pop_back();
 		auto lit = reify(new CPVarTerm(translateTerm(symboloffset, terms)), CompType::EQ, CPBound(bound), TsType::EQ); // TODO TSType?
 		Assert(lit>=0);
+		if (atom2Tuple[lit] == NULL) {
+			atom2Tuple[lit] = new stpair();
+		}
 		atom2Tuple[lit]->first = functions[symboloffset.offset]->symbol;
 		atom2Tuple[lit]->second = args;
 		atomtype[lit] = AtomType::CPGRAPHEQ;
@@ -379,16 +456,26 @@ Lit GroundTranslator::getLiteral(SymbolOffset symboloffset, const ElementTuple&
 	} else { // Atom had not been introduced yet, so do this here
 		Lit lit = 0;
 		auto& symbolinfo = *symbols[symboloffset.offset];
-		auto jt = symbolinfo.tuple2atom.find(args);
-		if (jt != symbolinfo.tuple2atom.end()) {
-			lit = jt->second;
-			jt->second = lit;
+		if (rank != -1) { // Compact mode: only remember the rank
+			auto jt = symbolinfo.rank2atom.find(rank);
+			if (jt != symbolinfo.rank2atom.end()) {
+				lit = jt->second;
+			} else {
+				lit = nextNumber(AtomType::INPUT);
+				Assert(lit>=0);
+				atom2Rank[lit] = {symboloffset.offset, rank};
+				symbolinfo.rank2atom.insert(jt, {rank, lit});
+			}
 		} else {
-			lit = nextNumber(AtomType::INPUT);
-			Assert(lit>=0);
-			atom2Tuple[lit]->first = symbolinfo.symbol;
-			atom2Tuple[lit]->second = args;
-			symbolinfo.tuple2atom.insert(jt, Tuple2Atom { args, lit });
+			auto jt = symbolinfo.tuple2atom.find(SmallElementTuple::view(args));
+			if (jt != symbolinfo.tuple2atom.end()) {
+				lit = jt->second;
+			} else {
+				lit = nextNumber(AtomType::INPUT);
+				Assert(lit>=0);
+				atom2Tuple[lit] = new stpair(symbolinfo.symbol, args);
+				symbolinfo.tuple2atom.insert(jt, Tuple2AtomMap::value_type { args, lit });
+			}
 		}
 
 		if(_groundingmanager!=NULL){
@@ -399,6 +486,26 @@ Lit GroundTranslator::getLiteral(SymbolOffset symboloffset, const ElementTuple&
 	}
 }
 
+litlist GroundTranslator::getIntroducedLiteralsFor(PFSymbol* symbol) const {
+	litlist result;
+	if (not hasSymbol(symbol)) {
+		return result;
+	}
+	auto offset = getSymbol(symbol);
+	Assert(offset.offset!=-1);
+	if (offset.functionlist) {
+		throw notyetimplemented("Lazy grounding with support for function symbols in the grounding");
+	}
+	const auto& symbolinfo = *symbols[offset.offset];
+	for (auto& tuple2atom : symbolinfo.tuple2atom) {
+		result.push_back(tuple2atom.second);
+	}
+	for (auto& rank2atom : symbolinfo.rank2atom) {
+		result.push_back(rank2atom.second);
+	}
+	return result;
+}
+
 Vocabulary* GroundTranslator::vocabulary() const {
 	return _structure.concrstructure == NULL ? NULL : _structure.concrstructure->vocabulary();
 }
@@ -433,7 +540,7 @@ SymbolOffset GroundTranslator::addSymbol(PFSymbol* pfs) {
 				return SymbolOffset(functions.size() - 1, true);
 			}
 		}
-		symbols.push_back(new SymbolInfo(pfs, _structure));
+		symbols.push_back(new SymbolInfo(pfs, _structure, _compact));
 		return SymbolOffset(symbols.size() - 1, false);
 	} else {
 		return n;
@@ -566,7 +673,10 @@ SetId GroundTranslator::getPossibleSet(int id, const ElementTuple& freevar_inst)
 Lit GroundTranslator::nextNumber(AtomType type) {
 	Lit nr = atomtype.size();
 	atom2TsBody.push_back(NULL);
-	atom2Tuple.push_back(new stpair());
+	atom2Tuple.push_back(NULL); // Only allocated for input atoms stored by tuple
+	if (_compact) {
+		atom2Rank.push_back( { -1, -1 });
+	}
 	atomtype.push_back(type);
 	return nr;
 }
@@ -41,7 +41,7 @@ struct SymbolOffset {
 
 };
 
-typedef std::unordered_map<ElementTuple, Lit, HashTuple> Tuple2AtomMap;
+typedef std::unordered_map<SmallElementTuple, Lit, HashTuple> Tuple2AtomMap;
 typedef std::map<TsBody*, Lit, Compare<TsBody> > Ts2Atom;
 
 #include "generators/InstGenerator.hpp" // TODO temporary (for PATTERN usage)
@@ -63,8 +63,23 @@ struct SymbolInfo {
 
 	std::map<std::vector<GroundTerm>, Lit > lazyatoms2lit;
 
-	SymbolInfo(PFSymbol* symbol, StructureInfo structure);
+	// Dense symbols (all sorts are finite integer ranges) identify a tuple by its rank among all tuples of the sorts,
+	// so in compact mode, their atoms are stored without storing any tuple.
+	bool dense;
+	std::vector<int> densefirst; //!< For each argument, the smallest value of its sort
+	std::vector<long long> densesize; //!< For each argument, the number of values of its sort
+	std::vector<long long> densestride; //!< For each argument, the number of tuples between consecutive values of that argument
+	std::unordered_map<long long, Lit> rank2atom;
+	std::map<bool, std::unordered_map<long long, Lit> > knownranks; //!< For reduced and non-reduced translation, the known literal of a rank
+
+	//! Only detects dense symbols in compact mode, as their ranks are not used otherwise
+	SymbolInfo(PFSymbol* symbol, StructureInfo structure, bool compact);
 	~SymbolInfo();
+
+	//! Returns the rank of the given tuple, -1 if the symbol is not dense or the tuple is not part of its sorts
+	long long rank(const ElementTuple& tuple) const;
+	//! Stores the tuple with the given rank in result
+	void tuple(long long rank, ElementTuple& result) const;
 };
 
 struct FunctionInfo {
@@ -86,7 +101,7 @@ enum class AtomType {
 	CPGRAPHEQ
 };
 
-typedef std::pair<PFSymbol*, ElementTuple> stpair;
+typedef std::pair<PFSymbol*, SmallElementTuple> stpair;
 typedef std::pair<Function*, std::vector<GroundTerm> > ftpair;
 
 template<class T>
@@ -109,6 +124,7 @@ struct CPCompare {
  * 		for a tseitin atom, what its interpretation is
  * 		for an input atom, what symbol it refers to and what elementtuple
  * 		for an atom which is neither, should not store anything, except that it is not stored.
+ * In compact mode, the input atoms of dense symbols store their rank instead of their tuple.
  */
 class LazyGroundingManager;
 
@@ -126,7 +142,9 @@ private:
 	// Tseitin 2 tuple
 	// Tseitin 2 meaning (if applicable according to type)
 	std::vector<AtomType> atomtype;
-	std::vector<stpair*> atom2Tuple; // Owns pointers!
+	std::vector<stpair*> atom2Tuple; // Owns pointers! NULL for atoms which are not input atoms or which are stored in atom2Rank
+	std::vector<std::pair<int, long long> > atom2Rank; // In compact mode, the symbol offset and rank of input atoms of dense symbols, (-1,-1) for other atoms
+	bool _compact; //!< Whether the atoms of dense symbols are stored by rank instead of by tuple
 	std::vector<TsBody*> atom2TsBody; // Owns pointers! // Important: gets deleted the moment it is added to the ground theory!!! (except for cp, where it is needed later for sharing detection)
 
 	Lit _trueLit;
@@ -182,7 +200,7 @@ public:
 
 	// Translate into propositional variables
 private:
-	Lit getLiteral(SymbolOffset offset, const ElementTuple&);
+	Lit getLiteral(SymbolOffset offset, const ElementTuple&, long long rank);
 public:
 	Lit conjunction (const Lit l, const Lit r, TsType tstype); //Returns the conjunction of l and r
 	Lit reify(const litlist& cl, bool conj, TsType tp);
@@ -201,7 +219,7 @@ public:
 	Lit translateReduced(PFSymbol* symbol, const ElementTuple& args, bool recursive);
 	Lit translateReduced(const SymbolOffset& offset, const ElementTuple& args, bool recursivecontext);
 private:
-	std::map<bool, std::map<bool, std::map<int, std::map<ElementTuple, Lit> > > > knownlits;
+	std::map<bool, std::map<bool, std::map<int, std::map<SmallElementTuple, Lit> > > > knownlits;
 	Lit translate(const SymbolOffset& offset, const ElementTuple&, bool reduced);
 public:
 
@@ -211,19 +229,7 @@ public:
 		return getSymbol(symbol).offset!=-1;
 	}
 
-	Tuple2AtomMap emptymap;
-	const Tuple2AtomMap& getIntroducedLiteralsFor(PFSymbol* symbol) const{
-		if(not hasSymbol(symbol)){
-			return emptymap;
-		}
-		auto offset = getSymbol(symbol);
-		Assert(offset.offset!=-1);
-		if(offset.functionlist){
-			throw notyetimplemented("Lazy grounding with support for function symbols in the grounding");
-		}else{
-			return symbols[offset.offset]->tuple2atom;
-		}
-	}
+	litlist getIntroducedLiteralsFor(PFSymbol* symbol) const;
 
 	Lit trueLit() const{
 		return _trueLit;
@@ -247,13 +253,33 @@ public:
 	bool isTseitinWithSubformula(int atom) const {
 		return isStored(atom) && (getType(atom) == AtomType::TSEITINWITHSUBFORMULA || getType(atom) == AtomType::CPGRAPHEQ);
 	}
+	bool isStoredByRank(int atom) const {
+		return (unsigned int) atom < atom2Rank.size() && atom2Rank[atom].first != -1;
+	}
 	PFSymbol* getSymbol(int atom) const {
-		Assert(isInputAtom(atom) && atom2Tuple[atom]->first!=NULL);
+		Assert(isInputAtom(atom));
+		if (isStoredByRank(atom)) {
+			return symbols[atom2Rank[atom].first]->symbol;
+		}
+		Assert(atom2Tuple[atom]!=NULL && atom2Tuple[atom]->first!=NULL);
 		return atom2Tuple[atom]->first;
 	}
-	const ElementTuple& getArgs(int atom) const {
-		Assert(isInputAtom(atom) && atom2Tuple[atom]->first!=NULL);
-		return atom2Tuple[atom]->second;
+	//! NOTE: returns a copy, as the arguments are stored as a small tuple or, in compact mode, reconstructed from the rank of the atom
+	ElementTuple getArgs(int atom) const {
+		ElementTuple args;
+		getArgs(atom, args);
+		return args;
+	}
+	//! Stores the arguments of the given atom in args, reusing its storage, so loops over many atoms need not allocate per atom
+	void getArgs(int atom, ElementTuple& args) const {
+		Assert(isInputAtom(atom));
+		if (isStoredByRank(atom)) {
+			symbols[atom2Rank[atom].first]->tuple(atom2Rank[atom].second, args);
+			return;
+		}
+		Assert(atom2Tuple[atom]!=NULL && atom2Tuple[atom]->first!=NULL);
+		const auto& stored = atom2Tuple[atom]->second;
+		args.assign(stored.cbegin(), stored.cend());
 	}
 
 	TsBody* getTsBody(Lit atom) const {
@@ -24,6 +24,7 @@
 #include "grounders/TermGrounders.hpp"
 #include "grounders/SetGrounders.hpp"
 #include "grounders/DefinitionGrounders.hpp"
+#include "grounders/FunctionConstraintGrounder.hpp"
 #include "lazygrounders/LazyDisjunctiveGrounders.hpp"
 #include "LazyGroundingManager.hpp"
 //#include "grounders/LazyFormulaGrounders.hpp"
@@ -318,11 +319,18 @@ LazyGroundingManager* GrounderFactory::ground(AbstractTheory* theory, Term* mini
 		FormulaUtils::addFuncConstraints(minimizeterm, _vocabulary, funcconstraints, not getOption(BoolType::CPSUPPORT));
 	}
 
+	// NOTE: lazy grounding needs the formula to delay on
+	auto nativeFuncConstraints = getOption(BoolType::NATIVEFUNCCONSTRAINTS) && not getOption(TSEITINDELAY) && not getOption(SATISFIABILITYDELAY);
 	for (auto func2constr : funcconstraints) {
 		if(getConcreteStructure()->inter(func2constr.first)->approxTwoValued()){
 			continue; // Do not add function constraints for two-valued functions
 		}
 		InitContext();
+		if (nativeFuncConstraints && FunctionConstraintGrounder::canGround(func2constr.first, getConcreteStructure())) {
+			// Directly add clauses and cardinality constraints instead of grounding the formula
+			grounders.push_back(new FunctionConstraintGrounder(getGrounding(), getContext(), func2constr.first, getConcreteStructure()));
+			continue;
+		}
 		descend(func2constr.second);
 		grounders.push_back(getTopGrounder());
 	}
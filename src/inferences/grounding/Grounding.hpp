@@ -32,6 +32,7 @@
 #include "errorhandling/UnsatException.hpp"
 #include "LazyGroundingManager.hpp"
 #include "utils/LogAction.hpp"
+#include "utils/Profiler.hpp"
 
 class Theory;
 class AbstractTheory;
@@ -149,7 +150,11 @@ private:
 		if (getOption(IntType::VERBOSE_GROUNDING) >= 1) {
 			logActionAndTime("Starting definition evaluation at ");
 		}
-		auto defCalculatedResult = CalculateDefinitions::doCalculateDefinitions(dynamic_cast<Theory*>(_theory), _structure, satdelay);
+		DefinitionCalculationResult defCalculatedResult(_structure);
+		{
+			ProfilePhase phase("definitionevaluation");
+			defCalculatedResult = CalculateDefinitions::doCalculateDefinitions(dynamic_cast<Theory*>(_theory), _structure, satdelay);
+		}
 		if(getOption(VERBOSE_GROUNDING_STATISTICS) > 1){
 			cout <<"\ndefs&&max:" <<toDouble(Grounder::getFullGroundingSize()) <<"&&grounded:" <<Grounder::groundedAtoms() <<"\n";
 		}
@@ -180,7 +185,11 @@ private:
 
 		if (getGlobal()->getOptions()->approxDef() != ApproxDef::NONE) {
 			PropagationUsingApproxDef* propagator = new PropagationUsingApproxDef();
-			auto propagated_structures = propagator->propagate(_theory, _structure);
+			std::vector<Structure*> propagated_structures;
+			{
+				ProfilePhase phase("approximation");
+				propagated_structures = propagator->propagate(_theory, _structure);
+			}
 			if (propagated_structures.size() == 0 || not propagated_structures[0]->isConsistent()) {
 				bool LUP = getOption(BoolType::LIFTEDUNITPROPAGATION);
 				bool propagate = LUP || getOption(BoolType::GROUNDWITHBOUNDS);
@@ -222,7 +231,11 @@ private:
 		if (getOption(VERBOSE_GROUNDING_STATISTICS) >= 1) {
 			logActionAndTime("grounding-start");
 		}
-		bool unsat = _grounder->toplevelRun();
+		bool unsat;
+		{
+			ProfilePhase phase("grounding");
+			unsat = _grounder->toplevelRun();
+		}
 		if(unsat){
 			if(getOption(VERBOSE_GROUNDING_STATISTICS) > 0){
 				std::clog <<"groundsize&&" <<_grounder->getGrounding()->getSize() <<"\n";
@@ -8,6 +8,7 @@
 #include "utils/LogAction.hpp"
 #include "errorhandling/UnsatException.hpp"
 #include "InitialDelayComputation.hpp"
+#include "utils/Profiler.hpp"
 
 // TODO combine with delaying on functions and cpsupport, can also remove some checks in the code then
 
@@ -45,6 +46,34 @@ Rule* DelayedRule::getRule() const {
 	return _rule->getRule();
 }
 
+void KnownLiterals::add(Atom atom, const ElementTuple& args) {
+	uint index = _literals.size();
+	_literals.push_back( { atom, args });
+	for (auto& position2index : _indexes) {
+		position2index.second[args[position2index.first]].push_back(index);
+	}
+}
+
+void KnownLiterals::addIndex(uint position) {
+	if (hasIndex(position)) {
+		return;
+	}
+	auto& index = _indexes[position];
+	for (uint i = 0; i < _literals.size(); ++i) {
+		index[_literals[i].second[position]].push_back(i);
+	}
+}
+
+const std::vector<uint>& KnownLiterals::matching(uint position, const DomainElement* element) const {
+	Assert(hasIndex(position));
+	const auto& index = _indexes.at(position);
+	auto it = index.find(element);
+	if (it == index.cend()) {
+		return _nomatch;
+	}
+	return it->second;
+}
+
 ContainerAtom::~ContainerAtom(){
 	// deleteList(tables); // FIXME deletion (not guaranteed to be unique)
 }
@@ -52,8 +81,7 @@ ContainerAtom::~ContainerAtom(){
 DelayedSentence::DelayedSentence(FormulaGrounder* sentence, std::shared_ptr<Delay> delay)
 		: 	done(false),
 			sentence(sentence),
-			delay(delay),
-			singletuple(std::vector<std::pair<Atom, ElementTuple>>{ { -1, {} } }){
+			delay(delay) {
 	for (auto conjunct : delay->condition) {
 		// TODO Create construction definition
 	}
@@ -65,6 +93,8 @@ LazyGroundingManager::LazyGroundingManager(AbstractGroundTheory* grounding, cons
 			_nbModelsEquivalent(nbModelsEquivalent),
 			_outputvocabulary(outputvocabulary),
 			_structures(structures),
+			nbfiredevents(0),
+			nbignoredevents(0),
 			resolvingqueues(false) {
 	translator()->addMonitor(this); // NOTE: request notifications of literal additions
 	notifyForOutputVoc(NULL, { }); // NOTE: ugly hack to notify the solver there will be an output vocabulary (otherwise everything is default outputvoc)
@@ -72,6 +102,9 @@ LazyGroundingManager::LazyGroundingManager(AbstractGroundTheory* grounding, cons
 }
 
 LazyGroundingManager::~LazyGroundingManager() {
+	if (verbosity() > 0 && nbfiredevents + nbignoredevents > 0) {
+		clog << "Lazy grounding handled " << nbfiredevents << " firings and ignored " << nbignoredevents << " firings.\n";
+	}
 	deleteList<Grounder>(groundersRegisteredForDeletion);
 	deleteList(tablesToDelete);
 }
@@ -251,8 +284,24 @@ void LazyGroundingManager::fireAllKnown(DelayedRule* delrule, bool watchedvalue)
 	Assert(resolvingqueues);
 	auto symbol = delrule->getRule()->head()->symbol();
 	const auto& knownlits = symbol2knownlits[symbol][watchedvalue];
-	for (const auto& atom2tuple : knownlits) {
-		specificFire(delrule, watchedvalue ? atom2tuple.first : -atom2tuple.first, atom2tuple.second);
+	for (uint i = 0; i < knownlits.size(); ++i) {
+		specificFire(delrule, watchedvalue ? knownlits[i].first : -knownlits[i].first, knownlits[i].second);
+	}
+}
+
+// Index the known literals of each conjunct on the arguments it shares with other conjuncts: those can already be instantiated when the conjunct is joined
+void LazyGroundingManager::indexKnownLiterals(const Delay& delay) {
+	for (uint c = 0; c < delay.condition.size(); ++c) {
+		const auto& conjunct = delay.condition[c];
+		for (uint i = 0; i < conjunct.args.size(); ++i) {
+			auto shared = false;
+			for (uint d = 0; d < delay.condition.size() && not shared; ++d) {
+				shared = d != c && contains(delay.condition[d].args, conjunct.args[i]);
+			}
+			if (shared) {
+				symbol2knownlits[conjunct.symbol][conjunct.watchedvalue].addIndex(i);
+			}
+		}
 	}
 }
 
@@ -283,6 +332,7 @@ void LazyGroundingManager::delay(DefinitionGrounder* dg, const std::set<RuleGrou
 }
 
 void LazyGroundingManager::resolveQueues() {
+	ProfilePhase phase("lazygrounding");
 	Assert(not resolvingqueues);
 	resolvingqueues = true;
 	bool changes = true;
@@ -458,14 +508,16 @@ void LazyGroundingManager::delay(FormulaGrounder* grounder, shared_ptr<Delay> de
 		auto pf = new PredForm(SIGN::POS, conjunct.symbol, terms, { });
 		checkAddedDelay(pf, conjunct.watchedvalue, false);
 		pf->recursiveDelete();
+	}
+	indexKnownLiterals(*delsent->delay);
 
-		Assert(resolvingqueues);
-		// Add watches for all that have already been introduced into the grounding
-		for (auto conjunct : delsent->delay->condition) {
-			const auto& knownlits = symbol2knownlits[conjunct.symbol][conjunct.watchedvalue];
-			for (const auto& atom2tuple : knownlits) {
-				specificFire(delsent, conjunct.watchedvalue ? atom2tuple.first : -atom2tuple.first, conjunct.symbol, atom2tuple.second);
-			}
+	Assert(resolvingqueues);
+	// Add watches for all that have already been introduced into the grounding
+	// NOTE: checkAddedDelay only queues literals, so replaying once after all conjuncts have been added suffices
+	for (auto conjunct : delsent->delay->condition) {
+		const auto& knownlits = symbol2knownlits[conjunct.symbol][conjunct.watchedvalue];
+		for (uint i = 0; i < knownlits.size(); ++i) {
+			specificFire(delsent, conjunct.watchedvalue ? knownlits[i].first : -knownlits[i].first, conjunct.symbol, knownlits[i].second);
 		}
 	}
 }
@@ -539,8 +591,7 @@ void LazyGroundingManager::addToOutputVoc(PFSymbol* symbol, bool expensiveConstr
 	auto posstrue = new PredForm(SIGN::POS, symbol->derivedSymbol(SymbolType::ST_PT), varterms, FormulaParseInfo());
 	auto possfalse = new PredForm(SIGN::POS, symbol->derivedSymbol(SymbolType::ST_PF), varterms2, FormulaParseInfo());
 	auto formula = new BoolForm(SIGN::POS, true, posstrue, possfalse, FormulaParseInfo());
-	Query q("", vars, formula, { });
-	auto table = Querying::doSolveQuery(&q, getStructure(), _structures.symstructure);
+	auto table = Querying::doSolveFormula(vars, formula, getStructure(), _structures.symstructure);
 	for (auto i = table->begin(); not i.isAtEnd(); ++i) {
 		auto lit = translator()->translateReduced(symbol, *i, false); // NOTE: also creates all those literals, so also notifyNewLiteral gets called!
 		if (lit != _true && lit != _false) {
@@ -548,7 +599,6 @@ void LazyGroundingManager::addToOutputVoc(PFSymbol* symbol, bool expensiveConstr
 		}
 	}
 	notifyForOutputVoc(symbol, lits);
-	formula->recursiveDelete();
 }
 void LazyGroundingManager::checkAddedDelay(PredForm* pf, bool watchedvalue, bool expensiveConstruction) {
 	if (getOption(CPSUPPORT) && pf->symbol()->isFunction()) {
@@ -557,8 +607,8 @@ void LazyGroundingManager::checkAddedDelay(PredForm* pf, bool watchedvalue, bool
 
 	addKnownToStructures(pf, watchedvalue);
 	addToOutputVoc(pf->symbol(), expensiveConstruction);
-	for(auto tuple2lit: translator()->getIntroducedLiteralsFor(pf->symbol())){
-		needWatch(watchedvalue, tuple2lit.second);
+	for(auto lit: translator()->getIntroducedLiteralsFor(pf->symbol())){
+		needWatch(watchedvalue, lit);
 	}
 }
 
@@ -656,13 +706,13 @@ void LazyGroundingManager::notifyNewLiteral(PFSymbol* symbol, const ElementTuple
 //			 FIRING
 //============================
 
-// TODO remove watch if fully grounded
 void LazyGroundingManager::fired(Atom atom, bool value) {
 	if (verbosity() > 2) {
 		clog << "Fired " << translator()->printLit(atom) << " on " << value << "\n";
 	}
 
 	if (not translator()->isInputAtom(atom)) {
+		nbignoredevents++;
 		return;
 	}
 	const auto& symbol = translator()->getSymbol(atom);
@@ -670,7 +720,7 @@ void LazyGroundingManager::fired(Atom atom, bool value) {
 
 	auto lit = value ? atom : -atom;
 	if (not contains(alreadygroundedlits, lit)) {
-		symbol2knownlits[symbol][value].push_back( { atom, args }); // TODO table per argument. use indexing induced by the delays at hand
+		symbol2knownlits[symbol][value].add(atom, args);
 		alreadygroundedlits.insert(lit);
 	}
 
@@ -683,10 +733,11 @@ void LazyGroundingManager::fired(Atom atom, bool value) {
 	auto symbolit2 = symbol2watchedsentences.find(symbol);
 	if (symbolit2 != symbol2watchedsentences.cend()) {
 		auto& list = symbolit2->second[value];
-		for (auto i = list.begin(); i < list.end();) {
-			specificFire(*i, lit, symbol, args);
-			if ((*i)->done) {
-				i = list.erase(i);
+		for (uint i = 0; i < list.size();) {
+			specificFire(list[i], lit, symbol, args);
+			if (list[i]->done) { // Fully grounded, so remove the watch (order of the watches is irrelevant)
+				list[i] = list.back();
+				list.pop_back();
 			} else {
 				++i;
 			}
@@ -699,8 +750,10 @@ void LazyGroundingManager::specificFire(DelayedRule* rule, Lit lit, const Elemen
 		if (verbosity() > 5) {
 			clog << "Already grounded for " << toString(rule->getRule()) << "\n";
 		}
+		nbignoredevents++;
 		return;
 	}
+	nbfiredevents++;
 	rule2alreadygroundedlits[rule].insert(lit);
 	rule->notifyHeadFired(lit, args, translator(), tempdefs);
 }
@@ -710,12 +763,16 @@ void LazyGroundingManager::specificFire(DelayedSentence* sentence, Lit lit, PFSy
 		if (verbosity() > 5) {
 			clog << "Already grounded for " << toString((sentence)->sentence) << "\n";
 		}
+		nbignoredevents++;
 		return;
 	}
 	sent2alreadygroundedlits[(sentence)].insert(lit);
-	if (not (sentence)->done) {
-		(sentence)->notifyFired(*this, symbol, args);
+	if ((sentence)->done) {
+		nbignoredevents++;
+		return;
 	}
+	nbfiredevents++;
+	(sentence)->notifyFired(*this, symbol, args);
 }
 
 void DelayedRule::notifyHeadFired(const Lit& head, const ElementTuple& tuple, GroundTranslator* translator, map<DefId, GroundDefinition*>& tempdefs) {
@@ -781,60 +838,64 @@ void DelayedSentence::recursiveFire(FireInformation& info) {
 	}
 
 	if (info.firedindex == info.currentindex) {
-		singletuple[0].second = info.tuplefired;
-		recursiveFire(singletuple, info);
-	} else {
-		recursiveFire(info.manager.getFiredLits(info.conjunction[info.currentindex].symbol, info.conjunction[info.currentindex].watchedvalue), info);
+		tryInstantiation(info.tuplefired, info);
+		return;
+	}
+
+	const auto& conjunct = info.conjunction[info.currentindex];
+	const auto& knownlits = info.manager.getFiredLits(conjunct.symbol, conjunct.watchedvalue);
+	for (uint i = 0; i < conjunct.args.size(); ++i) { // If an indexed argument is already instantiated, only visit the matching literals
+		if (knownlits.hasIndex(i) && contains(info.fullinstantiation, conjunct.args[i])) {
+			const auto& matching = knownlits.matching(i, conjunct.args[i]->get());
+			for (uint j = 0; j < matching.size() && not done; ++j) {
+				tryInstantiation(knownlits[matching[j]].second, info);
+			}
+			return;
+		}
+	}
+	for (uint j = 0; j < knownlits.size() && not done; ++j) {
+		tryInstantiation(knownlits[j].second, info);
 	}
 }
 
-void DelayedSentence::recursiveFire(const vector<pair<Atom, ElementTuple>>& tuples, FireInformation& info) {
+void DelayedSentence::tryInstantiation(const ElementTuple& tuple, FireInformation& info) {
 	if (done) {
 		return;
 	}
-	auto savedinst = info.fullinstantiation;
-	auto changed = false;
-	for (auto atomandtuple : tuples) {
-		if(changed){
-			info.fullinstantiation = savedinst;
-		}
-		changed = false;
-		bool valid = true;
-		for (uint i = 0; i < atomandtuple.second.size(); ++i) {
-			const auto& container = info.conjunction[info.currentindex].args[i];
-			if (contains(info.fullinstantiation, container)) {
-				if (container->get() != atomandtuple.second[i]) { // Non-matching instantiation
-					valid = false;
-					if (getOption(VERBOSE_GROUNDING) > 5) {
-						clog << "Instantiation did not match the contents\n";
-					}
-					break;
-				}
-			} else {
-				*container = atomandtuple.second[i];
-				changed = true;
-				info.fullinstantiation.insert(container);
-			}
-			if (not info.conjunction[info.currentindex].tables[i]->contains(atomandtuple.second[i])) { // Instantiation does not match sorttable
-				// FIXME also add to head firing!
+	std::vector<const DomElemContainer*> newlyinstantiated;
+	bool valid = true;
+	for (uint i = 0; i < tuple.size(); ++i) {
+		const auto& container = info.conjunction[info.currentindex].args[i];
+		if (contains(info.fullinstantiation, container)) {
+			if (container->get() != tuple[i]) { // Non-matching instantiation
+				valid = false;
 				if (getOption(VERBOSE_GROUNDING) > 5) {
-					clog << "Did not match the instantiation!\n";
+					clog << "Instantiation did not match the contents\n";
 				}
-				valid = false;
 				break;
 			}
+		} else {
+			*container = tuple[i];
+			newlyinstantiated.push_back(container);
+			info.fullinstantiation.insert(container);
+		}
+		if (not info.conjunction[info.currentindex].tables[i]->contains(tuple[i])) { // Instantiation does not match sorttable
+			// FIXME also add to head firing!
+			if (getOption(VERBOSE_GROUNDING) > 5) {
+				clog << "Did not match the instantiation!\n";
+			}
+			valid = false;
+			break;
 		}
-		if (not valid) {
-			continue;
-		}
+	}
+	if (valid) {
 		info.currentindex++;
 		recursiveFire(info);
-		if (done) {
-			return;
-		}
 		info.currentindex--;
 	}
-	info.fullinstantiation = savedinst;
+	for (auto container : newlyinstantiated) {
+		info.fullinstantiation.erase(container);
+	}
 }
 
 
@@ -13,6 +13,7 @@
 #include "inferences/grounding/grounders/FormulaGrounders.hpp"
 #include "inferences/grounding/grounders/DefinitionGrounders.hpp"
 #include <vector>
+#include <unordered_map>
 
 struct ContainerAtom {
 	PFSymbol* symbol;
@@ -30,6 +31,37 @@ struct Delay {
 	void put(std::ostream&) const;
 };
 
+/**
+ * The atoms of one symbol which have become known with one value, together with their arguments.
+ * Delays which join over shared variables request an index on the argument positions they can instantiate before reaching this symbol,
+ * so only the literals matching the instantiation have to be visited instead of all known literals.
+ */
+class KnownLiterals {
+private:
+	std::vector<std::pair<Atom, ElementTuple> > _literals;
+	std::map<uint, std::unordered_map<const DomainElement*, std::vector<uint> > > _indexes; // Argument position -> element -> indices in _literals
+	std::vector<uint> _nomatch;
+
+public:
+	void add(Atom atom, const ElementTuple& args);
+	void addIndex(uint position);
+	bool hasIndex(uint position) const {
+		return _indexes.find(position) != _indexes.cend();
+	}
+	// PRECONDITION: hasIndex(position)
+	const std::vector<uint>& matching(uint position, const DomainElement* element) const;
+
+	const std::pair<Atom, ElementTuple>& operator[](uint index) const {
+		return _literals[index];
+	}
+	size_t size() const {
+		return _literals.size();
+	}
+	bool empty() const {
+		return _literals.empty();
+	}
+};
+
 class DelayedSentence {
 public:
 	bool done;
@@ -53,8 +85,7 @@ private:
 		std::set<const DomElemContainer*> fullinstantiation;
 	};
 	void recursiveFire(FireInformation& info);
-	std::vector<std::pair<Atom, ElementTuple>> singletuple;
-	void recursiveFire(const std::vector<std::pair<Atom, ElementTuple>>& tuples, FireInformation& info);
+	void tryInstantiation(const ElementTuple& tuple, FireInformation& info);
 };
 class DelayedRule {
 private:
@@ -116,7 +147,9 @@ private:
 	std::set<Lit> alreadygroundedlits;
 	std::map<DelayedSentence*, std::set<Lit>> sent2alreadygroundedlits;
 	std::map<DelayedRule*, std::set<Lit>> rule2alreadygroundedlits;
-	std::map<PFSymbol*, std::map<bool, std::vector<std::pair<Atom, ElementTuple> >>> symbol2knownlits; // Has become true at least once, ...
+	std::map<PFSymbol*, std::map<bool, KnownLiterals>> symbol2knownlits; // Has become true at least once, ...
+
+	uint nbfiredevents, nbignoredevents; // Firings which (possibly) lead to grounding, and firings which were ignored because there was nothing left to ground
 
 	std::set<PFSymbol*> constructedAsDef;// Symbols which are constructed as definition. Can never be used for other watches
 
@@ -190,12 +223,13 @@ private:
 	void notifyForOutputVoc(PFSymbol* symbol, const litlist& literals);
 
 	void delay(FormulaGrounder* grounder, std::shared_ptr<Delay> delay);
+	void indexKnownLiterals(const Delay& delay);
 
-	std::vector<std::pair<Atom, ElementTuple> > emptylist;// Slight hack ;-) to allow to return const ref even for the empty list without having it as keys
+	KnownLiterals emptylist;// Slight hack ;-) to allow to return const ref even for the empty list without having it as keys
 
 	friend class DelayedSentence;
 	friend class FindDelayPredForms;
-	const std::vector<std::pair<Atom, ElementTuple> >& getFiredLits(PFSymbol* symbol, bool v) const {
+	const KnownLiterals& getFiredLits(PFSymbol* symbol, bool v) const {
 		if (not contains(symbol2knownlits, symbol)) {
 			return emptylist;
 		}
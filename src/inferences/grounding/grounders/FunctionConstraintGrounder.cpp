@@ -0,0 +1,116 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "FunctionConstraintGrounder.hpp"
+
+#include "IncludeComponents.hpp"
+#include "groundtheories/AbstractGroundTheory.hpp"
+#include "inferences/grounding/GroundTranslator.hpp"
+#include "generators/GeneratorFactory.hpp"
+#include "generators/InstGenerator.hpp"
+
+using namespace std;
+
+FunctionConstraintGrounder::FunctionConstraintGrounder(AbstractGroundTheory* gt, const GroundingContext& context, Function* function,
+		const Structure* structure)
+		: Grounder(gt, context), _function(function), _structure(structure) {
+	for (size_t n = 0; n < function->insorts().size(); ++n) {
+		_argvars.push_back(new DomElemContainer());
+	}
+}
+
+bool FunctionConstraintGrounder::canGround(Function* function, const Structure* structure) {
+	for (auto sort : function->sorts()) {
+		if (not structure->inter(sort)->approxFinite()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void FunctionConstraintGrounder::internalRun(ConjOrDisj& formula, LazyGroundingRequest&) {
+	formula.setType(Conn::CONJ);
+	if (verbosity() > 2) {
+		clog << "Grounding function constraint for " << print(_function) << "\n";
+	}
+
+	auto inter = _structure->inter(_function)->graphInter();
+	auto ct = inter->ct();
+	auto pt = inter->pt();
+
+	vector<const DomainElement*> range;
+	auto rangetable = _structure->inter(_function->outsort());
+	for (auto it = rangetable->sortBegin(); not it.isAtEnd(); ++it) {
+		range.push_back(*it);
+	}
+
+	vector<SortTable*> argtables;
+	for (auto sort : _function->insorts()) {
+		argtables.push_back(_structure->inter(sort));
+	}
+	auto generator = GeneratorFactory::create(_argvars, argtables);
+
+	ElementTuple tuple(_function->arity() + 1);
+	for (generator->begin(); not generator->isAtEnd() && formula.literals.empty(); generator->operator++()) {
+		CHECKTERMINATION;
+		for (size_t n = 0; n < _argvars.size(); ++n) {
+			tuple[n] = _argvars[n]->get();
+		}
+		litlist images;
+		int nbtrueimages = 0;
+		for (auto value : range) {
+			tuple.back() = value;
+			if (not pt->contains(tuple)) {
+				continue;
+			}
+			if (ct->contains(tuple)) {
+				++nbtrueimages;
+			} else {
+				images.push_back(translator()->translateReduced(_function, tuple, false));
+				notifyGroundedAtom();
+			}
+		}
+		addConstraint(images, nbtrueimages, formula);
+	}
+
+	delete (generator);
+}
+
+/**
+ * Adds the constraint for one tuple of arguments, given the literals of its possible images and the number of certain images.
+ * If the constraint is certainly violated, formula is set to false.
+ */
+void FunctionConstraintGrounder::addConstraint(const litlist& images, int nbtrueimages, ConjOrDisj& formula) {
+	if (nbtrueimages > 1 || (nbtrueimages == 0 && images.empty() && not _function->partial())) {
+		formula.literals.push_back(_false);
+		return;
+	}
+	if (nbtrueimages == 1) {
+		for (auto image : images) {
+			getGrounding()->addUnitClause(-image);
+		}
+		return;
+	}
+	if (not _function->partial()) {
+		getGrounding()->add(GroundClause(images));
+	}
+	if (images.size() == 2) {
+		getGrounding()->add(GroundClause { -images[0], -images[1] });
+	} else if (images.size() > 2) { // 1 >= #images
+		auto setnr = translator()->translateSet(images, weightlist(images.size(), 1), { }, { });
+		auto tseitin = translator()->reify(1, CompType::GEQ, AggFunction::CARD, setnr, TsType::IMPL);
+		getGrounding()->addUnitClause(tseitin);
+	}
+}
+
+void FunctionConstraintGrounder::put(std::ostream& stream) const {
+	stream << "function constraint for " << print(_function);
+}
@@ -0,0 +1,48 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef FUNCTIONCONSTRAINTGROUNDER_HPP_
+#define FUNCTIONCONSTRAINTGROUNDER_HPP_
+
+#include "inferences/grounding/grounders/Grounder.hpp"
+
+class Function;
+class Structure;
+
+/**
+ * Grounds the constraint that a function has exactly one image (at most one if it is partial) for each tuple of arguments.
+ * Instead of grounding the sentence !x: #{y: F(x)=y} = 1 through the formula grounders, it directly adds,
+ * for each tuple of arguments, a clause over the possible images and a cardinality constraint on them.
+ * Images which are certainly true or false in the structure are taken into account, so no atoms are created for them.
+ */
+class FunctionConstraintGrounder: public Grounder {
+private:
+	Function* _function;
+	const Structure* _structure;
+	//! The arguments of the function, reused by every run
+	//! NOTE: containers are owned by the global registry of DomElemContainer, which deletes them at exit
+	std::vector<const DomElemContainer*> _argvars;
+
+	void addConstraint(const litlist& images, int nbtrueimages, ConjOrDisj& formula);
+
+protected:
+	void internalRun(ConjOrDisj& formula, LazyGroundingRequest& request);
+
+public:
+	FunctionConstraintGrounder(AbstractGroundTheory* gt, const GroundingContext& context, Function* function, const Structure* structure);
+
+	//! True iff the constraint on the given function can be grounded natively: all its sorts have to be finite
+	static bool canGround(Function* function, const Structure* structure);
+
+	void put(std::ostream& stream) const;
+};
+
+#endif /* FUNCTIONCONSTRAINTGROUNDER_HPP_ */
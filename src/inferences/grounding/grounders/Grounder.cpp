@@ -15,6 +15,7 @@
 #include "groundtheories/AbstractGroundTheory.hpp"
 #include "inferences/grounding/GroundTranslator.hpp"
 #include "errorhandling/UnsatException.hpp"
+#include "utils/Profiler.hpp"
 
 using namespace std;
 
@@ -117,12 +118,22 @@ bool Grounder::toplevelRun(LazyGroundingRequest& request) {
 
 #include <inferences/grounding/grounders/FormulaGrounders.hpp>
 
-// TODO unfinished code for printing the timings of a grounder
+// Describes a grounder in the profile by the formula it grounds
+std::string describeGrounder(const void* grounder) {
+	auto formulagrounder = dynamic_cast<const FormulaGrounder*>((const Grounder*) grounder);
+	if (formulagrounder != NULL && formulagrounder->hasFormula()) {
+		return toString(formulagrounder->getFormula());
+	}
+	return typeid(*(const Grounder*) grounder).name();
+}
+
 void Grounder::run(ConjOrDisj& formula, LazyGroundingRequest& request){
+	ProfilePhase phase("grounder", this, &describeGrounder);
 	internalRun(formula, request);
 }
 
 Lit Grounder::groundAndReturnLit(LazyGroundingRequest& request) {
+	ProfilePhase phase("grounder", this, &describeGrounder);
 	ConjOrDisj formula;
 	internalRun(formula, request);
 	if (formula.literals.size() == 0) {
@@ -44,12 +44,14 @@ void PredicateSymbolIterator::doNext(Structure* s) {
 		predInter->makeFalseExactly(_tuple);
 		state++;
 	}
+	s->notifyChanged(pred);
 }
 
 void PredicateSymbolIterator::undo(Structure* s) {
 	auto pred = _predicateInterpretation.first;
 	auto predInter = s->inter(pred);
 	predInter->makeUnknownExactly(_tuple);
+	s->notifyChanged(pred);
 	state = 0;
 }
 
@@ -116,6 +118,7 @@ void FunctionSymbolIterator::doNext(Structure* s) {
 		++(*_iterator);
 		init(s);
 	}
+	s->notifyChanged(function);
 }
 
 void FunctionSymbolIterator::undo(Structure* s) {
@@ -129,6 +132,7 @@ void FunctionSymbolIterator::undo(Structure* s) {
 		graph->makeUnknownExactly(tuple);
 		tuple.pop_back();
 	}
+	s->notifyChanged(function);
 	_iterator = std::unique_ptr<SortIterator>(new SortIterator(sorts.back()->sortBegin()));
 	init(s);
 	if (_iterator != nullptr) {
@@ -12,6 +12,9 @@
 TwoValuedStructureIterator::TwoValuedStructureIterator(Structure* original) : position(0) {
 	structure = original->clone();
 	stack = create(original);
+	// Only the symbols in the stack change, so after cleaning the others once, each model only cleans those
+	structure->trackChanges(true);
+	structure->clean();
 }
 
 TwoValuedStructureIterator::~TwoValuedStructureIterator() {
@@ -35,6 +38,7 @@ Structure* TwoValuedStructureIterator::next() {
 	}
 	Structure* out = structure->clone();
 	out->clean();
+	out->trackChanges(false);
 	Assert(out->approxTwoValued());
 	for (; position >= 0;) {
 		position--;
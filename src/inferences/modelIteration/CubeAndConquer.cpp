@@ -0,0 +1,180 @@
+#include "CubeAndConquer.hpp"
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+#ifdef UNIX
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+vector<litlist> CubeAndConquer::makeCubes(const litlist& splitatoms) {
+	vector<litlist> cubes(1);
+	for (auto atom : splitatoms) {
+		vector<litlist> extended;
+		for (const auto& cube : cubes) {
+			for (auto lit : { atom, -atom }) {
+				extended.push_back(cube);
+				extended.back().push_back(lit);
+			}
+		}
+		cubes = extended;
+	}
+	return cubes;
+}
+
+litlist CubeAndConquer::chooseSplitAtoms(const litlist& candidates, const vector<litlist>& samples, unsigned int nbatoms) {
+	vector<unordered_set<Lit> > truelits;
+	for (const auto& sample : samples) {
+		truelits.push_back(unordered_set<Lit>(sample.cbegin(), sample.cend()));
+	}
+	// The cube of every sample, as the bits of the values of the split atoms chosen so far
+	vector<unsigned long long> cubeofsample(samples.size(), 0);
+	litlist chosen;
+	// Sum of squares of the number of samples per cube, minimal for an even split
+	auto currentscore = samples.size() * samples.size();
+	while (chosen.size() < nbatoms) {
+		Lit best = 0;
+		auto bestscore = currentscore;
+		for (auto atom : candidates) {
+			if (find(chosen.cbegin(), chosen.cend(), atom) != chosen.cend()) {
+				continue;
+			}
+			map<unsigned long long, size_t> cubesizes;
+			size_t nbtrue = 0;
+			for (size_t i = 0; i < samples.size(); ++i) {
+				auto value = truelits[i].find(atom) != truelits[i].cend();
+				nbtrue += value ? 1 : 0;
+				++cubesizes[(cubeofsample[i] << 1) | (value ? 1 : 0)];
+			}
+			if (nbtrue == 0 || nbtrue == samples.size()) {
+				continue;
+			}
+			size_t score = 0;
+			for (auto& cube2size : cubesizes) {
+				score += cube2size.second * cube2size.second;
+			}
+			if (score < bestscore) { // Atoms which do not split any cube further are useless
+				best = atom;
+				bestscore = score;
+			}
+		}
+		if (best == 0) {
+			break;
+		}
+		chosen.push_back(best);
+		currentscore = bestscore;
+		for (size_t i = 0; i < samples.size(); ++i) {
+			cubeofsample[i] = (cubeofsample[i] << 1) | (truelits[i].find(best) != truelits[i].cend() ? 1 : 0);
+		}
+	}
+	return chosen;
+}
+
+#ifdef UNIX
+
+// Every model is sent as its number of literals followed by the literals
+bool CubeAndConquer::runWorker(const vector<litlist>& cubes, const CubeEnumeration& enumerate, int pipe) {
+	for (const auto& cube : cubes) {
+		enumerate(cube, [pipe](const litlist& model) {
+			int size = model.size();
+			if (not ForkedWorkers::writeAll(pipe, &size, sizeof(int)) || (size > 0 && not ForkedWorkers::writeAll(pipe, &model[0], size * sizeof(Lit)))) {
+				throw IdpException("Could not send a model to the enumeration process.");
+			}
+		});
+	}
+	return true;
+}
+
+CubeAndConquer::CubeAndConquer(const vector<litlist>& cubes, unsigned int nbworkers, const CubeEnumeration& enumerate) {
+	vector<vector<litlist> > parts(min((size_t) nbworkers, cubes.size()));
+	for (size_t i = 0; i < cubes.size(); ++i) {
+		parts[i % parts.size()].push_back(cubes[i]);
+	}
+	for (const auto& part : parts) {
+		// The workers which were already started are killed by _workers if this throws
+		auto started = _workers.start([&part, &enumerate](int pipe) {
+			return runWorker(part, enumerate, pipe);
+		});
+		if (started == -1) {
+			throw IdpException("Could not fork an enumeration worker.");
+		}
+	}
+	_buffers.resize(_workers.size());
+}
+
+bool CubeAndConquer::popModel(vector<char>& buffer, litlist& model) {
+	int size;
+	if (buffer.size() < sizeof(int)) {
+		return false;
+	}
+	memcpy(&size, &buffer[0], sizeof(int));
+	auto bytes = sizeof(int) + size * sizeof(Lit);
+	if (buffer.size() < bytes) {
+		return false;
+	}
+	model.resize(size);
+	if (size > 0) {
+		memcpy(&model[0], &buffer[sizeof(int)], size * sizeof(Lit));
+	}
+	buffer.erase(buffer.begin(), buffer.begin() + bytes);
+	return true;
+}
+
+bool CubeAndConquer::next(litlist& model, const function<bool()>& interrupted) {
+	while (true) {
+		vector<pollfd> fds;
+		vector<size_t> polled;
+		for (size_t i = 0; i < _workers.size(); ++i) {
+			if (popModel(_buffers[i], model)) {
+				return true;
+			}
+			auto pipe = _workers.pipe(i);
+			if (pipe == -1 && not _buffers[i].empty()) {
+				throw IdpException("A worker of the parallel model enumeration sent an incomplete model.");
+			}
+			if (pipe != -1) {
+				fds.push_back(pollfd { pipe, POLLIN, 0 });
+				polled.push_back(i);
+			}
+		}
+		if (fds.empty()) {
+			return false;
+		}
+		if (interrupted()) {
+			return false;
+		}
+		if (poll(fds.data(), fds.size(), 100) < 0) {
+			continue; // Interrupted by a signal
+		}
+		for (size_t i = 0; i < fds.size(); ++i) {
+			if (fds[i].revents == 0) {
+				continue;
+			}
+			auto& buffer = _buffers[polled[i]];
+			char bytes[4096];
+			auto n = read(fds[i].fd, bytes, sizeof(bytes));
+			if (n > 0) {
+				buffer.insert(buffer.end(), bytes, bytes + n);
+				continue;
+			}
+			if (not _workers.finish(polled[i])) {
+				throw IdpException("A worker of the parallel model enumeration failed.");
+			}
+		}
+	}
+}
+
+#else
+
+CubeAndConquer::CubeAndConquer(const vector<litlist>&, unsigned int, const CubeEnumeration&) {
+	throw IdpException("Parallel model enumeration is only supported on Unix.");
+}
+
+bool CubeAndConquer::next(litlist&, const function<bool()>&) {
+	return false;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "common.hpp"
+#include "utils/ForkedWorkers.hpp"
+
+/**
+ * Cube-and-conquer enumeration: the models are partitioned into disjoint cubes over a few split atoms,
+ * which are enumerated by forked workers, each on its own copy of the solver.
+ * The models found by the workers are merged into one stream, in the order in which they arrive.
+ *
+ * NOTE: only supported on Unix.
+ */
+class CubeAndConquer {
+public:
+	//! Calls found for every model (all literals of the solver) with the literals of the cube assumed
+	typedef std::function<void(const litlist& cube, const std::function<void(const litlist&)>& found)> CubeEnumeration;
+
+private:
+	ForkedWorkers _workers;
+	std::vector<std::vector<char> > _buffers; //!< Per worker, the bytes received but not yet returned as a model
+
+	static bool runWorker(const std::vector<litlist>& cubes, const CubeEnumeration& enumerate, int pipe);
+	static bool popModel(std::vector<char>& buffer, litlist& model);
+
+public:
+	/**
+	 * Forks the workers. Cube i is enumerated by worker i modulo nbworkers.
+	 * NOTE: the caller should not use its solver while the workers run, as they start from its current state.
+	 */
+	CubeAndConquer(const std::vector<litlist>& cubes, unsigned int nbworkers, const CubeEnumeration& enumerate);
+
+	/**
+	 * Waits for the next model of any worker. Returns false if all workers are done.
+	 * Polls interrupted every few milliseconds, and returns false if it holds.
+	 * Throws if a worker failed, as its remaining models are unknown.
+	 */
+	bool next(litlist& model, const std::function<bool()>& interrupted);
+
+	//! The 2^n cubes over the split atoms
+	static std::vector<litlist> makeCubes(const litlist& splitatoms);
+	/**
+	 * Greedily chooses at most nbatoms atoms among the candidates, each time the one which splits the sampled models most evenly over the cubes so far.
+	 * Atoms which do not split the samples in any cube further (e.g. with the same value in all samples) are never chosen.
+	 */
+	static litlist chooseSplitAtoms(const litlist& candidates, const std::vector<litlist>& samples, unsigned int nbatoms);
+};
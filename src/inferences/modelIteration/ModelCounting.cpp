@@ -0,0 +1,199 @@
+#include "ModelCounting.hpp"
+#include "ModelIterator.hpp"
+#include "options.hpp"
+#include "GlobalData.hpp"
+#include "utils/ForkedWorkers.hpp"
+#include "utils/LogAction.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+
+ModelCounting::ModelCounting(AbstractTheory* theory, Structure* structure, Vocabulary* outputvoc)
+		: _nbprojections(0) {
+	// Values of function terms handled by the CP solver are not literals, so they could not be blocked
+	auto storedcp = getOption(CPSUPPORT);
+	setOption(CPSUPPORT, false);
+	try {
+		_iterator = createIterator(theory, structure, outputvoc, NULL);
+		_iterator->init();
+	} catch (...) {
+		setOption(CPSUPPORT, storedcp);
+		throw;
+	}
+	setOption(CPSUPPORT, storedcp);
+}
+
+bool ModelCounting::next(Projection& projection) {
+	litlist literals;
+	if (not _iterator->calculateProjection(literals)) {
+		return false;
+	}
+	++_nbprojections;
+	if (_atoms.empty()) { // All models assign the same atoms
+		for (auto lit : literals) {
+			_atoms.push_back(abs(lit));
+		}
+	}
+	projection.clear();
+	for (auto lit : literals) {
+		if (lit > 0) {
+			projection.insert(lit);
+		}
+	}
+	return true;
+}
+
+CountResult ModelCounting::count(bool approximate, unsigned int nbworkers) {
+	auto start = chrono::steady_clock::now();
+	CountResult result;
+	result.exact = true;
+	result.count = approximate ? countApproximately(nbworkers, result.exact) : countExactly();
+	result.nbprojections = _nbprojections;
+	result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	if (getOption(VERBOSE_SOLVING) > 0) {
+		logActionAndValue("nrmodels", result.count);
+		logActionAndValue("exact", result.exact ? "true" : "false");
+		logActionAndValue("solver-models", result.nbprojections);
+		logActionAndValue("counting-time", result.seconds);
+		logActionAndValue("models-per-second", result.seconds > 0 ? result.nbprojections / result.seconds : 0);
+	}
+	return result;
+}
+
+double ModelCounting::countExactly() {
+	double count = 0;
+	Projection projection;
+	while (next(projection)) {
+		++count;
+	}
+	return count;
+}
+
+// The XOR is chained through fresh atoms t_i <=> t_(i-1) xor atom_i
+void ModelCounting::addXor(const litlist& atoms, bool parity) {
+	Assert(not atoms.empty());
+	auto sum = atoms.front();
+	for (auto i = atoms.cbegin() + 1; i != atoms.cend(); ++i) {
+		auto atom = *i;
+		auto t = _iterator->newAtom();
+		_iterator->addClause( { -t, sum, atom });
+		_iterator->addClause( { -t, -sum, -atom });
+		_iterator->addClause( { t, -sum, atom });
+		_iterator->addClause( { t, sum, -atom });
+		sum = t;
+	}
+	_iterator->addClause( { parity ? sum : -sum });
+}
+
+double ModelCounting::trial(vector<Projection> cell, const litlist& atoms, mt19937& random) {
+	bernoulli_distribution coin(0.5);
+	for (size_t m = 1; m <= atoms.size(); ++m) {
+		litlist xoratoms;
+		for (auto atom : atoms) {
+			if (coin(random)) {
+				xoratoms.push_back(atom);
+			}
+		}
+		if (xoratoms.empty()) { // An empty XOR would not split the cell
+			xoratoms.push_back(atoms[random() % atoms.size()]);
+		}
+		auto parity = coin(random);
+		addXor(xoratoms, parity);
+
+		// The projections found before are blocked, so those in the new cell are kept
+		vector<Projection> smaller;
+		for (const auto& projection : cell) {
+			bool sum = false;
+			for (auto atom : xoratoms) {
+				sum ^= projection.find(atom) != projection.cend();
+			}
+			if (sum == parity) {
+				smaller.push_back(projection);
+			}
+		}
+		cell = smaller;
+		Projection projection;
+		while (cell.size() <= PIVOT && next(projection)) {
+			cell.push_back(projection);
+		}
+		if (cell.size() <= PIVOT) {
+			return cell.empty() ? -1 : ldexp((double) cell.size(), m);
+		}
+	}
+	return -1;
+}
+
+double ModelCounting::median(vector<double> estimates) {
+	estimates.erase(remove_if(estimates.begin(), estimates.end(), [](double estimate) {return estimate < 0;}), estimates.end());
+	if (estimates.empty()) {
+		return -1;
+	}
+	sort(estimates.begin(), estimates.end());
+	return estimates[estimates.size() / 2];
+}
+
+#ifdef UNIX
+
+double ModelCounting::countApproximately(unsigned int nbworkers, bool& exact) {
+	vector<Projection> found;
+	Projection projection;
+	while (found.size() <= PIVOT && next(projection)) {
+		found.push_back(projection);
+	}
+	if (found.size() <= PIVOT) {
+		exact = true;
+		return found.size();
+	}
+	exact = false;
+	vector<double> estimates;
+	auto seed = getOption(RANDOMSEED);
+	for (unsigned int first = 0; first < NBTRIALS; first += nbworkers) {
+		if (getGlobal()->terminateRequested()) {
+			throw IdpException("Solver was terminated");
+		}
+		ForkedWorkers children; // Killed when an exception leaves the batch
+		for (auto i = first; i < min(first + nbworkers, NBTRIALS); ++i) {
+			auto started = children.start([this, &found, seed, i](int pipe) {
+				mt19937 random(seed + i);
+				_nbprojections = 0;
+				double message[2] = { trial(found, _atoms, random), (double) _nbprojections };
+				return ForkedWorkers::writeAll(pipe, message, sizeof(message));
+			});
+			if (started == -1) {
+				throw IdpException("Could not fork a model counting trial.");
+			}
+		}
+		bool failed = false;
+		for (size_t child = 0; child < children.size(); ++child) {
+			double message[2];
+			auto n = ForkedWorkers::readAll(children.pipe(child), message, sizeof(message));
+			if (not children.finish(child) || n != sizeof(message)) {
+				failed = true;
+				continue;
+			}
+			estimates.push_back(message[0]);
+			_nbprojections += (unsigned long long) message[1];
+		}
+		if (getGlobal()->terminateRequested()) { // The trials were interrupted as well
+			throw IdpException("Solver was terminated");
+		}
+		if (failed) {
+			throw IdpException("A model counting trial failed.");
+		}
+	}
+	auto estimate = median(estimates);
+	if (estimate < 0) {
+		throw IdpException("All model counting trials failed, try exact counting.");
+	}
+	return estimate;
+}
+
+#else
+
+double ModelCounting::countApproximately(unsigned int, bool&) {
+	throw IdpException("Approximate model counting is only supported on Unix.");
+}
+
+#endif
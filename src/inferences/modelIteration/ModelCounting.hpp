@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <random>
+#include <unordered_set>
+#include <vector>
+#include "common.hpp"
+
+class AbstractTheory;
+class Structure;
+class Vocabulary;
+class ModelIterator;
+
+struct CountResult {
+	double count; //!< The number of models, or an estimate if not exact
+	bool exact;
+	unsigned long long nbprojections; //!< The number of projections found by the solver, over all trials
+	double seconds; //!< The wall-clock time of the search, without grounding
+};
+
+/**
+ * Counts the models of a theory extending a structure, projected onto the output vocabulary:
+ * models which only differ in atoms of other symbols are counted once.
+ * The theory is grounded once and no structures are built: after each model, only the literals of the output vocabulary are blocked.
+ * Atoms of the output vocabulary which do not occur in the grounding are not counted,
+ * so each counted model stands for all their interpretations.
+ *
+ * Approximate counting follows ApproxMC: the models are partitioned into 2^m cells by m random XOR constraints over the projected atoms,
+ * with m increasing until a cell has at most PIVOT models. The number of models in that cell times 2^m is an estimate,
+ * the median over NBTRIALS trials (each a forked process on its own copy of the solver) is returned.
+ * If there are at most PIVOT models, the count is exact.
+ */
+class ModelCounting {
+private:
+	//! For a tolerance of 0.8: the estimate is between count/1.8 and 1.8*count with high probability
+	static const unsigned int PIVOT = 72;
+	//! Odd, so the median is one of the estimates
+	static const unsigned int NBTRIALS = 67;
+
+	std::shared_ptr<ModelIterator> _iterator;
+	unsigned long long _nbprojections;
+	litlist _atoms; //!< The projected atoms, known after the first model
+
+	// A projection, with its true atoms for evaluating XOR constraints
+	typedef std::unordered_set<Lit> Projection;
+
+	void addXor(const litlist& atoms, bool parity);
+	//! Finds the next projection, returns false if there is none
+	bool next(Projection& projection);
+	/**
+	 * Estimates the number of models after the given projections were already found, with the given random generator.
+	 * Returns a negative number if the trial failed, i.e. the cell became empty before it was small enough.
+	 * Throws if the search is interrupted, so the process fails instead of sending an estimate of a truncated cell.
+	 * NOTE: adds constraints to the solver, so runs in a forked process.
+	 */
+	double trial(std::vector<Projection> cell, const litlist& atoms, std::mt19937& random);
+
+	double countExactly();
+	double countApproximately(unsigned int nbworkers, bool& exact);
+
+public:
+	ModelCounting(AbstractTheory* theory, Structure* structure, Vocabulary* outputvoc);
+
+	/**
+	 * Counts the models, approximately if approximate is true.
+	 * The trials of approximate counting are divided over nbworkers processes.
+	 */
+	CountResult count(bool approximate, unsigned int nbworkers);
+
+	//! The median of the estimates, ignoring failed (negative) ones. Returns a negative number if all failed.
+	static double median(std::vector<double> estimates);
+};
@@ -1,9 +1,13 @@
 #include "ModelIterator.hpp"
+#include "CubeAndConquer.hpp"
 #include "inferences/modelexpansion/DefinitionPostProcessing.hpp"
 #include "inferences/modelexpansion/ModelExpansion.hpp"
 #include "structure/StructureComponents.hpp"
 #include <cstdlib>
 #include <bits/stl_algo.h>
+#ifdef UNIX
+#include <unistd.h>
+#endif
 #include "Weight.hpp"
 #include "utils/UniqueNames.hpp"
 #include "theory/Query.hpp"
@@ -26,9 +30,13 @@ ModelIterator::ModelIterator(Structure* structure, Theory* theory, Vocabulary* t
 	_outputvoc = targetvoc != nullptr ? targetvoc : theory->vocabulary();
 	_tracemonitor = tracemonitor;
 	_assumeFalse = assumeFalse;
+	_nbworkers = 1;
+	_cubes = nullptr;
+	_emptyprojection = false;
 }
 
 ModelIterator::~ModelIterator() {
+	delete (_cubes);
 	_grounding->recursiveDelete();
 	_theory->recursiveDelete();
 	delete (_extender);
@@ -77,6 +85,12 @@ void ModelIterator::init() {
 	_assumptions = new litlist();
 	ground(_theory);
 	prepareSolver();
+	if (_extender == nullptr) {
+		// All models are clones of _structure, so cleaning it once means only the symbols set by the solver are cleaned per model.
+		// NOTE: not done with lazy grounding, as the grounders still refer to the tables of _structure.
+		_structure->trackChanges(true);
+		_structure->clean();
+	}
 }
 
 /**
@@ -113,7 +127,7 @@ void ModelIterator::ground(Theory* theory) {
     auto trans = _grounding->translator();
     for (auto p : _assumeFalse.assumeAllFalse) {
         for (auto atom : trans->getIntroducedLiteralsFor(p)) { // TODO should be introduced ATOMS
-            _assumptions->push_back(-abs(atom.second));
+            _assumptions->push_back(-abs(atom));
         }
         std::vector<Variable*> vars;
         std::vector<Term*> varterms;
@@ -123,7 +137,7 @@ void ModelIterator::ground(Theory* theory) {
             varterms.push_back(new VarTerm(vars.back(), {}));
         }
 
-        PredTable* table = Querying::doSolveQuery(new Query("", vars, new PredForm(SIGN::POS, p, varterms,{}), {}), trans->getConcreteStructure(), trans->getSymbolicStructure());
+        PredTable* table = Querying::doSolveFormula(vars, new PredForm(SIGN::POS, p, varterms,{}), trans->getConcreteStructure(), trans->getSymbolicStructure());
         for (auto i = table->begin(); not i.isAtEnd(); ++i) {
             auto atom = _grounding->translator()->translateNonReduced(p, *i);
             _assumptions->push_back(-abs(atom));
@@ -185,21 +199,7 @@ MXResult ModelIterator::calculate() {
         logActionAndTime("Starting solving at ");
     }
     MXResult result;
-		std::shared_ptr<MinisatID::Model> model = nullptr;
-    try {
-				model = _mx->findNext();
-        result.unsat = (model == nullptr);
-        if (getGlobal()->terminateRequested()) {
-            result._interrupted = true;
-            getGlobal()->reset();
-        }
-    } catch (MinisatID::idpexception& error) {
-        std::stringstream ss;
-        ss << "Solver was aborted with message \"" << error.what() << "\"";
-        throw IdpException(ss.str());
-    } catch (UnsatException& ex) {
-        result.unsat = true;
-		}
+    auto model = findNext(result);
 
     if (getOption(VERBOSE_GROUNDING_STATISTICS) > 0) {
         logActionAndValue("effective-size", _grounding->getSize());
@@ -223,6 +223,280 @@ MXResult ModelIterator::calculate() {
     return result;
 }
 
+std::shared_ptr<MinisatID::Model> ModelIterator::findNext(MXResult& result) {
+    if (_nbworkers > 1) {
+        return findNextInParallel(result);
+    }
+    return solveNext(result);
+}
+
+std::shared_ptr<MinisatID::Model> ModelIterator::solveNext(MXResult& result) {
+    std::shared_ptr<MinisatID::Model> model = nullptr;
+    try {
+        model = _mx->findNext();
+        result.unsat = (model == nullptr);
+        if (getGlobal()->terminateRequested()) {
+            result._interrupted = true;
+            getGlobal()->reset();
+        }
+    } catch (MinisatID::idpexception& error) {
+        std::stringstream ss;
+        ss << "Solver was aborted with message \"" << error.what() << "\"";
+        throw IdpException(ss.str());
+    } catch (UnsatException& ex) {
+        result.unsat = true;
+    }
+    return model;
+}
+
+void ModelIterator::enumerateInParallel(unsigned int nbworkers) {
+#ifndef UNIX
+    Warning::warning("Parallel enumeration is only supported on Unix, enumerating sequentially.");
+    return;
+#endif
+    if (getOption(CPSUPPORT)) {
+        Warning::warning("Parallel enumeration does not support cpsupport, enumerating sequentially.");
+        return;
+    }
+    if (_extender != nullptr) {
+        Warning::warning("Parallel enumeration does not support lazy grounding, enumerating sequentially.");
+        return;
+    }
+#ifdef UNIX
+    // More workers than processors only compete for them
+    auto nbprocessors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nbprocessors > 0 && nbworkers > (unsigned long) nbprocessors) {
+        nbworkers = nbprocessors;
+    }
+#endif
+    _nbworkers = nbworkers;
+}
+
+std::shared_ptr<MinisatID::Model> ModelIterator::findNextInParallel(MXResult& result) {
+    if (_cubes == nullptr) {
+        if (_samples.size() < 16 * (size_t) _nbworkers) {
+            auto model = solveNext(result);
+            if (model != nullptr) {
+                auto trans = translator();
+                litlist sample;
+                for (auto literal : model->literalinterpretations) {
+                    int atomnr = var(literal);
+                    if (trans->isInputAtom(atomnr) && _outputvoc->contains(trans->getSymbol(atomnr))) {
+                        sample.push_back(literal.hasSign() ? -atomnr : atomnr);
+                    }
+                }
+                _samples.push_back(sample);
+            }
+            return model;
+        }
+        if (not startWorkers()) {
+            _nbworkers = 1;
+            return solveNext(result);
+        }
+    }
+    litlist literals;
+    if (not _cubes->next(literals, []() {return getGlobal()->terminateRequested();})) {
+        result.unsat = true;
+        if (getGlobal()->terminateRequested()) {
+            result._interrupted = true;
+            getGlobal()->reset();
+        }
+        return nullptr;
+    }
+    auto model = std::make_shared<MinisatID::Model>();
+    for (auto lit : literals) {
+        model->literalinterpretations.push_back(SolverConnection::createLiteral(lit));
+    }
+    return model;
+}
+
+bool ModelIterator::startWorkers() {
+    std::set<Lit> candidateset;
+    for (const auto& sample : _samples) {
+        for (auto lit : sample) {
+            candidateset.insert(abs(lit));
+        }
+    }
+    litlist candidates(candidateset.cbegin(), candidateset.cend());
+    // Several cubes per worker, as the number of models per cube varies, and at most 2^maxsplitatoms cubes
+    const unsigned int maxsplitatoms = 16;
+    unsigned int nbsplitatoms = 0;
+    while (nbsplitatoms < maxsplitatoms && (1ull << nbsplitatoms) < 4ull * _nbworkers) {
+        ++nbsplitatoms;
+    }
+    auto splitatoms = CubeAndConquer::chooseSplitAtoms(candidates, _samples, nbsplitatoms);
+    if (getMXVerbosity() > 0) {
+        logActionAndValue("split-atoms", splitatoms.size());
+    }
+    if (splitatoms.empty()) { // The output vocabulary is the same in all models so far
+        return false;
+    }
+    _cubes = new CubeAndConquer(CubeAndConquer::makeCubes(splitatoms), _nbworkers, [this](const litlist& cube, const std::function<void(const litlist&)>& found) {
+        enumerateCube(cube, found);
+    });
+    return true;
+}
+
+// NOTE: runs in a worker process
+void ModelIterator::enumerateCube(const litlist& cube, const std::function<void(const litlist&)>& found) {
+    for (auto lit : cube) {
+        addAssumption(lit);
+    }
+    MXResult result;
+    for (auto model = solveNext(result); model != nullptr; model = solveNext(result)) {
+        litlist literals;
+        for (auto literal : model->literalinterpretations) {
+            int atomnr = var(literal);
+            literals.push_back(literal.hasSign() ? -atomnr : atomnr);
+        }
+        found(literals);
+    }
+    for (auto lit : cube) {
+        removeAssumption(lit);
+    }
+}
+
+bool ModelIterator::calculateLiterals(std::vector<Lit>& model) {
+    MXResult result;
+    auto solvermodel = findNext(result);
+    // The solver has already reset the termination request, and an interrupted search must not look like the end of the models
+    if (result._interrupted) {
+        throw IdpException("Solver was terminated");
+    }
+    model.clear();
+    if (result.unsat) {
+        return false;
+    }
+    auto trans = translator();
+    for (auto literal : solvermodel->literalinterpretations) {
+        int atomnr = var(literal);
+        if (trans->isInputAtom(atomnr)) {
+            model.push_back(literal.hasSign() ? -atomnr : atomnr);
+        }
+    }
+    return true;
+}
+
+bool ModelIterator::calculateProjection(std::vector<Lit>& projection) {
+    if (_extender != nullptr) {
+        throw IdpException("Projected model iteration is not supported with lazy grounding.");
+    }
+    projection.clear();
+    if (_emptyprojection) {
+        return false;
+    }
+    MXResult result;
+    auto solvermodel = solveNext(result);
+    if (result._interrupted) { // Otherwise, a count would silently be truncated
+        throw IdpException("Solver was terminated");
+    }
+    if (result.unsat) {
+        return false;
+    }
+    auto trans = translator();
+    for (auto literal : solvermodel->literalinterpretations) {
+        int atomnr = var(literal);
+        if (trans->isInputAtom(atomnr) && _outputvoc->contains(trans->getSymbol(atomnr))) {
+            projection.push_back(literal.hasSign() ? -atomnr : atomnr);
+        }
+    }
+    if (projection.empty()) {
+        _emptyprojection = true;
+        return true;
+    }
+    // The solver only blocks the model itself, which differs from the next ones in atoms outside the projection as well
+    litlist blocking;
+    for (auto lit : projection) {
+        blocking.push_back(-lit);
+    }
+    addClause(blocking);
+    return true;
+}
+
+Structure* handleSolution(Structure const * const structure, const MinisatID::Model& model, AbstractGroundTheory* grounding, StructureExtender* extender,
+		Vocabulary* outputvoc, const std::vector<Definition*>& defs);
+
+bool ModelIterator::calculateDelta(ModelDelta& delta) {
+    MXResult result;
+    auto solvermodel = findNext(result);
+    if (result._interrupted) { // Otherwise, callers could not tell an interrupt from the end of the models
+        throw IdpException("Solver was terminated");
+    }
+    delta.trueatoms.clear();
+    delta.model = result.unsat ? nullptr : solvermodel;
+    if (result.unsat) {
+        return false;
+    }
+    auto trans = translator();
+    auto addTrue = [&](PFSymbol* symbol, const ElementTuple& args) {
+        if (_outputvoc->contains(symbol) && not _structure->inter(symbol)->isTrue(args)) { // Otherwise, it is part of the input
+            delta.trueatoms[symbol].insert(args);
+        }
+    };
+    ElementTuple args;
+    for (auto literal : solvermodel->literalinterpretations) {
+        int atomnr = var(literal);
+        if (not literal.hasSign() && trans->isInputAtom(atomnr)) {
+            trans->getArgs(atomnr, args);
+            addTrue(trans->getSymbol(atomnr), args);
+        }
+    }
+    // Values of function terms handled by the CP solver
+    std::map<VarId, int> values;
+    for (auto cpvar : solvermodel->variableassignments) {
+        if (cpvar.hasValue()) {
+            VarId varid;
+            varid.id = cpvar.getVariable().id;
+            values[varid] = cpvar.getValue();
+        }
+    }
+    for (auto var2value : values) {
+        if (not trans->hasVarIdMapping(var2value.first)) {
+            continue;
+        }
+        ElementTuple tuple;
+        for (const auto& arg : trans->getArgs(var2value.first)) {
+            if (not arg.isVariable) {
+                tuple.push_back(arg._domelement);
+            } else if (contains(values, arg._varid)) {
+                tuple.push_back(createDomElem(values.at(arg._varid)));
+            } else {
+                break; // No value for the nested term, hence the term does not denote
+            }
+        }
+        if (tuple.size() == trans->getArgs(var2value.first).size()) {
+            tuple.push_back(createDomElem(var2value.second));
+            addTrue(trans->getFunction(var2value.first), tuple);
+        }
+    }
+    return true;
+}
+
+Structure* ModelIterator::buildStructure(const ModelDelta& delta) {
+    if (delta.model == nullptr) {
+        throw IdpException("There is no model to build a structure for.");
+    }
+    return handleSolution(_structure, *delta.model, _grounding, _extender, _outputvoc, postprocessdefs);
+}
+
+bool ModelIterator::deltasAreComplete() const {
+    if (_extender != NULL && useLazyGrounding()) {
+        return false;
+    }
+    for (auto def : postprocessdefs) {
+        for (auto symbol : def->defsymbols()) {
+            if (_outputvoc->contains(symbol)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Lit ModelIterator::newAtom() {
+    return translator()->createNewUninterpretedNumber();
+}
+
 std::pair<Atom,bool> getAtomSign(const Lit l){
   Atom a = (l>= 0) ? l : (-1)*l;
   return {a,(l<0)};
@@ -248,9 +522,6 @@ GroundTranslator* ModelIterator::translator() {
 }
 
 
-Structure* handleSolution(Structure const * const structure, const MinisatID::Model& model, AbstractGroundTheory* grounding, StructureExtender* extender,
-		Vocabulary* outputvoc, const std::vector<Definition*>& defs);
-
 MXResult ModelIterator::getStructure(MXResult result, clock_t startTime, std::shared_ptr<MinisatID::Model> model) {
     auto mxverbosity = getMXVerbosity();
     std::vector<Structure*> solutions;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <inferences/grounding/GroundTranslator.hpp>
 #include "common.hpp"
@@ -21,6 +22,17 @@ class PFSymbol;
 class DomainElement;
 typedef std::vector<const DomainElement*> ElementTuple;
 class ModelIterator;
+class CubeAndConquer;
+
+/**
+ * A model as a difference with the input structure: for each symbol of the output vocabulary, the tuples which are true in the model but not in the input structure.
+ * Symbols which are only calculated after search (postprocessed definitions) are not part of the difference.
+ * The full structure is only built when asked for, with ModelIterator::buildStructure.
+ */
+struct ModelDelta {
+	std::map<PFSymbol*, SortedElementTable> trueatoms;
+	std::shared_ptr<MinisatID::Model> model; //!< The model found by the solver, NULL if there is none
+};
 
 std::shared_ptr<ModelIterator> createIterator(AbstractTheory*, Structure*, Vocabulary*,
 		TraceMonitor*, const MXAssumptions& = MXAssumptions());
@@ -32,15 +44,47 @@ public:
 	void init();
 	MXResult calculate();
   MXResult calculateMonitor();
+	// Finds the next model without translating it into a structure: model is set to the literals of all input atoms.
+	// Returns false if there is no next model.
+	bool calculateLiterals(std::vector<Lit>& model);
+	// Finds the next model of which the literals of the input atoms of the output vocabulary (its projection) differ from those of all models found so far,
+	// and blocks that projection. Sets projection to those literals, without building a structure. Returns false if there is no next model.
+	// NOTE: always sequential, and not supported with lazy grounding.
+	bool calculateProjection(std::vector<Lit>& projection);
+	// Finds the next model without building a structure for it. Returns false if there is no next model.
+	bool calculateDelta(ModelDelta& delta);
+	// Builds the structure of a model found by calculateDelta
+	Structure* buildStructure(const ModelDelta& delta);
+	// The structure the deltas of calculateDelta are relative to
+	const Structure* inputStructure() const {
+		return _structure;
+	}
+	// Whether a delta and the input structure together give the model on the output vocabulary,
+	// i.e. no symbol of the output vocabulary is only calculated after search
+	bool deltasAreComplete() const;
+	// Returns an atom which is unknown to the theory, e.g. to enable or disable clauses with assumptions
+	Lit newAtom();
 	void addAssumption(const Lit);
 	void removeAssumption(const Lit);
   void addClause(const std::vector<Lit>& lits);
 	GroundTranslator* translator();
+	/**
+	 * Finds the next models by cube-and-conquer over nbworkers forked workers (see CubeAndConquer).
+	 * The first models are found sequentially; the atoms of the output vocabulary which split them most evenly become the split atoms.
+	 * The order of the models is not deterministic.
+	 * NOTE: call after init; afterwards, no assumptions or clauses can be added.
+	 */
+	void enumerateInParallel(unsigned int nbworkers);
 
 private:
 	std::vector<Definition*> preprocess(Theory*);
 	void ground(Theory*);
 	void prepareSolver();
+	std::shared_ptr<MinisatID::Model> findNext(MXResult& result);
+	std::shared_ptr<MinisatID::Model> solveNext(MXResult& result);
+	std::shared_ptr<MinisatID::Model> findNextInParallel(MXResult& result);
+	bool startWorkers();
+	void enumerateCube(const litlist& cube, const std::function<void(const litlist&)>& found);
 	MXResult getStructure(MXResult, clock_t, std::shared_ptr<MinisatID::Model>);
 
 	Structure* _structure;
@@ -59,4 +103,9 @@ private:
 	litlist* _assumptions;
 
 	MinisatID::ModelIterationTask* _mx;
+
+	unsigned int _nbworkers; //!< 1 for sequential enumeration
+	std::vector<litlist> _samples; //!< The literals of the output vocabulary in the models found before starting the workers
+	CubeAndConquer* _cubes; //!< NULL until the workers are started
+	bool _emptyprojection; //!< Whether a model with an empty projection was found, as it cannot be blocked by a clause
 };
@@ -177,6 +177,7 @@ void computeRemainingDefinitions(const std::vector<Definition*> postprocessdefs,
 			auto f = dynamic_cast<Function*>(s);
 			makeTwoValued(f, structure->inter(f));
 		}
+		structure->notifyChanged(s);
 	}
 
 	// Evaluate it (preferably with XSB)
@@ -195,6 +196,11 @@ void computeRemainingDefinitions(const std::vector<Definition*> postprocessdefs,
 	setOption(POSTPROCESS_DEFS, false);
 	auto result = CalculateDefinitions::doCalculateDefinitions(t, structure);
 	Assert(result._hasModel);
+	for (auto def : evaluatedefs) {
+		for (auto s : def->defsymbols()) {
+			structure->notifyChanged(s);
+		}
+	}
 	t->recursiveDelete();
 	getGlobal()->setOptions(oldoptions);
 }
@@ -119,7 +119,7 @@ litlist MXAssumptions::toLitList(GroundTranslator* trans) const{
 	litlist assumptions;
 	for(auto p: assumeAllFalse){
 		for(auto atom: trans->getIntroducedLiteralsFor(p)){ // TODO should be introduced ATOMS
-			assumptions.push_back(-abs(atom.second));
+			assumptions.push_back(-abs(atom));
 		}
 		std::vector<Variable*> vars;
 		std::vector<Term*> varterms;
@@ -127,7 +127,7 @@ litlist MXAssumptions::toLitList(GroundTranslator* trans) const{
 			vars.push_back(new Variable(p->sorts()[i]));
 			varterms.push_back(new VarTerm(vars.back(), {}));
 		}
-		auto table = Querying::doSolveQuery(new Query("", vars, new PredForm(SIGN::POS, p, varterms, {}), {}), trans->getConcreteStructure(), trans->getSymbolicStructure());
+		auto table = Querying::doSolveFormula(vars, new PredForm(SIGN::POS, p, varterms, {}), trans->getConcreteStructure(), trans->getSymbolicStructure());
 		for(auto i=table->begin(); not i.isAtEnd(); ++i){
 			auto atom = trans->translateNonReduced(p, *i);
 			assumptions.push_back(-abs(atom));
@@ -211,6 +211,7 @@ MXResult ModelExpansion::expand() const {
 
 	MXResult result;
 	try {
+		ProfilePhase phase("solving");
 		mx->execute(); // FIXME wrap other solver calls also in try-catch
 		unsat = mx->getSolutions().size()==0;
 		if(getGlobal()->terminateRequested()){
@@ -276,6 +277,12 @@ MXResult ModelExpansion::expand() const {
 	}
 
 	// Collect solutions
+	if (extender == NULL) {
+		// All solutions are clones of newstructure, so cleaning it once means only the symbols set by the solver are cleaned per model.
+		// NOTE: not done with lazy grounding, as the grounders still refer to the tables of newstructure.
+		newstructure->trackChanges(true);
+		newstructure->clean();
+	}
 	std::vector<Structure*> solutions;
 	if (_minimizeterm != NULL) { // Optimizing
 		if (not unsat) {
@@ -284,7 +291,7 @@ MXResult ModelExpansion::expand() const {
 			for (auto i = list.cbegin(); i < list.cend(); ++i) {
 				solutions.push_back(handleSolution(newstructure, **i, grounding, extender, targetvoc, postprocessdefs));
 			}
-			auto bestvalue = evaluate(_minimizeterm->clone(), solutions.front());
+			auto bestvalue = evaluate(_minimizeterm, solutions.front());
 			Assert(bestvalue!=NULL && bestvalue->type()==DomainElementType::DET_INT);
 			result._optimalvalue = bestvalue->value()._int;
 			if (mxverbosity > 0) {
@@ -330,12 +337,14 @@ Structure* handleSolution(Structure const * const structure, const MinisatID::Mo
 	auto defs = postprocessdefs;
 	if (extender != NULL && useLazyGrounding()) {
 		auto moredefs = extender->extendStructure(newsolution);
+		newsolution->notifyAllChanged();
 		insertAtEnd(defs, moredefs);
 		newsolution->clean();
 	}
 	computeRemainingDefinitions(defs, newsolution, outputvoc);
 	newsolution->changeVocabulary(outputvoc);
 	newsolution->clean();
+	newsolution->trackChanges(false); // The solution is handed to code which does not report its changes
 	Assert(newsolution->isConsistent());
 	return newsolution;
 }
@@ -0,0 +1,142 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum 
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "BoundsCache.hpp"
+#include "Propagator.hpp"
+#include "PropagatorFactory.hpp"
+#include "IncludeComponents.hpp"
+#include "structure/StructureComponents.hpp"
+
+using namespace std;
+
+static const size_t maxentries = 8;
+
+BoundsCache* _boundscacheinstance = NULL;
+
+BoundsCache* BoundsCache::instance() {
+	if (_boundscacheinstance == NULL) {
+		_boundscacheinstance = new BoundsCache();
+		GlobalData::instance()->registerForDeletion(_boundscacheinstance);
+	}
+	return _boundscacheinstance;
+}
+
+BoundsCache::~BoundsCache() {
+	Assert(this == _boundscacheinstance);
+	clear();
+	_boundscacheinstance = NULL;
+}
+
+void BoundsCache::clear() {
+	auto entries = _entries; // Deleting a propagator deletes theories of its own, which looks them up in _entries
+	_entries.clear();
+	for (auto& entry : entries) {
+		delete (entry.propagator);
+	}
+}
+
+void BoundsCache::forgetTheory(unsigned int id) {
+	if (_boundscacheinstance == NULL) {
+		return;
+	}
+	auto& entries = _boundscacheinstance->_entries;
+	for (auto it = entries.begin(); it != entries.end();) {
+		if (it->theory == id) {
+			auto propagator = it->propagator;
+			it = entries.erase(it); // Before deleting the propagator, which deletes theories of its own
+			delete (propagator);
+		} else {
+			++it;
+		}
+	}
+}
+
+void BoundsCache::forgetVocabulary(unsigned int id) {
+	if (_boundscacheinstance == NULL) {
+		return;
+	}
+	auto& entries = _boundscacheinstance->_entries;
+	for (auto it = entries.begin(); it != entries.end();) {
+		if (it->vocabulary == id) {
+			auto propagator = it->propagator;
+			it = entries.erase(it); // Before deleting the propagator, which deletes theories of its own
+			delete (propagator);
+		} else {
+			++it;
+		}
+	}
+}
+
+map<const Sort*, BoundsCache::SortBounds> BoundsCache::sortBounds(const Structure* structure) {
+	map<const Sort*, SortBounds> result;
+	auto voc = structure->vocabulary();
+	for (auto it = voc->firstSort(); it != voc->lastSort(); ++it) {
+		auto sort = it->second;
+		if (not structure->hasInter(sort)) {
+			continue;
+		}
+		auto table = structure->inter(sort);
+		SortBounds bounds { table->approxFinite(), NULL, NULL, -1 };
+		if (bounds.finite && not table->empty()) {
+			bounds.first = table->first();
+			bounds.last = table->last();
+			bounds.size = table->size()._size;
+		}
+		result[sort] = bounds;
+	}
+	return result;
+}
+
+vector<int> BoundsCache::propagationOptions() {
+	return {getOption(IntType::NRPROPSTEPS), getOption(IntType::LONGESTBRANCH), getOption(BoolType::RELATIVEPROPAGATIONSTEPS)};
+}
+
+FOPropagator* BoundsCache::propagator(const AbstractTheory* theory, const Structure* structure, const map<PFSymbol*, InitBoundType>& initbounds,
+		bool propagate) {
+	if (structure->vocabulary() != theory->vocabulary()) { // Checked by creating a propagator as well, but that is skipped when reusing one
+		throw IdpException("Approximation requires that the theory and structure range over the same vocabulary.");
+	}
+	auto sorts = sortBounds(structure);
+	auto options = propagationOptions();
+	for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->theory == theory->id() && it->version == theory->version() && it->vocabulary == theory->vocabulary()->id()
+				&& it->propagated == propagate && it->options == options && it->initbounds == initbounds && it->sorts == sorts) {
+			if (getOption(IntType::VERBOSE_CREATE_PROPAGATORS) > 0) {
+				clog << "Reusing the bounds of an earlier inference on the same theory\n";
+			}
+			_entries.splice(_entries.begin(), _entries, it);
+			return it->propagator;
+		}
+	}
+
+	auto propagator = createPropagator(theory, structure, initbounds);
+	if (propagate) {
+		propagator->doPropagation();
+	}
+	for (auto it = _entries.begin(); it != _entries.end();) { // Entries of earlier versions of the theory can no longer be reused
+		if (it->theory == theory->id() && it->version != theory->version()) {
+			auto stale = it->propagator;
+			it = _entries.erase(it);
+			delete (stale);
+		} else {
+			++it;
+		}
+	}
+	// NOTE: creating the propagator can add sorts (derived from the bounds of existing ones) to the vocabulary,
+	// which are part of the vocabulary the next time
+	_entries.push_front( { theory->vocabulary()->id(), theory->id(), theory->version(), initbounds, sortBounds(structure), propagate, options,
+			propagator });
+	if (_entries.size() > maxentries) {
+		delete (_entries.back().propagator);
+		_entries.pop_back();
+	}
+	return propagator;
+}
@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum 
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef BOUNDSCACHE_HPP_
+#define BOUNDSCACHE_HPP_
+
+#include <list>
+#include <map>
+#include <vector>
+#include "GlobalData.hpp"
+#include "PropagationCommon.hpp"
+
+class AbstractTheory;
+class Structure;
+class Vocabulary;
+class Sort;
+class PFSymbol;
+class DomainElement;
+class FOPropagator;
+
+/**
+ * Keeps the propagators of the most recent bound generations, such that inferences in a row on the same theory
+ * (e.g. propagate, query and model expansion) only build and propagate the symbolic bounds once.
+ *
+ * Bounds are symbolic: they refer to the ct- and cf-tables of the input symbols instead of their contents.
+ * A propagator can therefore be reused for any structure in which
+ * 	- every input symbol has the same kind of initial bound (two-valued, only ct, ...) and
+ * 	- every sort has the same bounds, since those are used to derive the sorts of unnested terms,
+ * when the theory (the same theory object, not changed since), its vocabulary and the propagation options are unchanged as well.
+ * Theories and vocabularies are identified by their id, and their entries are dropped when they are deleted.
+ */
+class BoundsCache: public DeleteMe {
+private:
+	struct SortBounds {
+		bool finite;
+		const DomainElement* first; //!< NULL if the sort is infinite or empty
+		const DomainElement* last; //!< NULL if the sort is infinite or empty
+		long long size;
+		bool operator==(const SortBounds& other) const {
+			return finite == other.finite && first == other.first && last == other.last && size == other.size;
+		}
+	};
+	struct Entry {
+		unsigned int vocabulary; //!< The id of the vocabulary
+		unsigned int theory; //!< The id of the theory
+		unsigned int version; //!< The version of the theory
+		std::map<PFSymbol*, InitBoundType> initbounds;
+		std::map<const Sort*, SortBounds> sorts;
+		bool propagated;
+		std::vector<int> options; //!< The values of the options the propagator depends on
+		FOPropagator* propagator;
+	};
+
+	std::list<Entry> _entries; //!< Most recently used first
+
+	static std::map<const Sort*, SortBounds> sortBounds(const Structure*);
+	static std::vector<int> propagationOptions();
+
+public:
+	static BoundsCache* instance();
+	~BoundsCache();
+
+	// Drop the entries of a theory or vocabulary that is deleted
+	static void forgetTheory(unsigned int id);
+	static void forgetVocabulary(unsigned int id);
+
+	/**
+	 * Returns a propagator for the theory in the structure, which has already propagated if propagate is true.
+	 * Reuses a cached one if possible. The cache keeps ownership of the propagator.
+	 */
+	FOPropagator* propagator(const AbstractTheory* theory, const Structure* structure, const std::map<PFSymbol*, InitBoundType>& initbounds,
+			bool propagate);
+	void clear();
+};
+
+#endif /* BOUNDSCACHE_HPP_ */
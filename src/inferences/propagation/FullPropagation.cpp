@@ -6,9 +6,11 @@
 #include "inferences/grounding/GroundTranslator.hpp"
 #include "inferences/modelIteration/ModelIterator.hpp"
 #include "inferences/SolverConnection.hpp"
+#include "utils/ForkedWorkers.hpp"
 #include "utils/LogAction.hpp"
 
 #include <algorithm>
+#include <unordered_set>
 
 namespace {
 void addToStructure(Lit literal, Structure* struc, GroundTranslator* translator) {
@@ -24,28 +26,117 @@ void addToStructure(Lit literal, Structure* struc, GroundTranslator* translator)
   }
 }
 
-std::set<Lit> getLiteralSet(Structure* struc, GroundTranslator* translator) {
-  std::set<Lit> set;
-  auto symbols = translator->vocabulary()->getNonBuiltinNonOverloadedSymbols();
-  for (auto s : symbols) {
-    auto ct = struc->inter(s)->ct();
-    for (auto el = ct->begin(); !el.isAtEnd(); ++el) {
-      set.insert(translator->translateNonReduced(s, *el));
+// Removes the candidates which do not hold in the given model
+void filterCandidates(std::vector<Lit>& candidates, const std::vector<Lit>& model) {
+  std::unordered_set<Lit> modelLits(model.cbegin(), model.cend());
+  for (unsigned int i = 0; i < candidates.size(); ++i) {
+    if (!modelLits.count(candidates[i])) {
+      candidates[i] = candidates.back();
+      candidates.pop_back();
+      --i;
     }
-    auto cf = struc->inter(s)->cf();
-    for (auto el = cf->begin(); !el.isAtEnd(); ++el) {
-      set.insert((-1) * translator->translateNonReduced(s, *el));
+  }
+}
+
+/**
+ * Computes which of the candidates hold in all models of the solver of miter.
+ * Candidates are probed in chunks: assuming a fresh selector for the clause "not all literals of the chunk" either proves
+ * the whole chunk (unsat), or gives a model which refutes at least one literal of the chunk. Every model found refutes all
+ * candidates it falsifies. The chunk size doubles after a proof and halves after a model.
+ */
+std::vector<Lit> probeBackbone(ModelIterator& miter, std::vector<Lit> candidates, int verbosity) {
+  std::vector<Lit> backbone, model;
+  size_t chunksize = 1;
+  while (!candidates.empty()) {
+    std::vector<Lit> chunk(candidates.end() - std::min(chunksize, candidates.size()), candidates.end());
+    Lit assumption;
+    if (chunk.size() == 1) {
+      assumption = -chunk[0];
+    } else {
+      assumption = miter.newAtom();
+      std::vector<Lit> clause = { -assumption };
+      for (auto l : chunk) {
+        clause.push_back(-l);
+      }
+      miter.addClause(clause);
+    }
+    if (verbosity > 0) {
+      logActionAndValue("Assumption", chunk.size() == 1 ? -chunk[0] : assumption);
+    }
+    miter.addAssumption(assumption);
+    auto sat = miter.calculateLiterals(model);
+    miter.removeAssumption(assumption);
+    if (chunk.size() > 1) {
+      miter.addClause({ -assumption }); // Disables the selector clause
+    }
+    if (sat) {
+      filterCandidates(candidates, model);
+      chunksize = std::max((size_t) 1, chunksize / 2);
+    } else {
+      candidates.resize(candidates.size() - chunk.size());
+      for (auto l : chunk) {
+        backbone.push_back(l);
+        miter.addClause({ l }); // Holds in all models, so can only help the solver
+      }
+      chunksize *= 2;
+    }
+    if (verbosity > 3) {
+      logActionAndValue("Backbone", backbone);
+      logActionAndValue("Candidates", candidates);
     }
   }
-  return set;
+  return backbone;
 }
 
-void intersectLiterals(std::set<Lit>& l, Structure* s, GroundTranslator* translator) {
-  std::set<Lit> structLits = getLiteralSet(s, translator);
-  for(auto ll: structLits){
-    l.erase(-ll);
+#ifdef UNIX
+/**
+ * Divides the candidates over forked processes, each probing its part on its own copy of the solver.
+ * The children send the backbone literals they find over a pipe. The part of a child which fails is probed in this process.
+ */
+std::vector<Lit> forkedProbeBackbone(ModelIterator& miter, const std::vector<Lit>& candidates, unsigned int nbworkers, int verbosity) {
+  std::vector<std::vector<Lit> > parts(nbworkers);
+  for (unsigned int i = 0; i < candidates.size(); ++i) {
+    parts[i % nbworkers].push_back(candidates[i]);
+  }
+  ForkedWorkers workers;
+  std::vector<int> workerofpart(nbworkers);
+  for (unsigned int w = 0; w < nbworkers; ++w) {
+    workerofpart[w] = workers.start([&miter, &parts, w, verbosity](int pipe) {
+      auto backbone = probeBackbone(miter, parts[w], verbosity);
+      return backbone.empty() || ForkedWorkers::writeAll(pipe, &backbone[0], backbone.size() * sizeof(Lit));
+    });
+  }
+
+  std::vector<Lit> backbone;
+  std::vector<Lit> unprobed;
+  for (unsigned int w = 0; w < nbworkers; ++w) {
+    auto worker = workerofpart[w];
+    bool ok = worker != -1;
+    std::vector<Lit> result;
+    if (ok) {
+      Lit l;
+      size_t n;
+      while ((n = ForkedWorkers::readAll(workers.pipe(worker), &l, sizeof(Lit))) == sizeof(Lit)) {
+        result.push_back(l);
+      }
+      ok = workers.finish(worker) && n == 0;
+    }
+    if (ok) {
+      backbone.insert(backbone.end(), result.cbegin(), result.cend());
+    } else {
+      unprobed.insert(unprobed.end(), parts[w].cbegin(), parts[w].cend());
+    }
+  }
+  if (!unprobed.empty()) {
+    if (verbosity > 0) {
+      logActionAndValue("Probing literals of failed workers", unprobed.size());
+    }
+    auto result = probeBackbone(miter, unprobed, verbosity);
+    backbone.insert(backbone.end(), result.cbegin(), result.cend());
   }
+  return backbone;
 }
+#endif
 
 }
 
@@ -63,40 +154,32 @@ std::vector<Structure*> FullPropagation::propagateNoAssumps(AbstractTheory* theo
   MXAssumptions mxas; // TODO: superfluous...
   auto miter = ModelIterator(structure, realtheo, nullptr, nullptr, mxas);
   miter.init();
-  //Tuple2AtomMap literals = miter.getLiterals();
   GroundTranslator* translator = miter.translator();
-  MXResult model = miter.calculate();
-  MAssert(!model.unsat && !model._models.empty());
-
-  std::set<Lit> firstmodel = getLiteralSet(model._models[0], translator);
-  std::vector<Lit> intersectionnegation;
-  for(auto ll: firstmodel){
-    intersectionnegation.push_back(-ll);
-  }
-
-  while (!model.unsat) {
-    std::set<Lit> structLits =getLiteralSet(model._models[0], translator);
-    for(unsigned int i=0; i<intersectionnegation.size(); ++i){
-      if(!structLits.count(-intersectionnegation[i])){
-        intersectionnegation[i]=intersectionnegation.back();
-        intersectionnegation.pop_back();
-        --i;
-      }
+  std::vector<Lit> model;
+  auto sat = miter.calculateLiterals(model);
+  MAssert(sat);
+
+  std::vector<Lit> intersection = model;
+  while (sat) {
+    filterCandidates(intersection, model);
+    std::vector<Lit> intersectionnegation;
+    for (auto l : intersection) {
+      intersectionnegation.push_back(-l);
     }
     if (verbosity > 1) {
       logActionAndValue("Models invalidating clause: ", intersectionnegation);
     }
-    
+
     miter.addClause(intersectionnegation);
-    model = miter.calculate();
+    sat = miter.calculateLiterals(model);
   }
 
   setOption(CPSUPPORT, storedcp);
 
   Structure* safe = structure->clone();
   //Translate the result
-  for (auto l: intersectionnegation) {
-    addToStructure(-l, safe, translator);
+  for (auto l: intersection) {
+    addToStructure(l, safe, translator);
   }
   safe->clean();
   MAssert(safe->isConsistent());
@@ -114,65 +197,43 @@ std::vector<Structure*> FullPropagation::propagate(AbstractTheory* theory, Struc
     setOption(CPSUPPORT, false);
     setOption(POSTPROCESS_DEFS, false);
 
-    Structure* safe = structure->clone();
-
     MXAssumptions mxas;
     auto realtheo = static_cast<Theory*> (theory);
     auto miter = ModelIterator(structure, realtheo, nullptr, nullptr, mxas);
     miter.init();
-    //Tuple2AtomMap literals = miter.getLiterals();
     GroundTranslator* translator = miter.translator();
-    MXResult model = miter.calculate();
-    if (model.unsat || model._models.empty()) {
+
+    // The literals of the first model are the candidates for the backbone
+    std::vector<Lit> candidates;
+    if (!miter.calculateLiterals(candidates)) {
+      setOption(CPSUPPORT, storedcp);
       return std::vector<Structure*>{};
     }
-
-    std::set<Lit> underapproximation = getLiteralSet(safe, translator);
     if (verbosity > 0) {
-      logActionAndValue("UnderApproximation", underapproximation);
+      logActionAndValue("Candidates", candidates);
     }
 
-    Structure* currModel = model._models[0];
-    std::set<Lit> overapproximation = getLiteralSet(currModel, translator);
-    if (verbosity > 0) {
-      logActionAndValue("OverApproximation", overapproximation);
-    }
-
-    for (auto it = underapproximation.cbegin(); it != underapproximation.cend(); ++it) {
-      overapproximation.erase(*it);
+    std::vector<Lit> backbone;
+#ifdef UNIX
+    auto nbworkers = getOption(IntType::BACKBONEWORKERS);
+    if (nbworkers > 1 && candidates.size() > (size_t) nbworkers) {
+      backbone = forkedProbeBackbone(miter, candidates, nbworkers, verbosity);
+    } else {
+      backbone = probeBackbone(miter, candidates, verbosity);
     }
+#else
+    backbone = probeBackbone(miter, candidates, verbosity);
+#endif
     if (verbosity > 0) {
-      logActionAndValue("Over \\ Under", overapproximation);
-    }
-
-    while (!overapproximation.empty()) {
-      Lit a = *overapproximation.begin();
-      if (verbosity > 0) {
-        logActionAndValue("Assumption", -a);
-      }
-      miter.addAssumption(-a);
-      MXResult m = miter.calculate();
-      if (m.unsat) {
-        underapproximation.insert(a);
-        overapproximation.erase(a);
-        miter.removeAssumption(-a);
-      } else {
-        currModel = m._models[0];
-        intersectLiterals(overapproximation, currModel, translator);
-        miter.removeAssumption(-a);
-      }
-
-      if (verbosity > 3) {
-        logActionAndValue("UnderApproximation", overapproximation);
-        logActionAndValue("OverApproximation", overapproximation);
-      }
+      logActionAndValue("Backbone", backbone);
     }
 
     setOption(CPSUPPORT, storedcp);
 
     //Translate the result
-    for (auto literal = underapproximation.cbegin(); literal != underapproximation.cend(); ++literal) {
-      addToStructure(*literal, safe, translator);
+    Structure* safe = structure->clone();
+    for (auto literal : backbone) {
+      addToStructure(literal, safe, translator);
     }
     safe->clean();
 
@@ -180,4 +241,4 @@ std::vector<Structure*> FullPropagation::propagate(AbstractTheory* theory, Struc
       return std::vector<Structure*>{};
     }
     return {safe};
-  }
\ No newline at end of file
+  }
@@ -15,6 +15,7 @@
 #include "fobdds/FoBddManager.hpp"
 #include "fobdds/FoBddFactory.hpp"
 #include "fobdds/FoBddVariable.hpp"
+#include "fobdds/FoBddQuantKernel.hpp"
 #include "structure/StructureComponents.hpp"
 using namespace std;
 
@@ -149,6 +150,31 @@ bool FOPropBDDDomainFactory::approxequals(FOPropBDDDomain* domain1, FOPropBDDDom
 	return domain1->bdd() == domain2->bdd();
 }
 
+long long FOPropBDDDomainFactory::cost(FOPropBDDDomain* domain) const {
+	auto cached = _costs.find(domain->bdd());
+	if (cached != _costs.cend()) {
+		return cached->second;
+	}
+	long long nodes = 0;
+	std::set<const FOBDD*> seen;
+	std::vector<const FOBDD*> todo = { domain->bdd() };
+	while (not todo.empty()) {
+		auto bdd = todo.back();
+		todo.pop_back();
+		if (_manager->isTruebdd(bdd) || _manager->isFalsebdd(bdd) || not seen.insert(bdd).second) {
+			continue;
+		}
+		++nodes;
+		if (isa<FOBDDQuantKernel>(*bdd->kernel())) {
+			todo.push_back(dynamic_cast<const FOBDDQuantKernel*>(bdd->kernel())->bdd());
+		}
+		todo.push_back(bdd->truebranch());
+		todo.push_back(bdd->falsebranch());
+	}
+	_costs[domain->bdd()] = nodes;
+	return nodes;
+}
+
 bool FOPropTableDomainFactory::approxequals(FOPropTableDomain* left, FOPropTableDomain* right) const {
 	return left->table() == right->table();
 }
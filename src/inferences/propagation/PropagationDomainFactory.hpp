@@ -51,6 +51,10 @@ public:
 	virtual bool approxequals(PropagatorDomain*, PropagatorDomain*) const = 0; //!< Checks if two domains are equal
 	virtual PredInter* inter(const std::vector<Variable*>&, const ThreeValuedDomain<PropagatorDomain>&, Structure*) const = 0;
 	virtual std::ostream& put(std::ostream&, PropagatorDomain*) const = 0;
+	//! Estimated cost of propagating the domain, used to schedule cheap propagations first
+	virtual long long cost(PropagatorDomain*) const {
+		return 0;
+	}
 
 	// Checks whether domain is a possible domain for formula
 	virtual bool isValidAsDomainFor(const PropagatorDomain* domain, const Formula* formula) const = 0;
@@ -59,6 +63,7 @@ public:
 class FOPropBDDDomainFactory: public FOPropDomainFactory<FOPropBDDDomain> {
 private:
 	std::shared_ptr<FOBDDManager> _manager;
+	mutable std::map<const FOBDD*, long long> _costs; //!< The cost of the bdds for which it was asked, bdds are unique within the manager
 public:
 	FOPropBDDDomainFactory();
 	~FOPropBDDDomainFactory();
@@ -80,6 +85,7 @@ public:
 	//Returns the interpretation of a threevalueddomain in a given structure.
 	PredInter* inter(const std::vector<Variable*>&, const ThreeValuedDomain<FOPropBDDDomain>&, Structure*) const;
 	std::ostream& put(std::ostream&, FOPropBDDDomain*) const;
+	long long cost(FOPropBDDDomain*) const; //!< The number of nodes of the bdd, calculated once per bdd
 
 	// Valid iff the free variables of the domain are a subset of the free variables of the formula
 	virtual bool isValidAsDomainFor(const FOPropBDDDomain*, const Formula*) const;
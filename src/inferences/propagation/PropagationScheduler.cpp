@@ -11,9 +11,36 @@
 
 #include "PropagationScheduler.hpp"
 
-void FOPropScheduler::add(FOPropagation* propagation) {
-	// TODO: don't schedule a propagation that is already on the queue
-	_queue.push(propagation);
+FOPropScheduler::FOPropScheduler()
+		: 	_nrscheduled(0),
+			_nrmerged(0) {
+}
+
+FOPropScheduler::~FOPropScheduler() {
+	while (hasNext()) {
+		delete (next());
+	}
+}
+
+FOPropScheduler::PropagationKey FOPropScheduler::key(const FOPropagation* propagation) {
+	return PropagationKey(propagation->getParent(), propagation->getDirection(), propagation->isCT(), propagation->getChild());
+}
+
+bool FOPropScheduler::add(FOPropagation* propagation, long long cost) {
+	auto it = _scheduled.find(key(propagation));
+	if (it != _scheduled.cend()) {
+		++_nrmerged;
+		delete (propagation);
+		if (it->second->cost != cost) { // Reschedule with the cost of the latest domains
+			auto scheduled = *it->second;
+			scheduled.cost = cost;
+			_queue.erase(it->second);
+			it->second = _queue.insert(scheduled).first;
+		}
+		return false;
+	}
+	_scheduled[key(propagation)] = _queue.insert( { cost, _nrscheduled++, propagation }).first;
+	return true;
 }
 
 bool FOPropScheduler::hasNext() const {
@@ -21,8 +48,8 @@ bool FOPropScheduler::hasNext() const {
 }
 
 FOPropagation* FOPropScheduler::next() {
-	FOPropagation* propagation = _queue.front();
-	_queue.pop();
+	auto propagation = _queue.cbegin()->propagation;
+	_queue.erase(_queue.cbegin());
+	_scheduled.erase(key(propagation));
 	return propagation;
 }
-
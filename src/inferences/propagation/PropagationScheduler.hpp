@@ -12,7 +12,9 @@
 #ifndef PROPAGATESCHED_HPP
 #define PROPAGATESCHED_HPP
 
-#include <queue>
+#include <map>
+#include <set>
+#include <tuple>
 #include "PropagationCommon.hpp"
 
 class FOPropagation;
@@ -21,16 +23,48 @@ class Formula;
 
 
 /**
- * 	Class for scheduling propagation steps.	
+ * 	Class for scheduling propagation steps.
+ * 	Propagations are processed cheapest first: every propagation gets a cost when it is scheduled
+ * 	(the size of the domain it propagates), ties are broken in the order in which they were scheduled.
+ * 	A propagation that is already on the queue is not scheduled again, since it is only executed later
+ * 	and will then take the latest domains into account anyway. It does get the new cost, but keeps its place among equally expensive ones.
  */
 class FOPropScheduler {
 private:
-	std::queue<FOPropagation*> _queue; //!< The queue of scheduled propagations
+	struct ScheduledPropagation {
+		long long cost;
+		long long order;
+		FOPropagation* propagation;
+		bool operator<(const ScheduledPropagation& other) const {
+			return cost < other.cost || (cost == other.cost && order < other.order);
+		}
+	};
+	typedef std::set<ScheduledPropagation> Queue;
+	typedef std::tuple<const Formula*, FOPropDirection, bool, const Formula*> PropagationKey;
+
+	Queue _queue; //!< The scheduled propagations, cheapest first
+	std::map<PropagationKey, Queue::iterator> _scheduled; //!< The propagations on the queue
+	long long _nrscheduled; //!< Number of propagations ever added to the queue
+	long long _nrmerged; //!< Number of propagations that were not added because they were already on the queue
+
+	static PropagationKey key(const FOPropagation*);
 public:
-	void add(FOPropagation*); //!< Push a propagation on the queue
-	FOPropagation* next(); //!< Pop the first propagation from the queue and return it
+	FOPropScheduler();
+	~FOPropScheduler();
+
+	//! Push a propagation with the given cost on the queue.
+	//! Returns false (and deletes the propagation) if it was already on the queue, in which case the scheduled one gets the given cost.
+	bool add(FOPropagation*, long long cost = 0);
+	FOPropagation* next(); //!< Pop the cheapest propagation from the queue and return it
 
 	bool hasNext() const; //!< True iff the queue is non-empty
+
+	long long nbScheduled() const {
+		return _nrscheduled;
+	}
+	long long nbMerged() const {
+		return _nrmerged;
+	}
 };
 
 /**
@@ -10,6 +10,7 @@
  ****************************************************************************/
 
 #include "Propagator.hpp"
+#include <algorithm>
 #include "PropagationDomainFactory.hpp"
 #include "PropagationScheduler.hpp"
 #include "IncludeComponents.hpp"
@@ -84,12 +85,31 @@ void TypedFOPropagator<Factory, DomainType>::doPropagation() {
 			}
 			clog << "\n";
 		}
+		++_statistics[parent].nrsteps;
 		parent->accept(this);
 		delete (propagation);
 	}
 	if (getOption(IntType::VERBOSE_PROPAGATING) > 1) {
 		clog << "=== End propagation ===\n";
 	}
+	if (getOption(IntType::VERBOSE_PROPAGATING) > 0) {
+		printStatistics();
+	}
+}
+
+template<class Factory, class DomainType>
+void TypedFOPropagator<Factory, DomainType>::printStatistics() const {
+	clog << "Propagation scheduled " << _scheduler->nbScheduled() << " steps, merged " << _scheduler->nbMerged()
+			<< " steps with one that was already scheduled\n";
+	vector<pair<const Formula*, FOPropStatistics> > formulas(_statistics.cbegin(), _statistics.cend());
+	std::sort(formulas.begin(), formulas.end(), [](const pair<const Formula*, FOPropStatistics>& a, const pair<const Formula*, FOPropStatistics>& b) {
+		return a.second.nrsteps > b.second.nrsteps;
+	});
+	// Only the most expensive formulas, unless more verbosity is asked
+	size_t max = getOption(IntType::VERBOSE_PROPAGATING) > 1 ? formulas.size() : 10;
+	for (size_t i = 0; i < formulas.size() && i < max; ++i) {
+		clog << "  " << formulas[i].second.nrsteps << " steps, " << formulas[i].second.nrchanges << " changes for " << print(formulas[i].first) << "\n";
+	}
 }
 
 template<class Factory, class Domain>
@@ -285,8 +305,17 @@ void TypedFOPropagator<Factory, Domain>::schedule(const Formula* p, FOPropDirect
 	if (getMaxSteps() <= 0) {
 		return;
 	}
+	// The cost of a propagation is the size of the domain(s) it propagates
+	long long cost = 0;
+	if (dir == DOWN && hasDomain(p)) {
+		cost = _factory->cost(ct ? getDomain(p)._ctdomain : getDomain(p)._cfdomain);
+	} else if (dir == UP && c != NULL && hasDomain(c)) {
+		cost = _factory->cost(getDomain(c)._ctdomain) + _factory->cost(getDomain(c)._cfdomain);
+	}
+	if (not _scheduler->add(new FOPropagation(p, dir, ct, c), cost)) {
+		return; // Already on the queue
+	}
 	_maxsteps--;
-	_scheduler->add(new FOPropagation(p, dir, ct, c));
 	if (getOption(IntType::VERBOSE_PROPAGATING) > 1) {
 		clog << "  Schedule ";
 		if (dir == DOWN) {
@@ -344,6 +373,7 @@ void TypedFOPropagator<Factory, Domain>::updateDomain(const Formula* f, FOPropDi
 		return;
 	}
 	ct ? setCTOfDomain(f, newdom) : setCFOfDomain(f, newdom);
+	++_statistics[f].nrchanges;
 	switch (dir) {
 	case DOWN: {
 		for (auto subf : f->subformulas()) {
@@ -43,6 +43,17 @@ public:
 };
 
 
+/**
+ * Number of propagations applied to a formula and number of times one of its domains was changed by them
+ */
+struct FOPropStatistics {
+	long long nrsteps;
+	long long nrchanges;
+	FOPropStatistics()
+			: nrsteps(0), nrchanges(0) {
+	}
+};
+
 template<class InterpretationFactory, class Domain>
 class TypedFOPropagator: public FOPropagator {
 	VISITORFRIENDS()
@@ -61,6 +72,7 @@ private:
 	std::map<const Formula*, const Formula*> _upward; //!<mapping from a formula to it's parent
 	std::map<const PredForm*, std::set<const PredForm*> > _leafupward;
 	std::vector<AdmissibleBoundChecker<Domain>*> _admissiblecheckers;
+	std::map<const Formula*, FOPropStatistics> _statistics; //!< Map each formula to its propagation statistics
 	AbstractTheory* _theory;
 
 	// Variables to temporarily store a propagation
@@ -78,6 +90,7 @@ private:
 	void updateDomain(const Formula* tobeupdated, FOPropDirection, bool ct, Domain* newdomain, const Formula* child = 0);
 	bool admissible(Domain*, Domain*) const; //!< Returns true iff the first domain is an allowed
 											 //!< replacement of the second domain
+	void printStatistics() const;
 
 protected:
 	void visit(const PredForm*);
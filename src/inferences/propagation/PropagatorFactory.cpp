@@ -18,6 +18,7 @@
 #include "fobdds/FoBddManager.hpp"
 #include "fobdds/FoBddVariable.hpp"
 #include "GenerateBDDAccordingToBounds.hpp"
+#include "BoundsCache.hpp"
 
 using namespace std;
 
@@ -34,6 +35,9 @@ std::shared_ptr<GenerateBDDAccordingToBounds> generateNonLiftedBounds(AbstractTh
 	Assert(theory != NULL);
 	Assert(structure != NULL);
 	auto mpi = propagateVocabulary(theory, structure);
+	if (getOption(BoolType::BOUNDSCACHE)) {
+		return BoundsCache::instance()->propagator(theory, structure, mpi, false)->symbolicstructure(theory->vocabulary());
+	}
 	auto propagator = createPropagator(theory, structure, mpi);
 	auto result = propagator->symbolicstructure(theory->vocabulary());
 	delete (propagator);
@@ -45,9 +49,17 @@ shared_ptr<GenerateBDDAccordingToBounds> generateBounds(AbstractTheory* theory,
 	Assert(theory != NULL);
 	Assert(structure != NULL);
 	auto mpi = propagateVocabulary(theory, structure);
-	auto propagator = createPropagator(theory, structure, mpi);
+	auto cached = getOption(BoolType::BOUNDSCACHE);
+	FOPropagator* propagator = NULL;
+	if (cached) {
+		propagator = BoundsCache::instance()->propagator(theory, structure, mpi, doSymbolicPropagation);
+	} else {
+		propagator = createPropagator(theory, structure, mpi);
+		if (doSymbolicPropagation) {
+			propagator->doPropagation();
+		}
+	}
 	if (doSymbolicPropagation) { // Strange, this should be called LUP
-		propagator->doPropagation();
 	if (LUP) {
 			if (getOption(IntType::VERBOSE_GROUNDING) >= 1) {
 				clog <<"Applying propagation to structure\n";
@@ -77,7 +89,9 @@ shared_ptr<GenerateBDDAccordingToBounds> generateBounds(AbstractTheory* theory,
 		symbolsThatShouldNotBeReplacedByBDDs = theory->vocabulary();
 	}
 	auto result = propagator->symbolicstructure(symbolsThatShouldNotBeReplacedByBDDs);
-	delete (propagator);
+	if (not cached) {
+		delete (propagator);
+	}
 	return result;
 }
 
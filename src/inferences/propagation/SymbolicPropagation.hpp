@@ -14,6 +14,7 @@
 #include "IncludeComponents.hpp"
 #include "PropagatorFactory.hpp"
 #include "Propagator.hpp"
+#include "BoundsCache.hpp"
 
 #include "groundtheories/AbstractGroundTheory.hpp"
 #include "inferences/grounding/grounders/Grounder.hpp"
@@ -29,6 +30,11 @@ public:
 	std::vector<Structure*> propagate(AbstractTheory* theory, Structure* structure) {
 		auto result = structure->clone();
 		auto mpi = propagateVocabulary(theory, result);
+		if (getOption(BoolType::BOUNDSCACHE)) {
+			auto propagator = BoundsCache::instance()->propagator(theory, structure, mpi, true);
+			propagator->applyPropagationToStructure(result, *result->vocabulary());
+			return {result};
+		}
 		auto propagator = createPropagator(theory, structure, mpi);
 		propagator->doPropagation();
 		propagator->applyPropagationToStructure(result, *result->vocabulary());
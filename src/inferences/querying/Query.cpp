@@ -43,17 +43,20 @@ PredTable* Querying::solveQuery(Query* q, Structure const * const structure, std
 	if(not VocabularyUtils::isSubVocabulary(q->vocabulary(), structure->vocabulary())){
 		throw IdpException("The structure of the query does not interpret all symbols in the query.");
 	}
+	return solveFormula(q->variables(), q->query()->clone(), structure, symbolicstructure);
+}
+
+PredTable* Querying::solveFormula(const std::vector<Variable*>& vars, Formula* newquery, Structure const * const structure, std::shared_ptr<GenerateBDDAccordingToBounds> symbolicstructure) const {
 	// translate the formula to a bdd
 	std::shared_ptr<FOBDDManager> manager;
 	const FOBDD* bdd = NULL;
-	auto newquery = q->query()->clone();
-	newquery = FormulaUtils::simplify(newquery,structure);
 	auto alltwoval = true;
-	for(auto s: FormulaUtils::collectSymbols(q->query())){
+	for(auto s: FormulaUtils::collectSymbols(newquery)){
 		if(not structure->inter(s)->approxTwoValued()){
 			alltwoval = false;
 		}
 	}
+	newquery = FormulaUtils::simplify(newquery,structure);
 	if(not alltwoval){
 		// Note: first graph, because generateBounds is currently incorrect in case of three-valued function terms.
 		newquery = FormulaUtils::graphFuncsAndAggs(newquery,structure,{}, true,false);
@@ -67,7 +70,7 @@ PredTable* Querying::solveQuery(Query* q, Structure const * const structure, std
 	}
 	newquery->recursiveDelete();
 
-	return solveBdd(q->variables(), manager, bdd, structure);
+	return solveBdd(vars, manager, bdd, structure);
 }
 
 PredTable* Querying::solveBdd(const std::vector<Variable*>& vars, std::shared_ptr<FOBDDManager> manager, const FOBDD* bdd, Structure const * const structure) const {
@@ -221,8 +224,7 @@ bool evaluate(TheoryComponent* comp, const Structure* structure){
 		}
 	}
 	auto def = dynamic_cast<Definition*>(comp);
-	if(def!=NULL){
-		def = def->clone();
+	if(def!=NULL){ // NOTE: doCalculateDefinition works on its own copy of the definition
 		auto newstruct = structure->clone();
 		auto split = getOption(SPLIT_DEFS);
 		auto xsb = getOption(XSB);
@@ -231,7 +233,6 @@ bool evaluate(TheoryComponent* comp, const Structure* structure){
 		auto success = CalculateDefinitions::doCalculateDefinition(def, newstruct)._hasModel;
 		setOption(SPLIT_DEFS, split);
 		setOption(XSB, xsb);
-		def->recursiveDelete();
 		delete(newstruct);
 		return success;
 	}
@@ -251,9 +252,8 @@ const DomainElement* evaluate(Term* term, const Structure* structure){
 	auto var = Gen::var(term->sort());
 	auto& pf = Gen::operator ==(*term->clone(), *new VarTerm(var,{}));
 
-	Query q("Eval", {var}, &pf, {});
-	auto result = Querying::doSolveQuery(&q, structure);
-	pf.recursiveDelete();
+	std::shared_ptr<GenerateBDDAccordingToBounds> symbolicstructure; // The term is two-valued, so no bounds are needed
+	auto result = Querying::doSolveFormula({var}, &pf, structure, symbolicstructure);
 	if(result->empty()){
 		return NULL; // partial
 	}else{
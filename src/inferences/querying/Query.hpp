@@ -36,6 +36,14 @@ public:
 		Querying c;
 		return c.solveQuery(q, s, symbolicstructure);
 	}
+	/**
+	 * Solves the query given by the free variables vars of the formula, without copying the formula first.
+	 * The formula is transformed in place and deleted, so only pass formulas that are owned by the caller and not used afterwards.
+	 */
+	static PredTable* doSolveFormula(const std::vector<Variable*>& vars, Formula* formula, Structure const * const s, std::shared_ptr<GenerateBDDAccordingToBounds> symbolicstructure) {
+		Querying c;
+		return c.solveFormula(vars, formula, s, symbolicstructure);
+	}
 	static PredTable* doSolveBDDQuery(const FOBDD* b, Structure const * const s) {
 		Querying c;
 		return c.solveBDDQuery(b, s);
@@ -45,6 +53,7 @@ public:
 private:
 	PredTable* solveQuery(Query* q, Structure const * const s) const;
 	PredTable* solveQuery(Query* q, Structure const * const s, std::shared_ptr<GenerateBDDAccordingToBounds> symbolicstructure) const;
+	PredTable* solveFormula(const std::vector<Variable*>& vars, Formula* formula, Structure const * const s, std::shared_ptr<GenerateBDDAccordingToBounds> symbolicstructure) const;
 	PredTable* solveBdd(const std::vector<Variable*>& vars, std::shared_ptr<FOBDDManager> manager, const FOBDD* bdd, Structure const * const structure) const;
 	PredTable* solveBDDQuery(const FOBDD* b, Structure const * const s) const;
 };
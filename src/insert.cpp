@@ -251,10 +251,9 @@ std::set<Function*> Insert::noArFuncInScope(const vector<string>& vs, const Pars
 
 Function* Insert::funcInScope(const string& name, int arity) const {
 	std::set<Function*> vf;
-	stringstream ss;
-	ss <<name <<"/" <<arity;
+	auto nameandarity = name + "/" + convertToString(arity);
 	for (size_t n = 0; n < _usingvocab.size(); ++n) {
-		auto f = _usingvocab[n]->func(ss.str());
+		auto f = _usingvocab[n]->func(nameandarity);
 		if (f!=NULL) {
 			vf.insert(f);
 		}
@@ -266,6 +265,20 @@ Function* Insert::funcInScope(const string& name, int arity) const {
 	}
 }
 
+Function* Insert::constantInScope(const string& name) const {
+	if (_constantcachechanges != Vocabulary::nbChanges()) {
+		_constantcache.clear();
+		_constantcachechanges = Vocabulary::nbChanges();
+	}
+	auto it = _constantcache.find(name);
+	if (it != _constantcache.cend()) {
+		return it->second;
+	}
+	auto f = funcInScope(name, 0);
+	_constantcache[name] = f;
+	return f;
+}
+
 Function* Insert::funcInScope(const vector<string>& vs, int arity, const ParseInfo& pi) const {
 	Assert(not vs.empty());
 	if (vs.size() == 1) {
@@ -286,10 +299,9 @@ Function* Insert::funcInScope(const vector<string>& vs, int arity, const ParseIn
 
 Predicate* Insert::predInScope(const string& name, int arity) const {
 	std::set<Predicate*> vp;
-	stringstream ss;
-	ss <<name <<"/" <<arity;
+	auto nameandarity = name + "/" + convertToString(arity);
 	for (size_t n = 0; n < _usingvocab.size(); ++n) {
-		auto p = _usingvocab[n]->pred(ss.str());
+		auto p = _usingvocab[n]->pred(nameandarity);
 		if (p!=NULL) {
 			vp.insert(p);
 		}
@@ -551,7 +563,8 @@ UserProcedure* Insert::procedureInScope(const vector<string>& vs, const ParseInf
 }
 
 Insert::Insert(Namespace * ns)
-		: parsingType(NULL) {
+		: 	parsingType(NULL),
+			_constantcachechanges(0) {
 	Assert(ns!=NULL);
 	openblock();
 	_currfile = 0;
@@ -671,6 +684,7 @@ void Insert::usevocabulary(Vocabulary* v) {
 	if (not found) {
 		++_nrvocabs.back();
 		_usingvocab.push_back(v);
+		_constantcache.clear();
 	}
 }
 
@@ -703,6 +717,9 @@ void Insert::closeblock() {
 	for (unsigned int n = 0; n < _nrvocabs.back(); ++n) {
 		_usingvocab.pop_back();
 	}
+	if (_nrvocabs.back() > 0) {
+		_constantcache.clear();
+	}
 	for (unsigned int n = 0; n < _nrspaces.back(); ++n) {
 		_usingspace.pop_back();
 	}
@@ -2218,7 +2235,7 @@ const DomainElement* Insert::element(char c) const {
 
 const DomainElement* Insert::element(const std::string& s) const {
 	// The parser cannot parse strings without "()" at the end as constructor function images, so this warning should be issued:
-	auto f = funcInScope(s,0);
+	auto f = constantInScope(s);
 	if (f != NULL && (f->isConstructorFunction() || f->overloaded())) {
 		Warning::constructorDisambiguationInStructure(s);
 		if (f->overloaded()) {
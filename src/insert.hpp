@@ -15,6 +15,7 @@
 #include <set>
 #include <vector>
 #include <list>
+#include <unordered_map>
 #include <sstream>
 #include "commontypes.hpp"
 #include "parseinfo.hpp"
@@ -158,6 +159,8 @@ private:
 	std::list<VarName> _curr_vars;
 
 	std::vector<Vocabulary*> _usingvocab; //!< the vocabularies currently used to parse
+	mutable std::unordered_map<std::string, Function*> _constantcache; //!< Results of constantInScope for the vocabularies currently used
+	mutable unsigned int _constantcachechanges; //!< Vocabulary::nbChanges() when the cache was filled
 	std::vector<Namespace*> _usingspace; //!< the namespaces currently used to parse
 
 	std::vector<unsigned int> _nrvocabs; //!< the number of 'using vocabulary' statements in the current block
@@ -189,6 +192,7 @@ private:
 	Predicate* predInScope(const longname&, int arity, const ParseInfo&) const;
 	Function* funcInScope(const std::string&, int arity) const;
 	Function* funcInScope(const longname&, int arity, const ParseInfo&) const;
+	Function* constantInScope(const std::string&) const; //!< funcInScope(name, 0), cached for the literals of structures
 	std::set<Predicate*> noArPredInScope(const std::string& name) const;
 	std::set<Predicate*> noArPredInScope(const longname& name, const ParseInfo&) const;
 	std::set<Function*> noArFuncInScope(const std::string& name) const;
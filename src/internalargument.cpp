@@ -99,6 +99,16 @@ TableIterator* InternalArgument::get<TableIterator*>() {
 	return _value._tableiterator;
 }
 
+template<>
+TableView* InternalArgument::get<TableView*>() {
+	return _value._tableview;
+}
+
+template<>
+FuncInter* InternalArgument::get<FuncInter*>() {
+	return _value._funcinter;
+}
+
 template<>
 Options* InternalArgument::get<Options*>() {
 	return options();
@@ -47,6 +47,7 @@ class TableIterator;
 class SortIterator;
 class FOBDD;
 class WrapModelIterator;
+class TableView;
 
 /**
  * Types of arguments given to, or results produced by internal procedures
@@ -103,7 +104,10 @@ enum ArgType {
                 
         //ModelIterator
         AT_MODELITERATOR,
-        AT_TWOVALUEDITERATOR
+        AT_TWOVALUEDITERATOR,
+
+	AT_TABLEVIEW, //!< a lazy view on a predicate or function table
+	AT_FUNCTABLEVIEW //!< only the lua type of a view on a function table, which is an AT_TABLEVIEW otherwise
 };
 
 template<class T>
@@ -330,6 +334,7 @@ struct InternalArgument {
                 
         WrapModelIterator* _modelIterator;
         TwoValuedStructureIterator* _twoValuedIterator;
+		TableView* _tableview;
 	} _value;
 
 	// Constructors
@@ -456,6 +461,10 @@ struct InternalArgument {
 			: _type(AT_TWOVALUEDITERATOR) {
         	_value._twoValuedIterator = v;
 	}
+	InternalArgument(TableView* v)
+			: _type(AT_TABLEVIEW) {
+		_value._tableview = v;
+	}
 	// Inspectors
 	std::set<Sort*>* sort() const {
 		if (_type == AT_SORT) {
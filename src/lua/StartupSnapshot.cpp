@@ -0,0 +1,247 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "StartupSnapshot.hpp"
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include "luaconnection.hpp"
+#include "common.hpp"
+#include "GlobalData.hpp"
+#include "namespace/namespace.hpp"
+#include "internalargument.hpp"
+
+using namespace std;
+
+SnapshotMode StartupSnapshot::_mode = SnapshotMode::LOAD;
+string StartupSnapshot::_file = "";
+
+static const string snapshotmagic = "IDPSNAPSHOT1";
+
+string StartupSnapshot::path() {
+	if (not _file.empty()) {
+		return _file;
+	}
+	return getPathOfIdpInternals() + ".snapshot";
+}
+
+// Identifies the version of the system and of the internal libraries the snapshot was made from
+// NOTE: does not contain the paths of the libraries, as the same installation can be reached through different paths
+string StartupSnapshot::fingerprint() {
+	stringstream ss;
+	ss << GIDLVERSION << " " << GITHASH;
+	for (auto file : { getPathOfLuaInternals(), getPathOfIdpInternals() }) {
+		struct stat info;
+		if (stat(file.c_str(), &info) != 0) {
+			ss << " missing";
+		} else {
+			ss << " " << info.st_size << ":" << info.st_mtime;
+		}
+	}
+	return ss.str();
+}
+
+namespace {
+
+void writeNumber(ostream& stream, unsigned int number) {
+	for (int i = 0; i < 4; ++i) {
+		stream.put((char) ((number >> (8 * i)) & 0xff));
+	}
+}
+void writeString(ostream& stream, const string& text) {
+	writeNumber(stream, text.size());
+	stream.write(text.data(), text.size());
+}
+void writeStrings(ostream& stream, const vector<string>& texts) {
+	writeNumber(stream, texts.size());
+	for (auto& text : texts) {
+		writeString(stream, text);
+	}
+}
+
+bool readNumber(istream& stream, unsigned int& number) {
+	number = 0;
+	for (int i = 0; i < 4; ++i) {
+		auto c = stream.get();
+		if (c == EOF) {
+			return false;
+		}
+		number |= ((unsigned int) (unsigned char) c) << (8 * i);
+	}
+	return true;
+}
+bool readString(istream& stream, string& text) {
+	unsigned int size;
+	if (not readNumber(stream, size)) {
+		return false;
+	}
+	text.resize(size);
+	if (size > 0) {
+		stream.read(&text[0], size);
+	}
+	return (unsigned int) stream.gcount() == size || size == 0;
+}
+bool readStrings(istream& stream, vector<string>& texts) {
+	unsigned int size;
+	if (not readNumber(stream, size)) {
+		return false;
+	}
+	texts.resize(size);
+	for (auto& text : texts) {
+		if (not readString(stream, text)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int dumpToString(lua_State*, const void* data, size_t size, void* result) {
+	((string*) result)->append((const char*) data, size);
+	return 0;
+}
+
+// Dumps the bytecode of the function on top of the stack and pops it
+string dumpFunction(lua_State* state) {
+	string result;
+	lua_dump(state, &dumpToString, &result);
+	lua_pop(state, 1);
+	return result;
+}
+
+}
+
+void StartupSnapshot::collect(lua_State* state, Namespace* space, vector<string>& path, vector<ProcedureImage>& procedures) {
+	for (auto& name2proc : space->procedures()) {
+		auto proc = name2proc.second;
+		if (not proc->iscompiled()) {
+			continue; // Compilation failed, the parser already reported it
+		}
+		ProcedureImage image;
+		image.space = path;
+		image.name = proc->name();
+		image.description = proc->description();
+		image.code = proc->getProcedurecode();
+		image.args = proc->args();
+		image.line = proc->pi().linenumber();
+		image.col = proc->pi().columnnumber();
+		lua_getfield(state, LUA_REGISTRYINDEX, proc->registryindex().c_str());
+		image.bytecode = dumpFunction(state);
+		procedures.push_back(image);
+	}
+	for (auto& name2space : space->subspaces()) {
+		path.push_back(name2space.first);
+		collect(state, name2space.second, path, procedures);
+		path.pop_back();
+	}
+}
+
+bool StartupSnapshot::write(lua_State* state, const string& file) {
+	StartupSnapshot snapshot;
+	if (luaL_loadfile(state, getPathOfLuaInternals().c_str()) != 0) {
+		lua_pop(state, 1);
+		return false;
+	}
+	snapshot._luachunk = dumpFunction(state);
+	vector<string> path;
+	collect(state, getGlobal()->getGlobalNamespace(), path, snapshot._procedures);
+
+	ofstream stream(file.c_str(), ios::out | ios::binary | ios::trunc);
+	if (not stream.is_open()) {
+		return false;
+	}
+	writeString(stream, snapshotmagic);
+	writeString(stream, fingerprint());
+	writeString(stream, snapshot._luachunk);
+	writeNumber(stream, snapshot._procedures.size());
+	for (auto& proc : snapshot._procedures) {
+		writeStrings(stream, proc.space);
+		writeString(stream, proc.name);
+		writeString(stream, proc.description);
+		writeString(stream, proc.code);
+		writeString(stream, proc.bytecode);
+		writeStrings(stream, proc.args);
+		writeNumber(stream, proc.line);
+		writeNumber(stream, proc.col);
+	}
+	return stream.good();
+}
+
+StartupSnapshot* StartupSnapshot::read(const string& file) {
+	ifstream stream(file.c_str(), ios::in | ios::binary);
+	if (not stream.is_open()) {
+		return NULL;
+	}
+	string magic, stamp;
+	if (not readString(stream, magic) || magic != snapshotmagic || not readString(stream, stamp) || stamp != fingerprint()) {
+		return NULL;
+	}
+	auto snapshot = new StartupSnapshot();
+	unsigned int nbprocedures;
+	auto valid = readString(stream, snapshot->_luachunk) && readNumber(stream, nbprocedures);
+	for (unsigned int i = 0; valid && i < nbprocedures; ++i) {
+		ProcedureImage proc;
+		valid = readStrings(stream, proc.space) && readString(stream, proc.name) && readString(stream, proc.description) && readString(stream, proc.code)
+				&& readString(stream, proc.bytecode) && readStrings(stream, proc.args) && readNumber(stream, proc.line) && readNumber(stream, proc.col);
+		snapshot->_procedures.push_back(proc);
+	}
+	if (not valid) {
+		delete (snapshot);
+		return NULL;
+	}
+	return snapshot;
+}
+
+bool StartupSnapshot::runLuaInternals(lua_State* state) const {
+	if (luaL_loadbuffer(state, _luachunk.data(), _luachunk.size(), getPathOfLuaInternals().c_str()) != 0) {
+		return false;
+	}
+	return lua_pcall(state, 0, 0, 0) == 0;
+}
+
+void StartupSnapshot::restoreProcedures(lua_State* state) const {
+	auto file = new string(getPathOfIdpInternals());
+	auto global = getGlobal()->getGlobalNamespace();
+	auto stdspace = getGlobal()->getStdNamespace();
+	vector<Namespace*> restoredspaces;
+	for (auto& image : _procedures) {
+		auto space = global;
+		for (auto& name : image.space) {
+			if (space->isSubspace(name)) {
+				space = space->subspace(name);
+			} else {
+				space = new Namespace(name, space, ParseInfo(image.line, image.col, file));
+				restoredspaces.push_back(space);
+			}
+		}
+		stringstream description;
+		description << image.description;
+		auto proc = new UserProcedure(image.name, ParseInfo(image.line, image.col, file), &description);
+		for (auto& arg : image.args) {
+			proc->addarg(arg);
+		}
+		proc->add(image.code);
+		space->add(proc);
+
+		if (luaL_loadbuffer(state, image.bytecode.data(), image.bytecode.size(), image.name.c_str()) != 0) {
+			lua_pop(state, 1);
+			LuaConnection::compile(proc); // Fall back to compiling the code
+		} else {
+			LuaConnection::storeCompiled(proc);
+		}
+		if (space->isGlobal() || space == stdspace || space->hasParent(stdspace)) {
+			LuaConnection::addGlobal(proc);
+		}
+	}
+	// As the parser, make the namespaces visible after their contents, innermost first
+	for (auto i = restoredspaces.rbegin(); i != restoredspaces.rend(); ++i) {
+		LuaConnection::checkedAddToGlobal(*i);
+	}
+}
@@ -0,0 +1,82 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef STARTUPSNAPSHOT_HPP_
+#define STARTUPSNAPSHOT_HPP_
+
+#include <string>
+#include <vector>
+
+struct lua_State;
+class Namespace;
+
+enum class SnapshotMode {
+	LOAD, //!< Start from the snapshot if there is a valid one (default)
+	IGNORE, //!< Always run and parse the internal libraries
+	WRITE //!< Run and parse the internal libraries and write a new snapshot
+};
+
+/**
+ * Image of the state built at startup from the internal libraries (idp_intern.lua and idp_intern.idp):
+ * the precompiled Lua chunk of idp_intern.lua and, for every procedure of idp_intern.idp, its namespace, signature, code and precompiled body.
+ * Loading the image replaces running the Lua file and parsing the idp file, so no flex/bison parsing or Lua compilation is done at startup.
+ *
+ * The image is only used if it was written by the same version of the system from internal libraries with the same size and modification time,
+ * otherwise the libraries are parsed as before.
+ */
+class StartupSnapshot {
+private:
+	struct ProcedureImage {
+		std::vector<std::string> space; //!< Names of the namespaces containing the procedure, starting below the global namespace
+		std::string name, description, code, bytecode;
+		std::vector<std::string> args;
+		unsigned int line, col;
+	};
+
+	std::string _luachunk; //!< Precompiled idp_intern.lua
+	std::vector<ProcedureImage> _procedures;
+
+	static SnapshotMode _mode;
+	static std::string _file; //!< The file of the snapshot, empty for the default one
+
+	StartupSnapshot() {
+	}
+
+	static std::string fingerprint();
+	static void collect(lua_State* state, Namespace* space, std::vector<std::string>& path, std::vector<ProcedureImage>& procedures);
+
+public:
+	static void setMode(SnapshotMode mode) {
+		_mode = mode;
+	}
+	static SnapshotMode mode() {
+		return _mode;
+	}
+	//! Use the given file for the snapshot instead of the default one, e.g. to write it into a staging directory when installing
+	static void setPath(const std::string& file) {
+		_file = file;
+	}
+	//! The file in which the snapshot is stored, by default next to the internal libraries
+	static std::string path();
+
+	//! Returns the snapshot stored in the given file, NULL if there is no valid snapshot for the current internal libraries
+	static StartupSnapshot* read(const std::string& file);
+	//! Writes the snapshot of the state built from the internal libraries. Returns false if the file could not be written.
+	//! PRECONDITION: the internal libraries have been run and parsed, and nothing else has been parsed yet.
+	static bool write(lua_State* state, const std::string& file);
+
+	//! Runs the precompiled internal Lua chunk. Returns false, with the error message on the stack, if running it fails.
+	bool runLuaInternals(lua_State* state) const;
+	//! Recreates the namespaces and procedures of the internal idp library
+	void restoreProcedures(lua_State* state) const;
+};
+
+#endif /* STARTUPSNAPSHOT_HPP_ */
@@ -13,6 +13,7 @@
 #include <set>
 #include <iostream>
 #include <cstdlib>
+#include <limits>
 #include "IncludeComponents.hpp"
 #include "options.hpp"
 #include "errorhandling/error.hpp"
@@ -24,7 +25,10 @@
 #include "utils/ListUtils.hpp"
 #include "insert.hpp"
 #include "structure/StructureComponents.hpp"
+#include "structure/TableView.hpp"
 #include "external/runidp.hpp"
+#include "StartupSnapshot.hpp"
+#include "utils/Profiler.hpp"
 #include "lstate.h"
 #include "inferences/makeTwoValued/TwoValuedStructureIterator.hpp"
 
@@ -82,7 +86,8 @@ const char* toCString(ArgType type) {
 				AT_DOMAINITERATOR, "domain_iterator")(AT_QUERY, "query")(AT_TERM, "term")(AT_FOBDD, "fobdd")(AT_FORMULA, "formula")(AT_THEORY,
 				"theory")(AT_OPTIONS, "options")(AT_NAMESPACE, "namespace")(AT_NIL, "nil")(AT_INT, "number")(AT_DOUBLE, "number")(AT_BOOLEAN, "boolean")(
 				AT_STRING, "string")(AT_TABLE, "table")(AT_PROCEDURE, "function")(AT_OVERLOADED, "overloaded")(AT_MULT, "mult")(AT_REGISTRY, "registry")(
-				AT_TRACEMONITOR, "tracemonitor")(AT_MODELITERATOR, "mxIterator")(AT_TWOVALUEDITERATOR, "twoValuedIterator");
+				AT_TRACEMONITOR, "tracemonitor")(AT_MODELITERATOR, "mxIterator")(AT_TWOVALUEDITERATOR, "twoValuedIterator")(AT_TABLEVIEW, "predicate_table_view")(
+				AT_FUNCTABLEVIEW, "function_table_view");
 		init = true;
 	}
 	return argType2Name.at(type);
@@ -159,7 +164,11 @@ int InternalProcedure::operator()(lua_State* L) const {
 	if (inference_->needPrintMonitor()) {
 		inference_->addPrintMonitor(new LuaInteractivePrintMonitor(L));
 	}
-	InternalArgument result = inference_->execute(args);
+	InternalArgument result;
+	{
+		ProfilePhase phase(inference_->getName().c_str());
+		result = inference_->execute(args);
+	}
 	inference_->clean();
 	int out = LuaConnection::convertToLua(L, result);
 	if (result._type == AT_STRING) {
@@ -170,6 +179,13 @@ int InternalProcedure::operator()(lua_State* L) const {
 
 std::map<const void*, UserProcedure*> p2name;
 
+void storeCompiled(UserProcedure* procedure, lua_State* state) {
+	procedure->setRegistryIndex("idp_compiled_procedure_" + convertToString(UserProcedure::getCompileNumber()));
+	UserProcedure::increaseCompileNumber();
+	p2name[lua_topointer(state, -1)]=procedure;
+	lua_setfield(state, LUA_REGISTRYINDEX, procedure->registryindex().c_str());
+}
+
 void compile(UserProcedure* procedure, lua_State* state) {
 	if (not procedure->iscompiled()) {
 		// Compose function header, body, and return statement
@@ -214,10 +230,7 @@ void compile(UserProcedure* procedure, lua_State* state) {
 			Error::error(ss.str(), ParseInfo(procedure->pi().linenumber()+lineNb,1,procedure->pi().filename()));
 			return;
 		}
-		procedure->setRegistryIndex("idp_compiled_procedure_" + convertToString(UserProcedure::getCompileNumber()));
-		UserProcedure::increaseCompileNumber();
-		p2name[lua_topointer(state, -1)]=procedure;
-		lua_setfield(state, LUA_REGISTRYINDEX, procedure->registryindex().c_str());
+		storeCompiled(procedure, state);
 	}
 }
 
@@ -448,6 +461,12 @@ int convertToLua(lua_State* L, InternalArgument arg) {
 		Assert(arg._value._twoValuedIterator!=NULL);
 		result = addUserData(L, arg._value._twoValuedIterator, arg._type);
 		break;
+	case AT_TABLEVIEW:
+		Assert(arg._value._tableview!=NULL);
+		result = addUserData(L, arg._value._tableview, arg._value._tableview->function() ? AT_FUNCTABLEVIEW : AT_TABLEVIEW);
+		break;
+	case AT_FUNCTABLEVIEW:
+		throw IdpException("Invalid code path: function table views are passed as table views.");
 	case AT_TRACEMONITOR:
 		throw IdpException("Tracemonitors cannot be passed to lua.");
 	}
@@ -580,6 +599,11 @@ InternalArgument createArgument(int arg, lua_State* L) {
 		case AT_TWOVALUEDITERATOR:
 			ia._value._twoValuedIterator = *(TwoValuedStructureIterator**) lua_touserdata(L, arg);
 			break;
+		case AT_TABLEVIEW:
+		case AT_FUNCTABLEVIEW:
+			ia._type = AT_TABLEVIEW;
+			ia._value._tableview = *(TableView**) lua_touserdata(L, arg);
+			break;
 		default:
 			throw IdpException("Encountered a lua USERDATA for which not internal type exists (or it is not handled correctly).");
 		}
@@ -911,6 +935,10 @@ int gcTwoValuedIterator(lua_State* L) {
 	return garbageCollect(*(TwoValuedStructureIterator**) lua_touserdata(L, 1));
 }
 
+int gcTableView(lua_State* L) {
+	return garbageCollect(*(TableView**) lua_touserdata(L, 1));
+}
+
 /**
  * Garbage collection for options
  */
@@ -1161,6 +1189,237 @@ int tupleLen(lua_State* L) {
 	return 1;
 }
 
+/**
+ * Get a table view from the lua stack, raising a lua error if it is not there
+ */
+TableView* getTableView(lua_State* L, int arg) {
+	if (lua_type(L, arg) != LUA_TUSERDATA) {
+		lua_pushstring(L, "Expected a table view. Use the \":\" operator.");
+		lua_error(L);
+	}
+	lua_getmetatable(L, arg);
+	lua_getfield(L, -1, getTypeField());
+	auto type = (ArgType) lua_tointeger(L, -1);
+	lua_pop(L, 2);
+	if (type != AT_TABLEVIEW && type != AT_FUNCTABLEVIEW) {
+		lua_pushstring(L, "Expected a table view. Use the \":\" operator.");
+		lua_error(L);
+	}
+	return *(TableView**) lua_touserdata(L, arg);
+}
+
+/**
+ * Get a table view over a finite table from the lua stack, raising a lua error otherwise
+ */
+TableView* getFiniteTableView(lua_State* L, int arg) {
+	auto view = getTableView(L, arg);
+	if (not view->finite()) {
+		lua_pushstring(L, "Cannot iterate over the tuples of a view on an infinite table");
+		lua_error(L);
+	}
+	return view;
+}
+
+/**
+ * Get a one-based index from the lua stack and return it zero-based, raising a lua error if it is not a positive integer
+ */
+long long getViewIndex(lua_State* L, int arg) {
+	if (lua_type(L, arg) != LUA_TNUMBER || not isInt(lua_tonumber(L, arg)) || lua_tointeger(L, arg) < 1) {
+		lua_pushstring(L, "A predicate table view can only be indexed by a positive integer");
+		lua_error(L);
+	}
+	return lua_tointeger(L, arg) - 1;
+}
+
+/**
+ * Push all elements of the tuple with the given index to the stack, without creating any tuple or table
+ */
+int pushViewRow(lua_State* L, const TableView* view, long long index) {
+	auto tuple = view->tuple(index);
+	if (tuple == NULL) {
+		lua_pushnil(L);
+		return 1;
+	}
+	for (auto i = tuple->cbegin(); i < tuple->cend(); ++i) {
+		convertToLua(L, *i);
+	}
+	return tuple->size();
+}
+
+/**
+ * view:count(): the number of tuples in the view
+ */
+int tableviewCount(lua_State* L) {
+	auto view = getFiniteTableView(L, 1);
+	lua_pushinteger(L, view->size());
+	return 1;
+}
+
+/**
+ * view:get(i, j): the element in column j of tuple i
+ */
+int tableviewGet(lua_State* L) {
+	auto view = getFiniteTableView(L, 1);
+	auto index = getViewIndex(L, 2);
+	auto column = getViewIndex(L, 3);
+	return convertToLua(L, view->element(index, column));
+}
+
+/**
+ * view:row(i): all elements of tuple i, as separate return values
+ */
+int tableviewRow(lua_State* L) {
+	auto view = getFiniteTableView(L, 1);
+	return pushViewRow(L, view, getViewIndex(L, 2));
+}
+
+/**
+ * Iterator function used by view:rows(). Returns the next index followed by the elements of that tuple.
+ */
+int tableviewNextRow(lua_State* L) {
+	auto view = getFiniteTableView(L, 1);
+	long long index = lua_tointeger(L, 2); // One-based index of the previous tuple, hence zero-based index of the next one
+	if (view->tuple(index) == NULL) {
+		lua_pushnil(L);
+		return 1;
+	}
+	lua_pushinteger(L, index + 1);
+	return 1 + pushViewRow(L, view, index);
+}
+
+/**
+ * view:rows(): for i, x, y in view:rows() do ... end iterates over all tuples of the view
+ */
+int tableviewRows(lua_State* L) {
+	getFiniteTableView(L, 1);
+	lua_pushcfunction(L, &tableviewNextRow);
+	lua_pushvalue(L, 1);
+	lua_pushinteger(L, 0);
+	return 3;
+}
+
+/**
+ * view:project(c1, c2, ...): a new view showing only the given columns
+ */
+int tableviewProject(lua_State* L) {
+	auto view = getTableView(L, 1);
+	vector<unsigned int> columns;
+	for (int n = 2; n <= lua_gettop(L); ++n) {
+		columns.push_back(getViewIndex(L, n));
+	}
+	TableView* result = NULL;
+	try {
+		result = view->project(columns);
+	} catch (const IdpException& e) {
+		lua_pushstring(L, e.getMessage().c_str());
+		return lua_error(L);
+	}
+	return convertToLua(L, InternalArgument(result));
+}
+
+/**
+ * view:filter(c, value): a new view showing only the tuples with the given value in column c
+ */
+int tableviewFilter(lua_State* L) {
+	auto view = getTableView(L, 1);
+	auto column = getViewIndex(L, 2);
+	auto value = convertToElement(3, L);
+	if (value == NULL) {
+		lua_pushstring(L, "A predicate table view can only be filtered on numbers, strings, and compounds");
+		return lua_error(L);
+	}
+	TableView* result = NULL;
+	try {
+		result = view->filter(column, value);
+	} catch (const IdpException& e) {
+		lua_pushstring(L, e.getMessage().c_str());
+		return lua_error(L);
+	}
+	return convertToLua(L, InternalArgument(result));
+}
+
+/**
+ * view:export(): all tuples of the view in one flat lua array (row after row), followed by the arity of the view
+ */
+int tableviewExport(lua_State* L) {
+	auto view = getFiniteTableView(L, 1);
+	int arity = view->arity();
+	auto size = view->size();
+	if (arity > 0 && size > numeric_limits<int>::max() / arity) { // Lua arrays are indexed by ints
+		lua_pushstring(L, "The view has too many elements to export into one lua array");
+		return lua_error(L);
+	}
+	lua_createtable(L, size * arity, 0);
+	int position = 1;
+	for (long long index = 0; index < size; ++index) {
+		auto tuple = view->tuple(index);
+		Assert(tuple != NULL);
+		for (auto i = tuple->cbegin(); i < tuple->cend(); ++i) {
+			convertToLua(L, *i);
+			lua_rawseti(L, -2, position++);
+		}
+	}
+	lua_pushinteger(L, arity);
+	return 2;
+}
+
+/**
+ * Index function for predicate table views. Integers give access to the tuples, strings to the methods
+ */
+int tableviewIndex(lua_State* L) {
+	auto view = getTableView(L, 1);
+	if (lua_type(L, 2) == LUA_TSTRING) {
+		luaL_getmetatable(L, toCString(AT_TABLEVIEW));
+		lua_getfield(L, -1, lua_tostring(L, 2));
+		lua_remove(L, -2);
+		return 1;
+	}
+	auto index = getViewIndex(L, 2);
+	if (not view->finite()) {
+		lua_pushstring(L, "Cannot iterate over the tuples of a view on an infinite table");
+		return lua_error(L);
+	}
+	if (view->arity() == 1) {
+		return convertToLua(L, view->element(index, 0));
+	}
+	auto tuple = view->tuple(index);
+	if (tuple == NULL) {
+		lua_pushnil(L);
+		return 1;
+	}
+	lua_createtable(L, tuple->size(), 0);
+	for (size_t i = 0; i < tuple->size(); ++i) {
+		convertToLua(L, (*tuple)[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+	return 1;
+}
+
+/**
+ * Length operator for predicate table views
+ */
+int tableviewLen(lua_State* L) {
+	return tableviewCount(L);
+}
+
+/**
+ * Call function for predicate table views: checks whether the given tuple is in the view
+ */
+int tableviewCall(lua_State* L) {
+	auto view = getTableView(L, 1);
+	ElementTuple tuple;
+	for (int n = 2; n <= lua_gettop(L); ++n) {
+		auto element = convertToElement(n, L);
+		if (element == NULL) {
+			lua_pushstring(L, "Only numbers, strings, and compounds can be arguments of a predicate table view");
+			return lua_error(L);
+		}
+		tuple.push_back(element);
+	}
+	lua_pushboolean(L, view->contains(tuple));
+	return 1;
+}
+
 /**
  * Index function for predicate interpretations
  */
@@ -1800,6 +2059,76 @@ int mxNext(lua_State* L) {
 	}
 }
 
+WrapModelIterator* getMXIterator(lua_State* L, const std::string& method) {
+	if (lua_type(L, 1) == LUA_TNONE) {
+		lua_pushstring(L, (method + " expects an MXiterator. Use the \":\" operator.").c_str());
+		lua_error(L);
+	}
+	InternalArgument ia = createArgument(1, L);
+	if (ia._type != AT_MODELITERATOR) {
+		lua_pushstring(L, (method + " expects an MXiterator. Use the \":\" operator.").c_str());
+		lua_error(L);
+	}
+	return ia._value._modelIterator;
+}
+
+/**
+ * iterator:nextdelta(): finds the next model without building a structure for it.
+ * Returns a table mapping the name of each symbol (with its arity) to the list of tuples which are true in the model
+ * but not in the input structure, or nil if there are no more models. Raises an error if the search was interrupted.
+ * The second return value is an iterator sharing the search, of which structure() keeps building this model
+ * (the structure() of the iterator itself builds the last model found).
+ */
+int mxNextDelta(lua_State* L) {
+	auto iter = getMXIterator(L, "nextdelta");
+	auto& delta = iter->lastDelta();
+	bool found = false;
+	try {
+		found = iter->get()->calculateDelta(delta);
+	} catch (const IdpException& e) {
+		lua_pushstring(L, e.getMessage().c_str());
+		return lua_error(L);
+	}
+	if (not found) {
+		lua_pushnil(L);
+		return 1;
+	}
+	lua_newtable(L);
+	for (const auto& symbol2tuples : delta.trueatoms) {
+		lua_newtable(L);
+		int n = 1;
+		for (const auto& tuple : symbol2tuples.second) {
+			lua_newtable(L);
+			for (size_t i = 0; i < tuple.size(); ++i) {
+				convertToLua(L, tuple[i]);
+				lua_rawseti(L, -2, i + 1);
+			}
+			lua_rawseti(L, -2, n++);
+		}
+		lua_setfield(L, -2, symbol2tuples.first->name().c_str());
+	}
+	auto handle = new WrapModelIterator(iter->get());
+	handle->lastDelta().model = delta.model; // Only the model is needed to build the structure
+	InternalArgument ia(handle);
+	return 1 + convertToLua(L, ia);
+}
+
+/**
+ * iterator:structure(): builds the structure of the last model found by nextdelta
+ */
+int mxStructure(lua_State* L) {
+	auto iter = getMXIterator(L, "structure");
+	Structure* structure = NULL;
+	try {
+		structure = iter->get()->buildStructure(iter->lastDelta());
+	} catch (const IdpException& e) {
+		lua_pushstring(L, e.getMessage().c_str());
+		return lua_error(L);
+	}
+	InternalArgument ia(structure);
+	return convertToLua(L, ia);
+}
+
 int twoValuedNext(lua_State* L) {
 	if (lua_type(L, 1) == LUA_TNONE) {
 		lua_pushstring(L, "next expects an twoValuedIterator. Use the \":\" operator.");
@@ -2012,10 +2341,28 @@ void overloadedMetaTable(lua_State* L) {
 	createNewTable(L, AT_OVERLOADED, elements);
 }
 
+void tableviewMetaTable(lua_State* L, ArgType type) {
+	vector<tablecolheader> elements;
+	elements.push_back(tablecolheader { &gcTableView, "__gc" });
+	elements.push_back(tablecolheader { &tableviewIndex, "__index" });
+	elements.push_back(tablecolheader { &tableviewLen, "__len" });
+	elements.push_back(tablecolheader { &tableviewCall, "__call" });
+	elements.push_back(tablecolheader { &tableviewCount, "count" });
+	elements.push_back(tablecolheader { &tableviewGet, "get" });
+	elements.push_back(tablecolheader { &tableviewRow, "row" });
+	elements.push_back(tablecolheader { &tableviewRows, "rows" });
+	elements.push_back(tablecolheader { &tableviewProject, "project" });
+	elements.push_back(tablecolheader { &tableviewFilter, "filter" });
+	elements.push_back(tablecolheader { &tableviewExport, "export" });
+	createNewTable(L, type, elements);
+}
+
 void mxIteratorMetaTable(lua_State* L) {
 	vector<tablecolheader> elements;
 	elements.push_back(tablecolheader { &gcMXIterator, "__gc" });
 	elements.push_back(tablecolheader { &mxNext, "next" });
+	elements.push_back(tablecolheader { &mxNextDelta, "nextdelta" });
+	elements.push_back(tablecolheader { &mxStructure, "structure" });
 	createNewTable(L, AT_MODELITERATOR, elements);
 	
 	//Make metatable own table:
@@ -2065,6 +2412,8 @@ void createMetaTables(lua_State* L) {
 	structureMetaTable(L);
 	tableiteratorMetaTable(L);
 	domainiteratorMetaTable(L);
+	tableviewMetaTable(L, AT_TABLEVIEW);
+	tableviewMetaTable(L, AT_FUNCTABLEVIEW);
 
 	theoryMetaTable(L);
 	formulaMetaTable(L);
@@ -2196,8 +2545,14 @@ void makeLuaConnection() {
 	// Add internal procedures
 	addInternalProcedures(getState());
 
+	// Start from the snapshot of the internal libraries, if there is a valid one
+	StartupSnapshot* snapshot = NULL;
+	if (StartupSnapshot::mode() == SnapshotMode::LOAD) {
+		snapshot = StartupSnapshot::read(StartupSnapshot::path());
+	}
+
 	// Overwrite some standard lua procedures
-	int err = luaL_dofile(getState(),getPathOfLuaInternals().c_str());
+	int err = snapshot != NULL ? not snapshot->runLuaInternals(getState()) : luaL_dofile(getState(),getPathOfLuaInternals().c_str());
 	if (err) {
 		clog << lua_tostring(getState(),-1) << "\n";
 		clog << "Error in " << getPathOfLuaInternals() << ".\n";
@@ -2212,7 +2567,15 @@ void makeLuaConnection() {
 	addGlobal("stdoptions", GlobalData::instance()->getOptions()); // TODO string "stdoptions" used twice, also in data/idp_intern.lua
 
 	// Parse standard input file
-	parsefile(getPathOfIdpInternals());
+	if (snapshot != NULL) {
+		snapshot->restoreProcedures(getState());
+		delete (snapshot);
+	} else {
+		parsefile(getPathOfIdpInternals());
+	}
+	if (StartupSnapshot::mode() == SnapshotMode::WRITE && not StartupSnapshot::write(getState(), StartupSnapshot::path())) {
+		Error::error("Could not write the startup snapshot " + StartupSnapshot::path() + ".");
+	}
 
 	for (auto i = GlobalData::getGlobalNamespace()->subspaces().cbegin(); i != GlobalData::getGlobalNamespace()->subspaces().cend(); ++i) {
 		checkedAddToGlobal(i->second);
@@ -2339,6 +2702,10 @@ bool predcall(string* procedure, const ElementTuple& input) {
 	}
 }
 
+void storeCompiled(UserProcedure* proc) {
+	storeCompiled(proc, getState());
+}
+
 void compile(UserProcedure* proc) {
 	compile(proc, getState());
 }
@@ -61,6 +61,8 @@ std::string* getProcedure(const std::vector<std::string>&, const ParseInfo&);
 
 const DomainElement* execute(const std::string& chunk);
 void compile(UserProcedure*);
+//! Stores the function on top of the stack as the compiled version of the given procedure
+void storeCompiled(UserProcedure*);
 
 InternalArgument createArgument(int arg, lua_State* L);
 
@@ -93,6 +95,7 @@ LuaTraceMonitor* getLuaTraceMonitor();
 class WrapModelIterator {
 private:
     std::shared_ptr<ModelIterator> wrap;
+    ModelDelta lastdelta; // The last model found with nextdelta
 public:
     WrapModelIterator(std::shared_ptr<ModelIterator> wrap) {
         this->wrap = wrap;
@@ -105,6 +108,9 @@ public:
     std::shared_ptr<ModelIterator> operator->() {
         return wrap;
     }
+    ModelDelta& lastDelta() {
+        return lastdelta;
+    }
 };
 
 #endif /* LUACONNECTION_HPP_ */
@@ -50,6 +50,36 @@ std::string str(SolverHeuristic choice) {
 	}
 }
 
+std::string str(ModelStream choice) {
+	switch (choice) {
+	case ModelStream::JSONLINES:
+		return "jsonl";
+	case ModelStream::BINARY:
+		return "binary";
+	default:
+		throw IdpException("Invalid code path.");
+	}
+}
+
+std::string str(AggEncoding choice) {
+	switch (choice) {
+	case AggEncoding::NATIVE:
+		return "native";
+	case AggEncoding::SEQUENTIAL:
+		return "sequential";
+	case AggEncoding::TOTALIZER:
+		return "totalizer";
+	case AggEncoding::SORTINGNETWORK:
+		return "sortingnetwork";
+	case AggEncoding::BDD:
+		return "bdd";
+	case AggEncoding::AUTO:
+		return "auto";
+	default:
+		throw IdpException("Invalid code path.");
+	}
+}
+
 std::string str(FullProp choice) {
 	switch (choice) {
       case FullProp::ASSUMPTIONS:
@@ -97,6 +127,12 @@ inline Language operator++(Language& x) {
 inline SolverHeuristic operator++(SolverHeuristic& x) {
 	return x = (SolverHeuristic) (((int) (x) + 1));
 }
+inline ModelStream operator++(ModelStream& x) {
+	return x = (ModelStream) (((int) (x) + 1));
+}
+inline AggEncoding operator++(AggEncoding& x) {
+	return x = (AggEncoding) (((int) (x) + 1));
+}
 inline FullProp operator++(FullProp& x) {
 	return x = (FullProp) (((int) (x) + 1));
 }
@@ -112,6 +148,12 @@ inline Language operator*(Language& x) {
 inline SolverHeuristic operator*(SolverHeuristic& x){
 	return x;
 }
+inline ModelStream operator*(ModelStream& x){
+	return x;
+}
+inline AggEncoding operator*(AggEncoding& x){
+	return x;
+}
 inline FullProp operator*(FullProp& x) {
 	return x;
 }
@@ -227,6 +269,11 @@ Options::Options(bool verboseOptions): _isVerbosity(verboseOptions) {
 		BoolPol::createOption(BoolType::EXPANDIMMEDIATELY, "expandimm", boolvalues, false, PrintBehaviour::DONOTPRINT);
 		BoolPol::createOption(BoolType::TSEITINDELAY, "tseitindelay", boolvalues, false, PrintBehaviour::PRINT);
 		BoolPol::createOption(BoolType::SATISFIABILITYDELAY, "satdelay", boolvalues, false, PrintBehaviour::PRINT);
+		BoolPol::createOption(BoolType::NATIVEFUNCCONSTRAINTS, "nativefuncconstraints", boolvalues, true, PrintBehaviour::PRINT);
+		BoolPol::createOption(BoolType::COMPACTTRANSLATOR, "compacttranslator", boolvalues, false, PrintBehaviour::PRINT);
+		BoolPol::createOption(BoolType::MODELSTREAMDIFF, "modelstreamdiff", boolvalues, false, PrintBehaviour::PRINT);
+		BoolPol::createOption(BoolType::APPROXCOUNTING, "approxcounting", boolvalues, false, PrintBehaviour::PRINT);
+		BoolPol::createOption(BoolType::BOUNDSCACHE, "boundscache", boolvalues, false, PrintBehaviour::PRINT);
 		BoolPol::createOption(BoolType::EXISTS_ONLYONELEFT_APPROX, "existsonlyoneleftapprox", boolvalues, false, PrintBehaviour::PRINT);
 		BoolPol::createOption(BoolType::POSTPROCESS_DEFS, "postprocessdefs", boolvalues, true, PrintBehaviour::DONOTPRINT);//Only for internal use for the moment: serves for avoiding loops in bootstrapping
 		BoolPol::createOption(BoolType::SPLIT_DEFS, "splitdefs", boolvalues, true, PrintBehaviour::DONOTPRINT);//Only for internal use for the moment: serves for avoiding loops in bootstrapping
@@ -239,6 +286,8 @@ Options::Options(bool verboseOptions): _isVerbosity(verboseOptions) {
 		BoolPol::createOption(BoolType::LIFTEDUNITPROPAGATION, "liftedunitpropagation", boolvalues, true, PrintBehaviour::PRINT);
 		IntPol::createOption(IntType::NRPROPSTEPS, "nrpropsteps", 0, getMaxElem<int>(), 6, PrintBehaviour::PRINT);
 		IntPol::createOption(IntType::LONGESTBRANCH, "longestbranch", 0, getMaxElem<int>(), 13, PrintBehaviour::PRINT);
+		IntPol::createOption(IntType::BACKBONEWORKERS, "backboneworkers", 1, getMaxElem<int>(), 1, PrintBehaviour::PRINT);
+		IntPol::createOption(IntType::ENUMERATIONWORKERS, "enumerationworkers", 1, getMaxElem<int>(), 1, PrintBehaviour::PRINT);
 
 		BoolPol::createOption(BoolType::ASSUMECONSISTENTINPUT, "assumeconsistentinput", boolvalues, false, PrintBehaviour::PRINT);
 
@@ -247,6 +296,8 @@ Options::Options(bool verboseOptions): _isVerbosity(verboseOptions) {
 
 		IntPol::createOption(IntType::LAZYSIZETHRESHOLD, "lazysizelimit", 1, getMaxElem<int>(), 12, PrintBehaviour::PRINT);
 		IntPol::createOption(IntType::EXISTSEXPANSIONSTEPS, "existsexpansion", 1, getMaxElem<int>(), 10, PrintBehaviour::PRINT);
+		IntPol::createOption(IntType::TABLEINDEXMEMORY, "tableindexmemory", 0, getMaxElem<int>(), 256, PrintBehaviour::PRINT);
+		IntPol::createOption(IntType::GROUNDINGWINDOW, "groundingwindow", 0, getMaxElem<int>(), 0, PrintBehaviour::PRINT);
 
 		// NOTE: set this to infinity, so he always starts timing, even when the options have not been read in yet.
 		IntPol::createOption(IntType::TIMEOUT, "timeout", 0, getMaxElem<int>(), getMaxElem<int>(), PrintBehaviour::PRINT);
@@ -266,6 +317,10 @@ Options::Options(bool verboseOptions): _isVerbosity(verboseOptions) {
 				PrintBehaviour::PRINT);
 		StringPol::createOption(StringType::SOLVERHEURISTIC, "solverheuristic", possibleStringValues<SolverHeuristic>(), str(SolverHeuristic::CLASSIC),
 				PrintBehaviour::PRINT);
+		StringPol::createOption(StringType::MODELSTREAM, "modelstream", possibleStringValues<ModelStream>(), str(ModelStream::JSONLINES),
+				PrintBehaviour::PRINT);
+		StringPol::createOption(StringType::AGGENCODING, "aggencoding", possibleStringValues<AggEncoding>(), str(AggEncoding::NATIVE),
+				PrintBehaviour::PRINT);
 	}
 }
 
@@ -492,6 +547,29 @@ SolverHeuristic Options::solverHeuristic() const {
 	return SolverHeuristic::CLASSIC;
 }
 
+ModelStream Options::modelStream() const {
+	auto values = possibleValues<ModelStream>();
+	const std::string& value = StringPol::getValue(StringType::MODELSTREAM);
+	for (auto i = values.cbegin(); i != values.cend(); ++i) {
+		if (value.compare(str(*i)) == 0) {
+			return *i;
+		}
+	}
+	Warning::warning("Encountered unsupported modelstream option, assuming jsonl.\n");
+	return ModelStream::JSONLINES;
+}
+
+AggEncoding Options::aggEncoding() const {
+	auto values = possibleValues<AggEncoding>();
+	const std::string& value = StringPol::getValue(StringType::AGGENCODING);
+	for (auto i = values.cbegin(); i != values.cend(); ++i) {
+		if (value.compare(str(*i)) == 0) {
+			return *i;
+		}
+	}
+	Warning::warning("Encountered unsupported aggencoding option, assuming native.\n");
+	return AggEncoding::NATIVE;
+}
 
 std::string Options::printAllowedValues(const std::string& name) const {
 	if (isOptionOfType<int>(name)) {
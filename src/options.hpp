@@ -39,7 +39,9 @@ enum StringType {
 	SYMMETRYBREAKING,
 	PROVERCOMMAND,
 	APPROXDEF,
-	SOLVERHEURISTIC
+	SOLVERHEURISTIC,
+	MODELSTREAM,
+	AGGENCODING
 };
 
 enum IntType {
@@ -54,6 +56,10 @@ enum IntType {
 	RANDOMSEED,
 	LAZYSIZETHRESHOLD,
 	EXISTSEXPANSIONSTEPS,
+	TABLEINDEXMEMORY,
+	BACKBONEWORKERS,
+	ENUMERATIONWORKERS,
+	GROUNDINGWINDOW,
 	// DO NOT MIX verbosity and non-verbosity options!
 	VERBOSE_CREATE_GROUNDERS,
 	VERBOSE_GEN_AND_CHECK,
@@ -88,6 +94,11 @@ enum BoolType {
 	EXPANDIMMEDIATELY,
 	TSEITINDELAY,
 	SATISFIABILITYDELAY,
+	NATIVEFUNCCONSTRAINTS,
+	COMPACTTRANSLATOR,
+	MODELSTREAMDIFF,
+	APPROXCOUNTING,
+	BOUNDSCACHE,
 	GROUNDWITHBOUNDS,
 	CPSUPPORT,
 	SKOLEMIZE,
@@ -130,6 +141,24 @@ enum class SolverHeuristic {
 	LAST = VMTF
 };
 
+enum class ModelStream {
+	JSONLINES,
+	BINARY,
+	FIRST = JSONLINES,
+	LAST = BINARY
+};
+
+enum class AggEncoding {
+	NATIVE,
+	SEQUENTIAL,
+	TOTALIZER,
+	SORTINGNETWORK,
+	BDD,
+	AUTO,
+	FIRST = NATIVE,
+	LAST = AUTO
+};
+
 enum class FullProp {
 	ASSUMPTIONS,
 	INTERSECTION,
@@ -462,6 +491,8 @@ public:
 	SymmetryBreaking symmetryBreaking() const;
 	ApproxDef approxDef() const;
 	SolverHeuristic solverHeuristic() const;
+	ModelStream modelStream() const;
+	AggEncoding aggEncoding() const;
 
 	// NOTE: do NOT call this code outside luaconnection or other user interface methods.
 	template<class ValueType>
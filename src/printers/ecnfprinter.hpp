@@ -140,7 +140,7 @@ public:
 		setStructure(g->structure());
 		setTranslator(g->translator());
 		startTheory();
-		for (auto clause : g->getClauses()) {
+		for (auto& clause : g->getClauses()) {
 			CHECKTERMINATION
 			visit(clause);
 		}
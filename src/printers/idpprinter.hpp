@@ -359,9 +359,9 @@ public:
 		_printTermsAsBlock = false;
 		Assert(isTheoryOpen());
 		setTranslator(g->translator());
-		for (auto i = g->getClauses().cbegin(); i < g->getClauses().cend(); ++i) {
+		for (auto& clause : g->getClauses()) {
 			CHECKTERMINATION;
-			visit(*i);
+			visit(clause);
 		}
 		visitList(this, g->getCPReifications());
 		visitList(this, g->getSets());
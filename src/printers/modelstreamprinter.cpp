@@ -0,0 +1,302 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "modelstreamprinter.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include "IncludeComponents.hpp"
+#include "errorhandling/IdpException.hpp"
+
+using namespace std;
+
+ModelStreamPrinter::ModelStreamPrinter(std::ostream& stream, bool binary, bool diff)
+		: 	_stream(stream),
+			_binary(binary),
+			_diff(diff),
+			_nbmodels(0) {
+}
+
+static const SortedElementTable none;
+
+// Returns the true tuples of the symbol in the structure
+static SortedElementTable trueTuples(const Structure* structure, PFSymbol* symbol) {
+	auto table = structure->inter(symbol)->ct();
+	if (not table->finite()) {
+		throw IdpException("Cannot stream a model with an infinite interpretation for " + toString(symbol) + ".");
+	}
+	SortedElementTable tuples;
+	for (auto it = table->begin(); not it.isAtEnd(); ++it) {
+		tuples.insert(*it);
+	}
+	return tuples;
+}
+
+// Adds the tuples of the union of two disjoint tables, in order
+static void addUnion(const SortedElementTable& first, const SortedElementTable& second, vector<const ElementTuple*>& list) {
+	Compare<ElementTuple> less;
+	auto i = first.cbegin();
+	auto j = second.cbegin();
+	while (i != first.cend() || j != second.cend()) {
+		if (j == second.cend() || (i != first.cend() && less(*i, *j))) {
+			list.push_back(&*(i++));
+		} else {
+			list.push_back(&*(j++));
+		}
+	}
+}
+
+// Adds the tuples of first which are not in second, in order
+static void addDifference(const SortedElementTable& first, const SortedElementTable& second, vector<const ElementTuple*>& list) {
+	Compare<ElementTuple> less;
+	auto j = second.cbegin();
+	for (const auto& tuple : first) {
+		while (j != second.cend() && less(*j, tuple)) {
+			++j;
+		}
+		if (j == second.cend() || less(tuple, *j)) {
+			list.push_back(&tuple);
+		}
+	}
+}
+
+void ModelStreamPrinter::print(const Structure* model, const Vocabulary* outputvoc) {
+	if (outputvoc == NULL) {
+		outputvoc = model->vocabulary();
+	}
+	vector<PFSymbol*> symbols;
+	for (auto symbol : outputvoc->getNonBuiltinNonOverloadedNonTypeSymbols()) {
+		symbols.push_back(symbol);
+	}
+	vector<SortedElementTable> tables;
+	for (auto symbol : symbols) {
+		tables.push_back(trueTuples(model, symbol));
+	}
+	vector<const SortedElementTable*> tuples, inputtuples;
+	for (const auto& table : tables) {
+		tuples.push_back(&table);
+		inputtuples.push_back(NULL);
+	}
+	write(symbols, tuples, inputtuples);
+	if (_diff) {
+		for (size_t i = 0; i < symbols.size(); ++i) {
+			_previous[symbols[i]] = std::move(tables[i]);
+		}
+	}
+}
+
+void ModelStreamPrinter::print(const map<PFSymbol*, SortedElementTable>& trueatoms, const Structure* input, const Vocabulary* outputvoc) {
+	vector<PFSymbol*> symbols;
+	vector<const SortedElementTable*> tuples, inputtuples;
+	for (auto symbol : outputvoc->getNonBuiltinNonOverloadedNonTypeSymbols()) {
+		auto in = _input.find(symbol);
+		if (in == _input.cend()) {
+			in = _input.insert( { symbol, trueTuples(input, symbol) }).first;
+		}
+		auto delta = trueatoms.find(symbol);
+		symbols.push_back(symbol);
+		tuples.push_back(delta == trueatoms.cend() ? &none : &delta->second);
+		inputtuples.push_back(&in->second);
+	}
+	write(symbols, tuples, inputtuples);
+	if (_diff) {
+		_previous = trueatoms;
+	}
+}
+
+void ModelStreamPrinter::write(const vector<PFSymbol*>& symbols, const vector<const SortedElementTable*>& tuples,
+		const vector<const SortedElementTable*>& inputtuples) {
+	++_nbmodels;
+	auto diff = _diff && _nbmodels > 1;
+
+	vector<PFSymbol*> written;
+	vector<TupleList> added, removed;
+	for (size_t i = 0; i < symbols.size(); ++i) {
+		TupleList plus, minus;
+		if (not diff) {
+			addUnion(*tuples[i], inputtuples[i] == NULL ? none : *inputtuples[i], plus);
+		} else { // The tuples of the input structure are the same in every model
+			auto it = _previous.find(symbols[i]);
+			const auto& previous = it == _previous.cend() ? none : it->second;
+			addDifference(*tuples[i], previous, plus);
+			addDifference(previous, *tuples[i], minus);
+			if (plus.empty() && minus.empty()) {
+				continue;
+			}
+		}
+		written.push_back(symbols[i]);
+		added.push_back(std::move(plus));
+		removed.push_back(std::move(minus));
+	}
+
+	if (_binary) {
+		writeBinary(written, added, removed, diff);
+	} else {
+		writeJSON(written, added, removed, diff);
+	}
+	_stream.flush();
+}
+
+void ModelStreamPrinter::writeJSON(const vector<PFSymbol*>& symbols, const vector<TupleList>& added, const vector<TupleList>& removed, bool diff) {
+	_stream << "{\"model\":" << _nbmodels;
+	if (diff) {
+		_stream << ",\"diff\":true";
+	}
+	for (size_t i = 0; i < symbols.size(); ++i) {
+		_stream << ",";
+		writeJSON(symbols[i]->name());
+		_stream << ":";
+		if (diff) {
+			_stream << "{\"add\":";
+			writeJSON(added[i]);
+			_stream << ",\"remove\":";
+			writeJSON(removed[i]);
+			_stream << "}";
+		} else {
+			writeJSON(added[i]);
+		}
+	}
+	_stream << "}\n";
+}
+
+void ModelStreamPrinter::writeJSON(const TupleList& tuples) {
+	_stream << "[";
+	bool firsttuple = true;
+	for (auto tuple : tuples) {
+		if (not firsttuple) {
+			_stream << ",";
+		}
+		firsttuple = false;
+		_stream << "[";
+		for (size_t i = 0; i < tuple->size(); ++i) {
+			if (i > 0) {
+				_stream << ",";
+			}
+			writeJSON((*tuple)[i]);
+		}
+		_stream << "]";
+	}
+	_stream << "]";
+}
+
+void ModelStreamPrinter::writeJSON(const DomainElement* element) {
+	switch (element->type()) {
+	case DomainElementType::DET_INT:
+		_stream << element->value()._int;
+		break;
+	case DomainElementType::DET_DOUBLE: {
+		auto value = element->value()._double;
+		if (value != value || value == numeric_limits<double>::infinity() || value == -numeric_limits<double>::infinity()) {
+			writeJSON(toString(element)); // Not representable as a JSON number
+		} else {
+			_stream << setprecision(numeric_limits<double>::digits10 + 2) << value;
+		}
+		break;
+	}
+	case DomainElementType::DET_STRING:
+		writeJSON(*element->value()._string);
+		break;
+	case DomainElementType::DET_COMPOUND:
+		writeJSON(toString(element));
+		break;
+	}
+}
+
+void ModelStreamPrinter::writeJSON(const std::string& string) {
+	_stream << "\"";
+	for (auto c : string) {
+		switch (c) {
+		case '"':
+			_stream << "\\\"";
+			break;
+		case '\\':
+			_stream << "\\\\";
+			break;
+		case '\n':
+			_stream << "\\n";
+			break;
+		case '\r':
+			_stream << "\\r";
+			break;
+		case '\t':
+			_stream << "\\t";
+			break;
+		default:
+			if ((unsigned char) c < 0x20) {
+				_stream << "\\u" << hex << setw(4) << setfill('0') << (int) c << dec << setfill(' ');
+			} else {
+				_stream << c;
+			}
+		}
+	}
+	_stream << "\"";
+}
+
+void ModelStreamPrinter::writeBinary(const vector<PFSymbol*>& symbols, const vector<TupleList>& added, const vector<TupleList>& removed, bool diff) {
+	_stream.put(diff ? 'D' : 'M');
+	writeBinary(_nbmodels);
+	writeBinary((unsigned int) symbols.size());
+	for (size_t i = 0; i < symbols.size(); ++i) {
+		writeBinary(symbols[i]->name());
+		writeBinary(added[i]);
+		if (diff) {
+			writeBinary(removed[i]);
+		}
+	}
+}
+
+void ModelStreamPrinter::writeBinary(const TupleList& tuples) {
+	writeBinary((unsigned int) tuples.size());
+	for (auto tuple : tuples) {
+		for (auto element : *tuple) {
+			writeBinary(element);
+		}
+	}
+}
+
+void ModelStreamPrinter::writeBinary(const DomainElement* element) {
+	switch (element->type()) {
+	case DomainElementType::DET_INT:
+		_stream.put(0);
+		writeBinary((unsigned int) element->value()._int);
+		break;
+	case DomainElementType::DET_DOUBLE: {
+		_stream.put(1);
+		auto value = element->value()._double;
+		unsigned long long bits;
+		static_assert(sizeof(bits) == sizeof(value), "Doubles are expected to be 64 bit.");
+		memcpy(&bits, &value, sizeof(bits));
+		writeBinary((unsigned int) (bits & 0xFFFFFFFF));
+		writeBinary((unsigned int) (bits >> 32));
+		break;
+	}
+	case DomainElementType::DET_STRING:
+		_stream.put(2);
+		writeBinary(*element->value()._string);
+		break;
+	case DomainElementType::DET_COMPOUND:
+		_stream.put(3);
+		writeBinary(toString(element));
+		break;
+	}
+}
+
+void ModelStreamPrinter::writeBinary(const std::string& string) {
+	writeBinary((unsigned int) string.size());
+	_stream.write(string.data(), string.size());
+}
+
+void ModelStreamPrinter::writeBinary(unsigned int value) {
+	for (int i = 0; i < 4; ++i) {
+		_stream.put((char) ((value >> (8 * i)) & 0xFF));
+	}
+}
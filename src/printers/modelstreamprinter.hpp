@@ -0,0 +1,87 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef MODELSTREAMPRINTER_HPP_
+#define MODELSTREAMPRINTER_HPP_
+
+#include <ostream>
+#include <map>
+#include <vector>
+#include "structure/MainStructureComponents.hpp"
+
+class Structure;
+class Vocabulary;
+class PFSymbol;
+
+/**
+ * Writes two-valued models to a stream in a machine-oriented format, one model at a time, as soon as it is found.
+ * For each symbol of the output vocabulary (types and builtins excluded), the true tuples are written.
+ * For functions, the image is the last element of a tuple.
+ *
+ * JSON Lines: one JSON object per model on a single line, e.g.
+ * 		{"model":1,"P/2":[[1,"a"],[2,"b"]],"F/1":[[1,3]]}
+ * In diff mode, every model except the first only contains the symbols which changed, with the added and removed tuples:
+ * 		{"model":2,"diff":true,"P/2":{"add":[[3,"c"]],"remove":[[1,"a"]]}}
+ *
+ * Models can be given as a structure, or as the tuples which are true in addition to those of an input structure.
+ * The latter does not need a structure per model; one printer should only be given one of both kinds.
+ *
+ * Binary (all integers little-endian):
+ * 		model:   uint8 'M' (full) or 'D' (diff), uint32 model number, uint32 number of symbols, the symbols
+ * 		symbol:  string name, uint32 number of tuples, the tuples, and in a diff also uint32 number of removed tuples, the removed tuples
+ * 		tuple:   the elements (the number of elements follows from the arity of the symbol)
+ * 		element: uint8 0 and int32 for integers, 1 and a 64 bit IEEE double for doubles, 2 and a string for strings, 3 and a string for compounds
+ * 		string:  uint32 length and the characters
+ */
+class ModelStreamPrinter {
+private:
+	std::ostream& _stream;
+	bool _binary;
+	bool _diff;
+	unsigned int _nbmodels;
+	std::map<PFSymbol*, SortedElementTable> _previous; //!< In diff mode, the true tuples of each symbol in the previous model
+													   //!< (only those which are not true in the input structure, when given deltas)
+	std::map<PFSymbol*, SortedElementTable> _input; //!< When given deltas, the true tuples of each symbol in the input structure
+
+	typedef std::vector<const ElementTuple*> TupleList;
+
+	//! Writes the model in which the tuples of symbols[i] are tuples[i], together with inputtuples[i] if that is not NULL
+	void write(const std::vector<PFSymbol*>& symbols, const std::vector<const SortedElementTable*>& tuples,
+			const std::vector<const SortedElementTable*>& inputtuples);
+
+	void writeJSON(const std::vector<PFSymbol*>& symbols, const std::vector<TupleList>& added, const std::vector<TupleList>& removed, bool diff);
+	void writeJSON(const TupleList& tuples);
+	void writeJSON(const DomainElement* element);
+	void writeJSON(const std::string& string);
+
+	void writeBinary(const std::vector<PFSymbol*>& symbols, const std::vector<TupleList>& added, const std::vector<TupleList>& removed, bool diff);
+	void writeBinary(const TupleList& tuples);
+	void writeBinary(const DomainElement* element);
+	void writeBinary(const std::string& string);
+	void writeBinary(unsigned int value);
+
+public:
+	ModelStreamPrinter(std::ostream& stream, bool binary, bool diff);
+
+	//! Writes the given model, restricted to the given vocabulary (the vocabulary of the model if NULL), and flushes the stream
+	void print(const Structure* model, const Vocabulary* outputvoc);
+	/**
+	 * Writes the model which makes the given tuples true in addition to the true tuples of the input structure, restricted to the given vocabulary,
+	 * and flushes the stream. The input structure should be the same for every model.
+	 */
+	void print(const std::map<PFSymbol*, SortedElementTable>& trueatoms, const Structure* input, const Vocabulary* outputvoc);
+
+	unsigned int nbModels() const {
+		return _nbmodels;
+	}
+};
+
+#endif /* MODELSTREAMPRINTER_HPP_ */
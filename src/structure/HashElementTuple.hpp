@@ -13,9 +13,11 @@
 #define HASHELEMENTTUPLE_HPP_
 
 #include "DomainElement.hpp"
+#include "SmallElementTuple.hpp"
 
 struct HashTuple {
-	inline size_t operator()(const ElementTuple& tuple) const {
+	template<class Tuple>
+	inline size_t operator()(const Tuple& tuple) const {
 		size_t seed = 1;
 		int prod = 1;
 		for (auto i = tuple.cbegin(); i < tuple.cend(); ++i) {
@@ -340,6 +340,8 @@ public:
 
 	// Returns true if non-empty and a range
 	bool isRange() const;
+	// Returns true if finite, non-empty and a range of integers (isRange also holds for e.g. all floats, and fails on unions)
+	bool isIntRange() const;
 	// NOTE: first and last are guaranteed NOT NULL if the table is not empty
 	const DomainElement* first() const;
 	const DomainElement* last() const;
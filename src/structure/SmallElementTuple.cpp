@@ -0,0 +1,143 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "SmallElementTuple.hpp"
+#include <algorithm>
+#include "Assert.hpp"
+#include "errorhandling/IdpException.hpp"
+
+using namespace std;
+
+size_t SmallElementTuple::_nbheapallocations = 0;
+
+SmallElementTuple::SmallElementTuple(unsigned int size, const DomainElement* value)
+		: 	_size(0),
+			_capacity(INLINESIZE),
+			_heap(NULL) {
+	reserve(size);
+	fill(data(), data() + size, value);
+	_size = size;
+}
+
+SmallElementTuple::SmallElementTuple(const ElementTuple& tuple)
+		: 	_size(0),
+			_capacity(INLINESIZE),
+			_heap(NULL) {
+	assign(tuple.data(), tuple.data() + tuple.size());
+}
+
+SmallElementTuple SmallElementTuple::view(const ElementTuple& tuple) {
+	SmallElementTuple result;
+	if (not tuple.empty()) {
+		result._size = tuple.size();
+		result._capacity = 0;
+		result._heap = const_cast<const DomainElement**>(tuple.data());
+	}
+	return result;
+}
+
+void SmallElementTuple::throwViewChanged() {
+	throw IdpException("Invalid code path: changing a view of a tuple");
+}
+
+SmallElementTuple::SmallElementTuple(std::initializer_list<const DomainElement*> elements)
+		: 	_size(0),
+			_capacity(INLINESIZE),
+			_heap(NULL) {
+	assign(elements.begin(), elements.end());
+}
+
+SmallElementTuple::SmallElementTuple(const SmallElementTuple& other)
+		: 	_size(0),
+			_capacity(INLINESIZE),
+			_heap(NULL) {
+	assign(other.cbegin(), other.cend());
+}
+
+SmallElementTuple::SmallElementTuple(SmallElementTuple&& other)
+		: 	_size(other._size),
+			_capacity(other._capacity),
+			_heap(other._heap) {
+	if (_heap == NULL) {
+		copy(other._inline, other._inline + _size, _inline);
+	}
+	other._heap = NULL;
+	other._size = 0;
+	other._capacity = INLINESIZE;
+}
+
+SmallElementTuple& SmallElementTuple::operator=(const SmallElementTuple& other) {
+	if (this != &other) {
+		checkNotView();
+		_size = 0;
+		assign(other.cbegin(), other.cend());
+	}
+	return *this;
+}
+
+SmallElementTuple& SmallElementTuple::operator=(SmallElementTuple&& other) {
+	if (this == &other) {
+		return *this;
+	}
+	if (not isView()) {
+		delete[] _heap;
+	}
+	_size = other._size;
+	_capacity = other._capacity;
+	_heap = other._heap;
+	if (_heap == NULL) {
+		copy(other._inline, other._inline + _size, _inline);
+	}
+	other._heap = NULL;
+	other._size = 0;
+	other._capacity = INLINESIZE;
+	return *this;
+}
+
+void SmallElementTuple::reserve(unsigned int capacity) {
+	checkNotView();
+	if (capacity <= _capacity) {
+		return;
+	}
+	auto newheap = new const DomainElement*[capacity];
+	++_nbheapallocations;
+	copy(cbegin(), cend(), newheap);
+	delete[] _heap;
+	_heap = newheap;
+	_capacity = capacity;
+}
+
+void SmallElementTuple::assign(const_iterator begin, const_iterator end) {
+	Assert(_size == 0);
+	reserve(end - begin);
+	copy(begin, end, data());
+	_size = end - begin;
+}
+
+bool SmallElementTuple::operator==(const SmallElementTuple& other) const {
+	return _size == other._size && equal(cbegin(), cend(), other.cbegin());
+}
+
+bool SmallElementTuple::operator<(const SmallElementTuple& other) const {
+	return lexicographical_compare(cbegin(), cend(), other.cbegin(), other.cend());
+}
+
+std::ostream& SmallElementTuple::put(std::ostream& stream) const {
+	stream << "(";
+	for (auto i = cbegin(); i < cend(); ++i) {
+		if (i != cbegin()) {
+			stream << ",";
+		}
+		(*i)->put(stream);
+	}
+	stream << ")";
+	return stream;
+}
@@ -0,0 +1,147 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef SMALLELEMENTTUPLE_HPP_
+#define SMALLELEMENTTUPLE_HPP_
+
+#include <ostream>
+#include <initializer_list>
+#include "DomainElement.hpp"
+
+/**
+ * Tuple of domain elements which stores up to INLINESIZE elements inside the object itself.
+ * Only longer tuples allocate their elements on the heap, so the keys of hash tables and indexes over symbols of small arity
+ * cost no allocation and no extra indirection.
+ * Can be constructed from an ElementTuple, so containers keyed on small tuples can be searched with an ElementTuple.
+ * To search without copying the elements, use view().
+ */
+class SmallElementTuple {
+public:
+	static const unsigned int INLINESIZE = 4;
+	typedef const DomainElement* value_type;
+	typedef const DomainElement* const * const_iterator;
+
+private:
+	unsigned int _size;
+	unsigned int _capacity;
+	const DomainElement* _inline[INLINESIZE];
+	const DomainElement** _heap; //!< NULL as long as the elements fit in _inline
+	// NOTE: a _capacity of 0 marks a view, whose _heap points to the elements of an ElementTuple and is not owned
+
+	static size_t _nbheapallocations; //!< Number of heap allocations done by all small tuples
+
+	const DomainElement** data() {
+		return _heap == NULL ? _inline : _heap;
+	}
+	const DomainElement* const * data() const {
+		return _heap == NULL ? _inline : _heap;
+	}
+	bool isView() const {
+		return _capacity == 0;
+	}
+	// Changing a view would change (or free) the elements of the tuple it refers to
+	void checkNotView() const {
+		if (isView()) {
+			throwViewChanged();
+		}
+	}
+	static void throwViewChanged();
+	void reserve(unsigned int capacity);
+	void assign(const_iterator begin, const_iterator end);
+
+public:
+	SmallElementTuple()
+			: 	_size(0),
+				_capacity(INLINESIZE),
+				_heap(NULL) {
+	}
+	explicit SmallElementTuple(unsigned int size, const DomainElement* value = NULL);
+	SmallElementTuple(const ElementTuple& tuple);
+	SmallElementTuple(std::initializer_list<const DomainElement*> elements);
+	SmallElementTuple(const SmallElementTuple& other);
+	SmallElementTuple(SmallElementTuple&& other);
+	SmallElementTuple& operator=(const SmallElementTuple& other);
+	SmallElementTuple& operator=(SmallElementTuple&& other);
+	~SmallElementTuple() {
+		if (not isView()) {
+			delete[] _heap;
+		}
+	}
+
+	/**
+	 * Returns a tuple which refers to the elements of the given tuple instead of copying them,
+	 * to search containers keyed on small tuples without allocating, whatever the arity.
+	 * NOTE: only valid as long as the given tuple is not changed or destroyed. Copies of the view own their elements.
+	 * Changing the view throws an IdpException, only moving another tuple into it is allowed.
+	 */
+	static SmallElementTuple view(const ElementTuple& tuple);
+
+	unsigned int size() const {
+		return _size;
+	}
+	bool empty() const {
+		return _size == 0;
+	}
+	const DomainElement* operator[](unsigned int index) const {
+		return data()[index];
+	}
+	const DomainElement*& operator[](unsigned int index) {
+		checkNotView();
+		return data()[index];
+	}
+	const_iterator cbegin() const {
+		return data();
+	}
+	const_iterator cend() const {
+		return data() + _size;
+	}
+	const_iterator begin() const {
+		return cbegin();
+	}
+	const_iterator end() const {
+		return cend();
+	}
+
+	void push_back(const DomainElement* element) {
+		checkNotView();
+		if (_size == _capacity) {
+			reserve(2 * _capacity);
+		}
+		data()[_size++] = element;
+	}
+	void clear() {
+		checkNotView();
+		_size = 0;
+	}
+
+	ElementTuple toVector() const {
+		return ElementTuple(cbegin(), cend());
+	}
+	//! Number of bytes allocated on the heap by this tuple
+	size_t heapBytes() const {
+		return _heap == NULL ? 0 : _capacity * sizeof(const DomainElement*);
+	}
+
+	bool operator==(const SmallElementTuple& other) const;
+	bool operator!=(const SmallElementTuple& other) const {
+		return not (*this == other);
+	}
+	//! Lexicographic order on the addresses of the elements (as std::vector)
+	bool operator<(const SmallElementTuple& other) const;
+
+	std::ostream& put(std::ostream& stream) const;
+
+	static size_t nbHeapAllocations() {
+		return _nbheapallocations;
+	}
+};
+
+#endif /* SMALLELEMENTTUPLE_HPP_ */
@@ -22,12 +22,14 @@ using namespace std;
 Structure::Structure(const std::string& name, const ParseInfo& pi)
 		: _name(name),
 			_pi(pi),
-			_vocabulary(NULL) {
+			_vocabulary(NULL),
+			_trackchanges(false) {
 }
 Structure::Structure(const std::string& name, Vocabulary* v, const ParseInfo& pi)
 		: _name(name),
 			_pi(pi),
-			_vocabulary(NULL) {
+			_vocabulary(NULL),
+			_trackchanges(false) {
 	changeVocabulary(v);
 }
 
@@ -64,6 +66,9 @@ Structure* Structure::clone() const {
 	for (auto it = _funcinter.begin(); it != _funcinter.end(); ++it) {
 		s->changeInter(it->first, it->second->clone(s->inter(it->first)->universe()));
 	}
+	s->_trackchanges = _trackchanges;
+	s->_uncleaned = _uncleaned;
+	s->_unmaterialized = _unmaterialized;
 	return s;
 }
 
@@ -77,6 +82,7 @@ void Structure::notifyAddedToVoc(Sort* sort) {
 		vector<SortTable*> univ(1, st);
 		auto pt = new PredTable(new FullInternalPredTable(), Universe(univ));
 		_predinter[sort->pred()] = new PredInter(pt, true);
+		notifyAllChanged();
 	}
 }
 void Structure::notifyAddedToVoc(PFSymbol* symbol) {
@@ -90,6 +96,7 @@ void Structure::notifyAddedToVoc(PFSymbol* symbol) {
 					univ.push_back(inter(*kt));
 				}
 				_funcinter[(*jt)] = TableUtils::leastFuncInter(Universe(univ));
+				notifyChanged(*jt);
 			}
 		}
 	} else {
@@ -102,6 +109,7 @@ void Structure::notifyAddedToVoc(PFSymbol* symbol) {
 					univ.push_back(inter(*kt));
 				}
 				_predinter[*jt] = TableUtils::leastPredInter(Universe(univ));
+				notifyChanged(*jt);
 			}
 		}
 	}
@@ -172,6 +180,7 @@ void Structure::changeVocabulary(Vocabulary* v) {
 				_sortinter[sort] = st;
 				auto pt = new PredTable(new FullInternalPredTable(), Universe({st}));
 				_predinter[sort->pred()] = new PredInter(pt, true);
+				notifyAllChanged();
 			}
 		}
 	}
@@ -198,6 +207,7 @@ void Structure::createPredAndFuncTables(bool forced) {
 					univ.push_back(inter(kt));
 				}
 				_predinter[nonOverloadedPred] = TableUtils::leastPredInter(Universe(univ));
+				notifyChanged(nonOverloadedPred);
 			}
 		}
 	}
@@ -210,6 +220,7 @@ void Structure::createPredAndFuncTables(bool forced) {
 					univ.push_back(inter(*kt));
 				}
 				_funcinter[(*jt)] = TableUtils::leastFuncInter(Universe(univ));
+				notifyChanged(*jt);
 			}
 		}
 	}
@@ -218,18 +229,21 @@ void Structure::createPredAndFuncTables(bool forced) {
 void Structure::changeInter(Sort* f, SortTable* i) {
 	Assert(_sortinter[f]!=NULL);
 	_sortinter[f]->internTable(i->internTable());
+	notifyAllChanged();
 }
 
 void Structure::changeInter(Predicate* p, PredInter* i) {
 	Assert(_predinter[p]!=NULL);
 	delete (_predinter[p]);
 	_predinter[p] = i;
+	notifyChanged(p);
 }
 
 void Structure::changeInter(Function* f, FuncInter* i) {
 	Assert(_funcinter[f]!=NULL);
 	delete (_funcinter[f]);
 	_funcinter[f] = i;
+	notifyChanged(f);
 }
 
 bool Structure::approxTwoValued() const {
@@ -284,6 +298,7 @@ void makeUnknownsFalse(PredInter* inter) {
 }
 
 void makeUnknownsFalse(Structure* structure){
+	structure->notifyAllChanged();
 	for (auto pred : structure->vocabulary()->getPreds()) {
 		for (auto predToSet : pred.second->nonbuiltins()) {
 			makeUnknownsFalse(structure->inter(predToSet));
@@ -372,6 +387,7 @@ void Structure::makeTwoValued() {
 	if (approxTwoValued()) {
 		return;
 	}
+	notifyAllChanged();
 	for (auto f2inter : _funcinter) {
 		CHECKTERMINATION;
 		::makeTwoValued(f2inter.first, f2inter.second);
@@ -463,6 +479,7 @@ void Structure::checkAndAutocomplete() {
 		ss <<"Verifying and/or autocompleting structure " <<name();
 		Warning::warning(ss.str());
 	}
+	notifyAllChanged(); // Sorts might be extended
 	// Adding elements from predicate interpretations to sorts
 	for (auto it = _predinter.cbegin(); it != _predinter.cend(); ++it) {
 		auto pred = it->first;
@@ -799,19 +816,61 @@ Universe Structure::universe(const PFSymbol* s) const {
 	return Universe(vst);
 }
 
+void Structure::trackChanges(bool track) {
+	_trackchanges = track;
+	if (not track) {
+		notifyAllChanged();
+	}
+}
+
+void Structure::notifyChanged(PFSymbol* symbol) {
+	if (symbol->isPredicate()) {
+		auto pred = dynamic_cast<Predicate*>(symbol);
+		if (pred->type() != ST_NONE) { // Changing the ct, cf, pt or pf table changes the parent
+			symbol = pred->parent();
+		}
+	}
+	_uncleaned.add(symbol);
+	_unmaterialized.add(symbol);
+}
+
+void Structure::notifyAllChanged() {
+	_uncleaned.addAll();
+	_unmaterialized.addAll();
+}
+
 // TODO new name and document
 void Structure::materialize() {
-	for (auto it = _sortinter.cbegin(); it != _sortinter.cend(); ++it) {
-		SortTable* st = it->second->materialize();
-		if (st != NULL) {
-			_sortinter[it->first] = st;
+	if (_unmaterialized.all) {
+		for (auto it = _sortinter.cbegin(); it != _sortinter.cend(); ++it) {
+			SortTable* st = it->second->materialize();
+			if (st != NULL) {
+				_sortinter[it->first] = st;
+			}
+		}
+		for (auto it = _predinter.cbegin(); it != _predinter.cend(); ++it) {
+			it->second->materialize();
+		}
+		for (auto it = _funcinter.cbegin(); it != _funcinter.cend(); ++it) {
+			it->second->materialize();
+		}
+	} else { // Sorts only change through changeInter or autocompletion, which mark all symbols as changed
+		for (auto symbol : _unmaterialized.symbols) {
+			if (symbol->isFunction()) {
+				auto it = _funcinter.find(dynamic_cast<Function*>(symbol));
+				if (it != _funcinter.cend()) {
+					it->second->materialize();
+				}
+			} else {
+				auto it = _predinter.find(dynamic_cast<Predicate*>(symbol));
+				if (it != _predinter.cend()) {
+					it->second->materialize();
+				}
+			}
 		}
 	}
-	for (auto it = _predinter.cbegin(); it != _predinter.cend(); ++it) {
-		it->second->materialize();
-	}
-	for (auto it = _funcinter.cbegin(); it != _funcinter.cend(); ++it) {
-		it->second->materialize();
+	if (_trackchanges) {
+		_unmaterialized.clear();
 	}
 }
 
@@ -867,10 +926,29 @@ void clean(Function* function, FuncInter* inter){
 
 //TODO Shouldn't this be approxClean?
 void Structure::clean() {
-	for (auto it = _predinter.cbegin(); it != _predinter.cend(); ++it) {
-		::clean(it->first, it->second);
+	if (_uncleaned.all) {
+		for (auto it = _predinter.cbegin(); it != _predinter.cend(); ++it) {
+			::clean(it->first, it->second);
+		}
+		for (auto it = _funcinter.cbegin(); it != _funcinter.cend(); ++it) {
+			::clean(it->first, it->second);
+		}
+	} else {
+		for (auto symbol : _uncleaned.symbols) {
+			if (symbol->isFunction()) {
+				auto it = _funcinter.find(dynamic_cast<Function*>(symbol));
+				if (it != _funcinter.cend()) {
+					::clean(it->first, it->second);
+				}
+			} else {
+				auto it = _predinter.find(dynamic_cast<Predicate*>(symbol));
+				if (it != _predinter.cend()) {
+					::clean(it->first, it->second);
+				}
+			}
+		}
 	}
-	for (auto it = _funcinter.cbegin(); it != _funcinter.cend(); ++it) {
-		::clean(it->first, it->second);
+	if (_trackchanges) {
+		_uncleaned.clear();
 	}
 }
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <set>
 #include "common.hpp"
 #include "parseinfo.hpp"
 
@@ -26,6 +27,31 @@ class SortTable;
 class Vocabulary;
 class TableIterator;
 
+/**
+ * The symbols whose interpretation changed since some operation last visited them.
+ */
+struct ChangedSymbols {
+	bool all; //!< If true, every symbol has to be considered changed
+	std::set<PFSymbol*> symbols; //!< The changed symbols, only relevant if not all
+
+	ChangedSymbols()
+			: all(true) {
+	}
+	void add(PFSymbol* symbol) {
+		if (not all) {
+			symbols.insert(symbol);
+		}
+	}
+	void addAll() {
+		all = true;
+		symbols.clear();
+	}
+	void clear() {
+		all = false;
+		symbols.clear();
+	}
+};
+
 class Structure {
 private:
 	std::string _name; // The name of the structure
@@ -38,6 +64,11 @@ private:
 	mutable std::map<const Function*, FuncInter*> _fixedfuncinter; //!< The interpretations of the function symbols.
 
 	mutable std::vector<PredInter*> _intersToDelete; // Interpretations which were created and not yet deleted // TODO do this in a cleaner way!
+
+	bool _trackchanges; //!< If true, every change to an interpretation is reported with notifyChanged
+	ChangedSymbols _uncleaned; //!< Symbols which changed since the last clean
+	ChangedSymbols _unmaterialized; //!< Symbols which changed since the last materialize
+
 	void canIncrement(TableIterator & domainIterator) const;
 
 public:
@@ -62,6 +93,21 @@ public:
 
 	void clean(); //!< Try to represent two-valued interpretations by one table instead of two.
 	void materialize(); //!< Convert symbolic tables containing a finite number of tuples to enumerated tables.
+
+	/**
+	 * When tracking changes, the owner of the structure promises to report every change to an interpretation
+	 * with notifyChanged, so that clean and materialize only have to visit the changed symbols.
+	 * Otherwise (the default), clean and materialize always visit all symbols.
+	 * NOTE: a clone inherits the change tracking of the structure, so a clone of a cleaned, tracked structure
+	 * only cleans the symbols which change afterwards. Stop tracking before handing a structure to code
+	 * that does not report its changes.
+	 */
+	void trackChanges(bool track);
+	bool tracksChanges() const {
+		return _trackchanges;
+	}
+	void notifyChanged(PFSymbol* symbol); //!< Report that the interpretation of symbol changed
+	void notifyAllChanged(); //!< Report that (the interpretation of) any symbol or sort might have changed
 	void reset(); //<! resets pred- and func inters to a state where everyhing is unknown, and resets sorttables for all pred and func inters.
 	void createPredAndFuncTables(bool forced); //<! creates predicate and function tables. If forced is true, this is in fact a reset, otherwise, only tables for symbols without interpretation are created.
 
@@ -11,6 +11,7 @@
 
 #include <cmath> // double std::abs(double) and double std::pow(double,double)
 #include <cstdlib> // int std::abs(int)
+#include <algorithm>
 #include "IncludeComponents.hpp"
 #include "errorhandling/error.hpp"
 #include "utils/ListUtils.hpp"
@@ -96,6 +97,12 @@ bool SortTable::contains(const DomainElement* el) const {
 bool SortTable::isRange() const {
 	return _table->isRange();
 }
+bool SortTable::isIntRange() const {
+	if (isa<UnionInternalSortTable>(*_table) || not approxFinite() || empty()) {
+		return false;
+	}
+	return isRange() && first()->type() == DET_INT;
+}
 // NOTE: first and last are guaranteed NOT NULL if the table is not empty
 const DomainElement* SortTable::first() const {
 	Assert(not empty());
@@ -1547,6 +1554,9 @@ bool EnumeratedInternalPredTable::contains(const ElementTuple& tuple, const Univ
 EnumeratedInternalPredTable* EnumeratedInternalPredTable::add(const ElementTuple& tuple) {
 	if (_nrRefs <= 1) {
 		_table.insert(tuple);
+		delete (_statistics);
+		_statistics = NULL;
+		_indexes.clear();
 		return this;
 	} else {
 		SortedElementTable newtable = _table;
@@ -1569,6 +1579,9 @@ EnumeratedInternalPredTable* EnumeratedInternalPredTable::remove(const ElementTu
 	if (it != _table.cend()) {
 		if (_nrRefs == 1) {
 			_table.erase(it);
+			delete (_statistics);
+			_statistics = NULL;
+			_indexes.clear();
 			return this;
 		} else {
 			SortedElementTable newtable = _table;
@@ -1581,6 +1594,13 @@ EnumeratedInternalPredTable* EnumeratedInternalPredTable::remove(const ElementTu
 	}
 }
 
+const TableStatistics* EnumeratedInternalPredTable::statistics() const {
+	if (_statistics == NULL) {
+		_statistics = new TableStatistics(_table.cbegin(), _table.cend());
+	}
+	return _statistics;
+}
+
 /**
  * \brief Returns an iterator on the first tuple of the table
  */
@@ -1836,70 +1856,157 @@ InternalTableIterator* InternalSortTable::begin() const {
 	return new SortInternalTableIterator(sortBegin());
 }
 
+EnumeratedInternalSortTable::EnumeratedInternalSortTable(const SortedElementTuple& d)
+		: 	_elements(d.cbegin(), d.cend()),
+			_sorted(true), // A SortedElementTuple is ordered on the values of its elements
+			nbNotIntElements(0),
+			_minint(0),
+			_maxint(0) {
+	for (unsigned int i = 0; i < _elements.size(); ++i) {
+		_ranks[_elements[i]] = i;
+	}
+	countNBNotIntElements();
+}
+
+EnumeratedInternalSortTable::EnumeratedInternalSortTable(const EnumeratedInternalSortTable& other)
+		: 	InternalSortTable(other),
+			_elements(other._elements),
+			_ranks(other._ranks),
+			_sorted(other._sorted),
+			nbNotIntElements(other.nbNotIntElements),
+			_minint(other._minint),
+			_maxint(other._maxint) {
+}
+
+EnumInternalSortIterator::EnumInternalSortIterator(const EnumeratedInternalSortTable* table,
+		std::vector<const DomainElement*>::const_iterator it, std::vector<const DomainElement*>::const_iterator end)
+		: 	_table(table),
+			_iter(it),
+			_end(end) {
+	const_cast<EnumeratedInternalSortTable*>(_table)->incrementRef();
+}
+
+EnumInternalSortIterator::~EnumInternalSortIterator() {
+	const_cast<EnumeratedInternalSortTable*>(_table)->decrementRef();
+}
+
 bool EnumeratedInternalSortTable::contains(const DomainElement* d) const {
 	if (d == NULL) {
 		return false;
 	}
-	return _table.find(d) != _table.cend();
+	return _ranks.find(d) != _ranks.cend();
+}
+
+void EnumeratedInternalSortTable::sort() const {
+	if (_sorted) {
+		return;
+	}
+	std::sort(_elements.begin(), _elements.end(), Compare<DomainElement>());
+	for (unsigned int i = 0; i < _elements.size(); ++i) {
+		_ranks[_elements[i]] = i;
+	}
+	_sorted = true;
+}
+
+void EnumeratedInternalSortTable::insert(const DomainElement* d) {
+	if (not _ranks.insert( { d, _elements.size() }).second) {
+		return;
+	}
+	if (d->type() != DET_INT) {
+		nbNotIntElements++;
+	} else if (_elements.size() == (size_t) nbNotIntElements) { // The first integer
+		_minint = _maxint = d->value()._int;
+	} else {
+		_minint = min(_minint, d->value()._int);
+		_maxint = max(_maxint, d->value()._int);
+	}
+	// Appending the largest element keeps the order
+	_sorted = _sorted && (_elements.empty() || *_elements.back() < *d);
+	_elements.push_back(d);
+}
+
+long long EnumeratedInternalSortTable::rank(const DomainElement* d) const {
+	sort();
+	auto it = _ranks.find(d);
+	return it == _ranks.cend() ? -1 : it->second;
+}
+
+const DomainElement* EnumeratedInternalSortTable::element(unsigned int rank) const {
+	sort();
+	Assert(rank < _elements.size());
+	return _elements[rank];
 }
 
 bool EnumeratedInternalSortTable::isRange() const {
-	if (_table.empty() || nbNotIntElements > 0) {
+	if (_elements.empty() || nbNotIntElements > 0) {
 		return false;
 	}
-	auto f = first();
-	auto l = last();
-	Assert(f->type() == DET_INT && l->type() == DET_INT);
-	// (and in fact all in between)
-	return l->value()._int - f->value()._int == (int) _table.size() - 1;
+	// The elements are distinct, so they fill the interval between the bounds if there are as many
+	return (long long) _maxint - _minint == (long long) _elements.size() - 1;
 }
 
 void EnumeratedInternalSortTable::addNonRange(const DomainElement* elem, int start, int end) {
-	if (elem->type() != DomainElementType::DET_INT) {
-		nbNotIntElements++;
-	}
-	_table.insert(elem);
 	for (auto i = start; i <= end; ++i) {
-		_table.insert(createDomElem(i));
+		insert(createDomElem(i));
 	}
+	insert(elem);
 }
 void EnumeratedInternalSortTable::addNonRange(int start1, int end1, int start2, int end2) {
+	if (start2 < start1) {
+		std::swap(start1, start2);
+		std::swap(end1, end2);
+	}
 	for (auto i = start1; i <= end1; ++i) {
-		_table.insert(createDomElem(i));
+		insert(createDomElem(i));
 	}
 	for (auto i = start2; i <= end2; ++i) {
-		_table.insert(createDomElem(i));
+		insert(createDomElem(i));
 	}
 }
 
 InternalSortIterator* EnumeratedInternalSortTable::sortBegin() const {
-	return new EnumInternalSortIterator(_table.cbegin(), _table.cend());
+	sort();
+	return new EnumInternalSortIterator(this, _elements.cbegin(), _elements.cend());
 }
 
 InternalSortIterator* EnumeratedInternalSortTable::sortIterator(const DomainElement* d) const {
-	return new EnumInternalSortIterator(_table.find(d), _table.cend());
+	auto r = rank(d);
+	return new EnumInternalSortIterator(this, r < 0 ? _elements.cend() : _elements.cbegin() + r, _elements.cend());
 }
 
 InternalSortTable* EnumeratedInternalSortTable::add(int i1, int i2) {
-	if (_table.empty()) {
+	if (_elements.empty()) {
 		return new IntRangeInternalSortTable(i1, i2);
 	}
 	if (isRange()
-			&& ((i1 >= first()->value()._int - 1 && i1 <= last()->value()._int + 1) || (i2 >= first()->value()._int - 1 && i2 <= last()->value()._int + 1))) { // TODO overflow checks
-		auto intst = new IntRangeInternalSortTable(first()->value()._int, last()->value()._int);
+			&& (((long long) i1 >= (long long) _minint - 1 && (long long) i1 <= (long long) _maxint + 1)
+					|| ((long long) i2 >= (long long) _minint - 1 && (long long) i2 <= (long long) _maxint + 1))) {
+		auto intst = new IntRangeInternalSortTable(_minint, _maxint);
 		return intst->add(i1, i2);
 	}
+	if (_nrRefs > 1) {
+		auto ist = new EnumeratedInternalSortTable(*this);
+		ist->_nrRefs = 0;
+		return ist->add(i1, i2);
+	}
 	for (auto i = min(i1, i2); i <= max(i1, i2); ++i) {
-		_table.insert(createDomElem(i));
+		insert(createDomElem(i));
 	}
 	return this;
 }
 
 void EnumeratedInternalSortTable::countNBNotIntElements(){
 	nbNotIntElements = 0;
-	for(auto el: _table){
+	bool firstint = true;
+	for(auto el: _elements){
 		if(el->type() != DET_INT){
 			nbNotIntElements++;
+		} else if (firstint) {
+			_minint = _maxint = el->value()._int;
+			firstint = false;
+		} else {
+			_minint = min(_minint, el->value()._int);
+			_maxint = max(_maxint, el->value()._int);
 		}
 	}
 }
@@ -1909,24 +2016,22 @@ InternalSortTable* EnumeratedInternalSortTable::add(const DomainElement* d) {
 		return this;
 	}
 	if (d->type() == DomainElementType::DET_INT) {
-		if (_table.empty()) {
+		if (_elements.empty()) {
 			return new IntRangeInternalSortTable(d->value()._int, d->value()._int);
 		}
-		if (isRange() && d->value()._int >= first()->value()._int - 1 && d->value()._int <= last()->value()._int + 1) { // TODO overflow checks
-			auto intst = new IntRangeInternalSortTable(first()->value()._int, last()->value()._int);
+		if (isRange() && (long long) d->value()._int >= (long long) _minint - 1 && (long long) d->value()._int <= (long long) _maxint + 1) {
+			auto intst = new IntRangeInternalSortTable(_minint, _maxint);
 			return intst->add(d);
 		}
 	}
 
 	if (_nrRefs > 1) {
-		auto ist = new EnumeratedInternalSortTable(_table);
+		auto ist = new EnumeratedInternalSortTable(*this);
+		ist->_nrRefs = 0;
 		ist->add(d);
 		return ist;
 	} else {
-		if (d->type() != DomainElementType::DET_INT) {
-			nbNotIntElements++;
-		}
-		_table.insert(d);
+		insert(d);
 		return this;
 	}
 }
@@ -1936,30 +2041,37 @@ InternalSortTable* EnumeratedInternalSortTable::remove(const DomainElement* d) {
 		return this;
 	}
 	if (_nrRefs > 1) {
-		auto ist = new EnumeratedInternalSortTable(_table);
+		auto ist = new EnumeratedInternalSortTable(*this);
+		ist->_nrRefs = 0;
 		ist->remove(d);
 		return ist;
 	} else {
+		_elements.erase(std::find(_elements.begin(), _elements.end(), d));
+		_ranks.erase(d);
+		_sorted = false; // The order is kept, but the numbers of the larger elements change
 		if (d->type() != DomainElementType::DET_INT) {
 			nbNotIntElements--;
+		} else if (d->value()._int == _minint || d->value()._int == _maxint) { // The scan costs no more than the erase
+			countNBNotIntElements();
 		}
-		_table.erase(d);
 		return this;
 	}
 }
 
 const DomainElement* EnumeratedInternalSortTable::first() const {
-	if (_table.empty()) {
+	if (_elements.empty()) {
 		return NULL;
 	}
-	return *(_table.cbegin());
+	sort();
+	return _elements.front();
 }
 
 const DomainElement* EnumeratedInternalSortTable::last() const {
-	if (_table.empty()) {
+	if (_elements.empty()) {
 		return NULL;
 	}
-	return *(_table.rbegin());
+	sort();
+	return _elements.back();
 }
 
 bool recursivelyConstructed(Sort* sort, const std::set<Sort*>& seensorts) {
@@ -2862,6 +2974,9 @@ EnumeratedInternalFuncTable* EnumeratedInternalFuncTable::add(const ElementTuple
 			return new EnumeratedInternalFuncTable(newtable); // TODO memory leak
 		} else {
 			_table[key] = mappedvalue;
+			delete (_statistics);
+			_statistics = NULL;
+			_indexes.clear();
 			return this;
 		}
 	}
@@ -2884,6 +2999,9 @@ EnumeratedInternalFuncTable* EnumeratedInternalFuncTable::remove(const ElementTu
 			return new EnumeratedInternalFuncTable(newtable);
 		} else {
 			_table.erase(key);
+			delete (_statistics);
+			_statistics = NULL;
+			_indexes.clear();
 			return this;
 		}
 	} else {
@@ -2891,6 +3009,13 @@ EnumeratedInternalFuncTable* EnumeratedInternalFuncTable::remove(const ElementTu
 	}
 }
 
+const TableStatistics* EnumeratedInternalFuncTable::statistics() const {
+	if (_statistics == NULL) {
+		_statistics = new TableStatistics(_table.cbegin(), _table.cend());
+	}
+	return _statistics;
+}
+
 InternalTableIterator* EnumeratedInternalFuncTable::begin(const Universe&) const {
 	return new EnumInternalFuncIterator(_table.cbegin(), _table.cend());
 }
@@ -22,6 +22,8 @@
 #include "utils/NumericLimits.hpp"
 #include "MainStructureComponents.hpp"
 #include "Structure.hpp"
+#include "TableStatistics.hpp"
+#include "TableIndexes.hpp"
 
 /**
  * NAMING CONVENTION
@@ -426,11 +428,14 @@ public:
 	}
 };
 
-// TODO danger of not detecting iterator invalidation when the sortedelementtuple is changed in the associated table
+class EnumeratedInternalSortTable;
+
+// NOTE: the associated table cannot be changed while the iterator lives, as that can move or reorder its elements (asserted)
 class EnumInternalSortIterator: public InternalSortIterator {
 private:
-	SortedElementTuple::const_iterator _iter;
-	SortedElementTuple::const_iterator _end;
+	const EnumeratedInternalSortTable* _table; //!< Referenced by the iterator, such that it is neither deleted nor changed in place while iterating
+	std::vector<const DomainElement*>::const_iterator _iter;
+	std::vector<const DomainElement*>::const_iterator _end;
 	bool hasNext() const {
 		return _iter != _end;
 	}
@@ -441,13 +446,11 @@ private:
 		++_iter;
 	}
 public:
-	EnumInternalSortIterator(SortedElementTuple::iterator it, SortedElementTuple::iterator end) :
-			_iter(it), _end(end) {
-	}
-	~EnumInternalSortIterator() {
-	}
+	EnumInternalSortIterator(const EnumeratedInternalSortTable* table, std::vector<const DomainElement*>::const_iterator it,
+			std::vector<const DomainElement*>::const_iterator end);
+	~EnumInternalSortIterator();
 	EnumInternalSortIterator* clone() const {
-		return new EnumInternalSortIterator(_iter, _end);
+		return new EnumInternalSortIterator(_table, _iter, _end);
 	}
 };
 
@@ -751,6 +754,8 @@ public:
 class EnumeratedInternalPredTable: public InternalPredTable {
 private:
 	SortedElementTable _table; //!< the actual table
+	mutable TableStatistics* _statistics; //!< cached statistics of _table, NULL if not yet calculated
+	mutable TableIndexes _indexes; //!< cached lookup tables on _table
 
 	bool finite(const Universe&) const {
 		return true;
@@ -774,16 +779,22 @@ private:
 
 public:
 	EnumeratedInternalPredTable(const SortedElementTable& tab) :
-			InternalPredTable(), _table(tab) {
+			InternalPredTable(), _table(tab), _statistics(NULL) {
 	}
 	EnumeratedInternalPredTable() :
-			InternalPredTable() {
+			InternalPredTable(), _statistics(NULL) {
 	}
 	~EnumeratedInternalPredTable() {
+		delete (_statistics);
 	}
 	EnumeratedInternalPredTable* add(const ElementTuple& tuple);
 	EnumeratedInternalPredTable* remove(const ElementTuple& tuple);
 
+	const TableStatistics* statistics() const; //!< Calculated on first use, invalidated when the table changes
+	TableIndexes& indexes() const { //!< Cleared when the table changes
+		return _indexes;
+	}
+
 	// Visitor
 	void accept(StructureVisitor* v) const;
 };
@@ -1274,13 +1285,24 @@ class IntRangeInternalSortTable;
 
 /**
  *	A finite, enumerated SortTable
+ *	The elements are numbered densely: element i is the i'th smallest element of the table.
+ *	Elements are stored contiguously in that order, and a hash map from (interned) elements to their number
+ *	gives constant time membership tests. Adding elements only appends them, the order and numbering are restored
+ *	the first time they are needed, so a table can be filled one element at a time without quadratic cost.
+ *	The bounds of the integer elements are kept up to date as well, so range checks never sort.
+ *	NOTE: an iterator holds a reference to its table, so changing the table while iterating over it changes a copy,
+ *	and the iterator keeps iterating over the elements it started with (see EnumInternalSortIterator).
  */
 class EnumeratedInternalSortTable: public InternalSortTable {
 private:
-	SortedElementTuple _table;
+	mutable std::vector<const DomainElement*> _elements; //!< The elements, ordered on their value if _sorted
+	mutable std::unordered_map<const DomainElement*, unsigned int> _ranks; //!< Maps each element to its index in _elements, only valid if _sorted
+	mutable bool _sorted;
 	int nbNotIntElements; // Used for efficient range operations
-
+	int _minint, _maxint; //!< The smallest and largest integer element, only valid if there are any
 	bool contains(const DomainElement*) const;
+	void sort() const; //!< Orders _elements and renumbers them, if needed
+	void insert(const DomainElement*); //!< Adds the element if it is new, and counts it in nbNotIntElements or the integer bounds
 
 	InternalSortIterator* sortBegin() const;
 	InternalSortIterator* sortIterator(const DomainElement*) const;
@@ -1295,12 +1317,12 @@ private:
 		return true;
 	}
 	bool approxEmpty() const {
-		return _table.empty();
+		return _elements.empty();
 	}
 	tablesize size() const {
-		return tablesize(TST_EXACT, _table.size());
+		return tablesize(TST_EXACT, _elements.size());
 	}
-	void countNBNotIntElements();
+	void countNBNotIntElements(); //!< Recounts nbNotIntElements and recomputes the integer bounds
 
 protected:
 	// SortTable is responsible for ref management and deletion!
@@ -1312,13 +1334,14 @@ protected:
 	void addNonRange(int start1, int end1, int start2, int end2);
 
 public:
-	EnumeratedInternalSortTable(): nbNotIntElements(0) {
-	}
-	EnumeratedInternalSortTable(const SortedElementTuple& d)
-			: 	_table(d),
-				nbNotIntElements(0) {
-		countNBNotIntElements();
+	EnumeratedInternalSortTable()
+			: 	_sorted(true),
+				nbNotIntElements(0),
+				_minint(0),
+				_maxint(0) {
 	}
+	EnumeratedInternalSortTable(const EnumeratedInternalSortTable& other);
+	EnumeratedInternalSortTable(const SortedElementTuple& d);
 	InternalSortTable* add(const DomainElement*);
 	InternalSortTable* remove(const DomainElement*);
 	InternalSortTable* add(int i1, int i2);
@@ -1329,6 +1352,11 @@ public:
 	 */
 	bool isRange() const;
 
+	//! Returns the number (between 0 and size-1) of the given element, or -1 if it is not in the table
+	long long rank(const DomainElement*) const;
+	//! Returns the element with the given number
+	const DomainElement* element(unsigned int rank) const;
+
 	// Visitor
 	void accept(StructureVisitor* v) const;
 };
@@ -1552,14 +1580,17 @@ public:
 class EnumeratedInternalFuncTable: public InternalFuncTable {
 private:
 	Tuple2Elem _table;
+	mutable TableStatistics* _statistics; //!< cached statistics of the graph of _table, NULL if not yet calculated
+	mutable TableIndexes _indexes; //!< cached lookup tables on the graph of _table
 public:
 	EnumeratedInternalFuncTable() :
-			InternalFuncTable() {
+			InternalFuncTable(), _statistics(NULL) {
 	}
 	EnumeratedInternalFuncTable(const Tuple2Elem& tab) :
-			InternalFuncTable(), _table(tab) {
+			InternalFuncTable(), _table(tab), _statistics(NULL) {
 	}
 	virtual ~EnumeratedInternalFuncTable() {
+		delete (_statistics);
 	}
 
 	bool finite(const Universe&) const {
@@ -1582,6 +1613,11 @@ public:
 	EnumeratedInternalFuncTable* add(const ElementTuple&);
 	EnumeratedInternalFuncTable* remove(const ElementTuple&);
 
+	const TableStatistics* statistics() const; //!< Calculated on first use, invalidated when the table changes
+	TableIndexes& indexes() const { //!< Cleared when the table changes
+		return _indexes;
+	}
+
 	InternalTableIterator* begin(const Universe&) const;
 
 	// Visitor
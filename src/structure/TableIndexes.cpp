@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "TableIndexes.hpp"
+#include "GlobalData.hpp"
+
+using namespace std;
+
+size_t TableIndexes::_totalmemory = 0;
+
+size_t TableIndexes::estimateMemory(const LookupTable& index) {
+	size_t memory = sizeof(LookupTable) + index.bucket_count() * sizeof(void*);
+	for (auto i = index.cbegin(); i != index.cend(); ++i) {
+		memory += sizeof(*i) + i->first.heapBytes();
+		for (auto j = i->second.cbegin(); j < i->second.cend(); ++j) {
+			memory += sizeof(*j) + j->heapBytes();
+		}
+	}
+	return memory;
+}
+
+size_t TableIndexes::estimateMemory(const SortedTrie& trie) {
+	size_t memory = sizeof(SortedTrie);
+	for (auto i = trie.cbegin(); i < trie.cend(); ++i) {
+		memory += sizeof(*i) + i->capacity() * sizeof(const DomainElement*);
+	}
+	return memory;
+}
+
+// Accounts for memory additional bytes of cached data. Returns false, without accounting for them, if they do not fit under the cap
+bool TableIndexes::reserve(size_t memory) {
+	auto cap = (size_t) getOption(IntType::TABLEINDEXMEMORY) * 1024 * 1024;
+	if (_totalmemory + memory > cap) {
+		return false;
+	}
+	_memory += memory;
+	_totalmemory += memory;
+	return true;
+}
+
+shared_ptr<const LookupTable> TableIndexes::get(const IndexPattern& pattern) const {
+	auto it = _indexes.find(pattern);
+	if (it == _indexes.cend()) {
+		return shared_ptr<const LookupTable>();
+	}
+	return it->second;
+}
+
+void TableIndexes::add(const IndexPattern& pattern, shared_ptr<const LookupTable> index) {
+	Assert(_indexes.find(pattern) == _indexes.cend());
+	if (reserve(estimateMemory(*index))) {
+		_indexes[pattern] = index;
+	}
+}
+
+shared_ptr<const SortedTrie> TableIndexes::getTrie(const TriePattern& pattern) const {
+	auto it = _tries.find(pattern);
+	if (it == _tries.cend()) {
+		return shared_ptr<const SortedTrie>();
+	}
+	return it->second;
+}
+
+void TableIndexes::addTrie(const TriePattern& pattern, shared_ptr<const SortedTrie> trie) {
+	Assert(_tries.find(pattern) == _tries.cend());
+	if (reserve(estimateMemory(*trie))) {
+		_tries[pattern] = trie;
+	}
+}
+
+void TableIndexes::clear() {
+	_indexes.clear();
+	_tries.clear();
+	_totalmemory -= _memory;
+	_memory = 0;
+}
@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef TABLEINDEXES_HPP_
+#define TABLEINDEXES_HPP_
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include "Assert.hpp"
+#include "HashElementTuple.hpp"
+
+/**
+ * Maps the values of the input columns of a table to the values of its output columns.
+ * Uses small tuples, so indexes over tables of small arity do not allocate per tuple.
+ */
+typedef std::unordered_map<SmallElementTuple, std::vector<SmallElementTuple>, HashTuple> LookupTable;
+
+/**
+ * Describes which lookup table an index is: for each column of the table, INPUTCOLUMN, OUTPUTCOLUMN
+ * or the number of an earlier column it has to be equal to.
+ */
+typedef std::vector<int> IndexPattern;
+
+/**
+ * The tuples of a table with their columns permuted, sorted lexicographically on the values of their elements.
+ */
+typedef std::vector<ElementTuple> SortedTrie;
+
+/**
+ * Describes which trie a table is permuted into: for each column of the table, the column of the trie it ends up in.
+ * Columns mapped to the same trie column have to be equal, tuples for which they differ are not in the trie.
+ */
+typedef std::vector<unsigned int> TriePattern;
+
+/**
+ * Cache of the lookup tables and sorted tries built for an enumerated table, one for each pattern.
+ * The cache is cleared when its table changes. The estimated memory used by the indexes of all tables is capped by
+ * the option tableindexmemory (in Mb): an index that does not fit is still usable, but is not cached.
+ */
+class TableIndexes {
+private:
+	std::map<IndexPattern, std::shared_ptr<const LookupTable> > _indexes;
+	std::map<TriePattern, std::shared_ptr<const SortedTrie> > _tries;
+	size_t _memory; //!< Estimated number of bytes used by _indexes and _tries
+
+	static size_t _totalmemory; //!< Estimated number of bytes used by the cached indexes of all tables
+
+	static size_t estimateMemory(const LookupTable& index);
+	static size_t estimateMemory(const SortedTrie& trie);
+	bool reserve(size_t memory);
+
+public:
+	static const int INPUTCOLUMN = -1;
+	static const int OUTPUTCOLUMN = -2;
+
+	TableIndexes()
+			: _memory(0) {
+	}
+	// NOTE: the indexes belong to one table, so a copy starts empty
+	TableIndexes(const TableIndexes&)
+			: _memory(0) {
+	}
+	TableIndexes& operator=(const TableIndexes&) {
+		clear();
+		return *this;
+	}
+	~TableIndexes() {
+		clear();
+	}
+
+	//! Returns the cached index with the given pattern, NULL if there is none
+	std::shared_ptr<const LookupTable> get(const IndexPattern& pattern) const;
+	//! Caches the given index, unless that would exceed the memory cap
+	void add(const IndexPattern& pattern, std::shared_ptr<const LookupTable> index);
+	//! Returns the cached trie with the given pattern, NULL if there is none
+	std::shared_ptr<const SortedTrie> getTrie(const TriePattern& pattern) const;
+	//! Caches the given trie, unless that would exceed the memory cap
+	void addTrie(const TriePattern& pattern, std::shared_ptr<const SortedTrie> trie);
+	void clear();
+
+	//! Estimated number of bytes used by the cached indexes of all tables
+	static size_t totalMemory() {
+		return _totalmemory;
+	}
+};
+
+#endif /* TABLEINDEXES_HPP_ */
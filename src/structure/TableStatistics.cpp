@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "TableStatistics.hpp"
+#include <algorithm>
+#include "StructureComponents.hpp"
+
+using namespace std;
+
+void TableStatistics::count(const ElementTuple& tuple, ColumnCounts& counts) {
+	if (counts.size() < tuple.size()) {
+		counts.resize(tuple.size());
+	}
+	for (size_t n = 0; n < tuple.size(); ++n) {
+		++counts[n][tuple[n]];
+	}
+	++_size;
+}
+
+static bool moreFrequent(const pair<const DomainElement*, size_t>& first, const pair<const DomainElement*, size_t>& second) {
+	return first.second > second.second;
+}
+
+void TableStatistics::finish(const ColumnCounts& counts) {
+	_columns.resize(counts.size());
+	for (size_t n = 0; n < counts.size(); ++n) {
+		auto& column = _columns[n];
+		column.distinct = counts[n].size();
+		column.squaredfrequencies = 0;
+		for (auto valuecount : counts[n]) {
+			column.squaredfrequencies += (double) valuecount.second * valuecount.second;
+			column.heavyhitters.push_back(valuecount);
+			if (column.heavyhitters.size() > 2 * NRHEAVYHITTERS) { // Keep the candidates bounded
+				nth_element(column.heavyhitters.begin(), column.heavyhitters.begin() + NRHEAVYHITTERS, column.heavyhitters.end(), moreFrequent);
+				column.heavyhitters.resize(NRHEAVYHITTERS);
+			}
+		}
+		sort(column.heavyhitters.begin(), column.heavyhitters.end(), moreFrequent);
+		if (column.heavyhitters.size() > NRHEAVYHITTERS) {
+			column.heavyhitters.resize(NRHEAVYHITTERS);
+		}
+	}
+}
+
+double TableStatistics::selectivity(unsigned int column) const {
+	if (_size == 0 || column >= arity()) {
+		return 0;
+	}
+	return _columns[column].squaredfrequencies / ((double) _size * _size);
+}
+
+double TableStatistics::frequency(unsigned int column, const DomainElement* value) const {
+	if (_size == 0 || column >= arity()) {
+		return 0;
+	}
+	const auto& stats = _columns[column];
+	size_t hittersize = 0;
+	for (auto hitter : stats.heavyhitters) {
+		if (hitter.first == value) {
+			return hitter.second;
+		}
+		hittersize += hitter.second;
+	}
+	if (stats.distinct <= stats.heavyhitters.size()) {
+		return 0; // All values are heavy hitters, so value does not occur
+	}
+	return (double) (_size - hittersize) / (stats.distinct - stats.heavyhitters.size());
+}
+
+double TableStatistics::expectedMatches(const vector<bool>& pattern) const {
+	// NOTE: columns are assumed to be independent, but each column's own skew is taken into account
+	double result = _size;
+	for (size_t n = 0; n < pattern.size() && n < arity(); ++n) {
+		if (pattern[n]) {
+			result *= selectivity(n);
+		}
+	}
+	return result;
+}
+
+const TableStatistics* TableStatistics::get(const PredTable* table) {
+	auto intern = table->internTable();
+	if (isa<EnumeratedInternalPredTable>(*intern)) {
+		return dynamic_cast<const EnumeratedInternalPredTable*>(intern)->statistics();
+	}
+	if (isa<FuncInternalPredTable>(*intern)) {
+		auto functable = dynamic_cast<const FuncInternalPredTable*>(intern)->table()->internTable();
+		if (isa<EnumeratedInternalFuncTable>(*functable)) {
+			return dynamic_cast<const EnumeratedInternalFuncTable*>(functable)->statistics();
+		}
+	}
+	return NULL;
+}
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "commontypes.hpp"
+
+class DomainElement;
+class PredTable;
+
+/**
+ * Data statistics of the columns of an enumerated table, used to estimate the selectivity of lookups and joins.
+ * Instead of assuming the tuples are uniformly spread over the universe, the statistics capture skew:
+ * for each column, the number of distinct values, the sum of the squared frequencies of the values and the most frequent values.
+ */
+class TableStatistics {
+public:
+	static const unsigned int NRHEAVYHITTERS = 8; //!< Number of most frequent values stored per column
+
+	struct ColumnStatistics {
+		size_t distinct; //!< Number of distinct values in the column
+		double squaredfrequencies; //!< Sum over all values of the square of their number of occurrences
+		std::vector<std::pair<const DomainElement*, size_t> > heavyhitters; //!< The most frequent values and their frequency, most frequent first
+	};
+
+private:
+	typedef std::vector<std::unordered_map<const DomainElement*, size_t> > ColumnCounts;
+
+	size_t _size; //!< Number of tuples
+	std::vector<ColumnStatistics> _columns;
+
+public:
+	//! Computes the statistics in one pass over the tuples of a SortedElementTable or a Tuple2Elem
+	template<class Iterator>
+	TableStatistics(Iterator begin, Iterator end)
+			: _size(0) {
+		ColumnCounts counts;
+		for (auto it = begin; it != end; ++it) {
+			count(tuple(*it), counts);
+		}
+		finish(counts);
+	}
+
+	size_t size() const {
+		return _size;
+	}
+	unsigned int arity() const {
+		return _columns.size();
+	}
+	const ColumnStatistics& column(unsigned int n) const {
+		return _columns[n];
+	}
+
+	//! Probability that a tuple has a given value in the column, if that value is drawn from the values of the column itself.
+	//! Equals 1/distinct if all values are equally frequent, and is larger for skewed columns.
+	double selectivity(unsigned int column) const;
+	//! Estimated number of tuples that occur in the column with the given value.
+	double frequency(unsigned int column, const DomainElement* value) const;
+	//! Estimated number of tuples matching a lookup with the given input pattern (pattern[n] iff column n is input).
+	double expectedMatches(const std::vector<bool>& pattern) const;
+
+	//! Returns the (cached) statistics of the table, NULL if they are not available for this kind of table.
+	static const TableStatistics* get(const PredTable* table);
+
+private:
+	static const ElementTuple& tuple(const ElementTuple& tuple) {
+		return tuple;
+	}
+	static ElementTuple tuple(const std::pair<const ElementTuple, const DomainElement*>& mapping) {
+		auto result = mapping.first;
+		result.push_back(mapping.second);
+		return result;
+	}
+
+	void count(const ElementTuple& tuple, ColumnCounts& counts);
+	void finish(const ColumnCounts& counts);
+};
@@ -0,0 +1,223 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "TableView.hpp"
+#include <algorithm>
+#include "StructureComponents.hpp"
+#include "Universe.hpp"
+#include "errorhandling/IdpException.hpp"
+
+using namespace std;
+
+static vector<unsigned int> allColumns(unsigned int width) {
+	vector<unsigned int> columns;
+	for (unsigned int i = 0; i < width; ++i) {
+		columns.push_back(i);
+	}
+	return columns;
+}
+
+// Returns sort tables sharing the internal tables of those of the universe
+static vector<SortTable*> shareUniverse(const Universe& universe) {
+	vector<SortTable*> tables;
+	for (auto table : universe.tables()) {
+		tables.push_back(new SortTable(table->internTable()));
+	}
+	return tables;
+}
+
+TableView::SharedTable::SharedTable(const PredTable* table)
+		: 	sorttables(shareUniverse(table->universe())),
+			table(new PredTable(table->internTable(), Universe(sorttables))),
+			function(false) {
+}
+
+TableView::SharedTable::SharedTable(const FuncTable* table)
+		: 	sorttables(shareUniverse(table->universe())),
+			table(new FuncTable(table->internTable(), Universe(sorttables))),
+			function(true) {
+}
+
+TableView::SharedTable::~SharedTable() {
+	delete (table);
+	for (auto sorttable : sorttables) {
+		delete (sorttable);
+	}
+}
+
+TableView::TableView(shared_ptr<const SharedTable> shared, unsigned int width, const vector<unsigned int>& columns,
+		const vector<pair<unsigned int, const DomainElement*> >& filters)
+		: 	_shared(shared),
+			_table(shared->table),
+			_width(width),
+			_columns(columns),
+			_filters(filters),
+			_cursorindex(-1),
+			_current(columns.size(), NULL),
+			_count(-1) {
+}
+
+TableView::TableView(const PredTable* table)
+		: 	_shared(make_shared<const SharedTable>(table)),
+			_table(_shared->table),
+			_width(table->arity()),
+			_columns(allColumns(_width)),
+			_cursorindex(-1),
+			_current(_width, NULL),
+			_count(-1) {
+}
+
+TableView::TableView(const FuncTable* table)
+		: 	_shared(make_shared<const SharedTable>(table)),
+			_table(_shared->table),
+			_width(table->arity() + 1),
+			_columns(allColumns(_width)),
+			_cursorindex(-1),
+			_current(_width, NULL),
+			_count(-1) {
+}
+
+bool TableView::matches(const ElementTuple& tuple) const {
+	for (auto i = _filters.cbegin(); i < _filters.cend(); ++i) {
+		if (tuple[i->first] != i->second) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TableView::skipToMatch() const {
+	while (not _cursor.isAtEnd() && not matches(*_cursor)) {
+		++_cursor;
+	}
+}
+
+void TableView::projectCurrent() const {
+	if (_cursor.isAtEnd()) {
+		return;
+	}
+	const auto& tuple = *_cursor;
+	for (size_t i = 0; i < _columns.size(); ++i) {
+		_current[i] = tuple[_columns[i]];
+	}
+}
+
+void TableView::resetCursor() const {
+	if (not _table->finite()) {
+		throw IdpException("Cannot iterate over an infinite table.");
+	}
+	_cursor = _table->begin();
+	_cursorindex = 0;
+	skipToMatch();
+	projectCurrent();
+}
+
+long long TableView::size() const {
+	if (_count >= 0) {
+		return _count;
+	}
+	if (not _table->finite()) {
+		throw IdpException("Cannot count the tuples of an infinite table.");
+	}
+	long long count = 0;
+	for (auto it = _table->begin(); not it.isAtEnd(); ++it) {
+		if (matches(*it)) {
+			++count;
+		}
+	}
+	_count = count;
+	return _count;
+}
+
+const ElementTuple* TableView::tuple(long long index) const {
+	if (index < 0 || (_count >= 0 && index >= _count)) {
+		return NULL;
+	}
+	if (_cursorindex < 0 || index < _cursorindex) {
+		resetCursor();
+	}
+	while (_cursorindex < index && not _cursor.isAtEnd()) {
+		++_cursor;
+		skipToMatch();
+		++_cursorindex;
+	}
+	if (_cursor.isAtEnd()) {
+		return NULL;
+	}
+	projectCurrent();
+	return &_current;
+}
+
+const DomainElement* TableView::element(long long index, unsigned int column) const {
+	if (column >= arity()) {
+		return NULL;
+	}
+	auto result = tuple(index);
+	return result == NULL ? NULL : (*result)[column];
+}
+
+bool TableView::contains(const ElementTuple& tuple) const {
+	if (tuple.size() != arity()) {
+		return false;
+	}
+	if (_columns.size() == _width) { // Possibly a permutation of all columns, then the underlying table can answer directly
+		ElementTuple full(_width, NULL);
+		for (size_t i = 0; i < _columns.size(); ++i) {
+			full[_columns[i]] = tuple[i];
+		}
+		if (find(full.cbegin(), full.cend(), (const DomainElement*) NULL) == full.cend()) {
+			return matches(full) && _table->contains(full);
+		}
+	}
+	for (auto it = _table->begin(); not it.isAtEnd(); ++it) {
+		const auto& full = *it;
+		if (not matches(full)) {
+			continue;
+		}
+		bool equal = true;
+		for (size_t i = 0; i < _columns.size() && equal; ++i) {
+			equal = full[_columns[i]] == tuple[i];
+		}
+		if (equal) {
+			return true;
+		}
+	}
+	return false;
+}
+
+TableView* TableView::project(const vector<unsigned int>& columns) const {
+	vector<unsigned int> newcolumns;
+	for (auto i = columns.cbegin(); i < columns.cend(); ++i) {
+		if (*i >= arity()) {
+			throw IdpException("Cannot project a table on a column it does not have.");
+		}
+		newcolumns.push_back(_columns[*i]);
+	}
+	auto result = new TableView(_shared, _width, newcolumns, _filters);
+	result->_count = _count; // Projection does not remove tuples
+	return result;
+}
+
+TableView* TableView::filter(unsigned int column, const DomainElement* value) const {
+	if (column >= arity()) {
+		throw IdpException("Cannot filter a table on a column it does not have.");
+	}
+	auto newfilters = _filters;
+	newfilters.push_back( { _columns[column], value });
+	return new TableView(_shared, _width, _columns, newfilters);
+}
+
+void TableView::put(std::ostream& stream) const {
+	stream << "view of " << arity() << " column(s)";
+	if (not _filters.empty()) {
+		stream << " with " << _filters.size() << " filter(s)";
+	}
+}
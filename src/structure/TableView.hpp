@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef TABLEVIEW_HPP_
+#define TABLEVIEW_HPP_
+
+#include <memory>
+#include <vector>
+#include "MainStructureComponents.hpp"
+
+/**
+ * Lazy view on a two-valued predicate or function table.
+ * A view never copies the underlying table: it only remembers which columns are visible and which values
+ * the tuples have to match, and produces the (projected) tuples on demand.
+ * Indexed access reuses a cursor, so iterating over indices 1..n is linear in the size of the table.
+ *
+ * A view shares the internal tables of the table (and its universe) it was created on, like a copy of that table would.
+ * It hence stays valid when the structure of the table is deleted, and does not see later changes to the table,
+ * which copy the shared internal table first.
+ */
+class TableView {
+private:
+	//! A table sharing the internal tables of the viewed table and of its universe, shared by a view and the views derived from it
+	struct SharedTable {
+		std::vector<SortTable*> sorttables;
+		AbstractTable* table;
+		bool function;
+
+		SharedTable(const PredTable* table);
+		SharedTable(const FuncTable* table);
+		~SharedTable();
+	};
+
+	std::shared_ptr<const SharedTable> _shared;
+	const AbstractTable* _table; //!< The viewed table, owned by _shared
+	unsigned int _width; //!< Number of columns in the tuples of _table (including the image for function tables)
+	std::vector<unsigned int> _columns; //!< The visible columns of _table, in order
+	std::vector<std::pair<unsigned int, const DomainElement*> > _filters; //!< (column, value) pairs every visible tuple matches
+
+	mutable TableIterator _cursor;
+	mutable long long _cursorindex; //!< The index of the tuple _cursor points to, -1 if the cursor is not initialized
+	mutable ElementTuple _current; //!< The projection of the tuple _cursor points to
+	mutable long long _count; //!< Cached number of visible tuples, -1 if not yet calculated
+
+	TableView(std::shared_ptr<const SharedTable> shared, unsigned int width, const std::vector<unsigned int>& columns,
+			const std::vector<std::pair<unsigned int, const DomainElement*> >& filters);
+
+	bool matches(const ElementTuple& tuple) const;
+	void skipToMatch() const;
+	void projectCurrent() const;
+	void resetCursor() const;
+
+public:
+	TableView(const PredTable* table);
+	TableView(const FuncTable* table);
+	TableView(const TableView&) = delete;
+	TableView& operator=(const TableView&) = delete;
+
+	//! Number of columns of the visible tuples
+	unsigned int arity() const {
+		return _columns.size();
+	}
+	bool finite() const {
+		return _table->finite();
+	}
+	//! Whether the view is on the graph of a function table
+	bool function() const {
+		return _shared->function;
+	}
+	//! Number of visible tuples. NOTE: tuples of a projected view are not made unique.
+	long long size() const;
+	//! Returns the visible tuple with the given zero-based index, NULL if there is no such tuple.
+	//! NOTE: the result is only valid until the next call to tuple().
+	const ElementTuple* tuple(long long index) const;
+	//! Returns the element in the given (zero-based, visible) column of the tuple with the given index, NULL if there is no such tuple.
+	const DomainElement* element(long long index, unsigned int column) const;
+	//! Returns true iff some visible tuple equals the given one
+	bool contains(const ElementTuple& tuple) const;
+
+	//! Returns a new view showing only the given (zero-based, visible) columns
+	TableView* project(const std::vector<unsigned int>& columns) const;
+	//! Returns a new view showing only the tuples which have the given value in the given (zero-based, visible) column
+	TableView* filter(unsigned int column, const DomainElement* value) const;
+
+	void put(std::ostream& stream) const;
+};
+
+#endif /* TABLEVIEW_HPP_ */
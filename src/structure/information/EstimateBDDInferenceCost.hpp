@@ -136,31 +136,41 @@ public:
 		}
 	}
 
-	void getEnumeratedTableCost(bool function) {
-		auto sz = getTableCost(function);
+	/**
+	 * The cost of a lookup of the input columns plus the cost of iterating over the matching tuples.
+	 * The number of matching tuples is estimated from the statistics of the table, so skewed columns are taken into account.
+	 */
+	void getEnumeratedTableCost(bool function, const TableStatistics* statistics) {
 		auto ts = toDouble(_table->size());
-		double lookupsize = sz < ts ? sz : ts;
-		if (lookupsize == 0) {
+		if (ts == 0) {
 			_result = 1;
 			return;
 		}
-		auto lookuptime = log(lookupsize) / log(2);
-		if (lookuptime < InfCost) {
-			auto iteratetime = ts / sz;
-			if (lookuptime + iteratetime < InfCost) {
-				_result = lookuptime + iteratetime;
-				return;
+		bool someinput = false, allargumentsinput = true;
+		for (unsigned int n = 0; n < _pattern.size(); ++n) {
+			someinput |= _pattern[n];
+			if (not function || n + 1 < _pattern.size()) {
+				allargumentsinput &= _pattern[n];
 			}
 		}
-		_result = sz;
+		if (not someinput) {
+			_result = ts;
+			return;
+		}
+		auto lookuptime = log(ts) / log(2);
+		auto iteratetime = statistics->expectedMatches(_pattern);
+		if (function && allargumentsinput && iteratetime > 1) {
+			iteratetime = 1; // A function has at most one image
+		}
+		_result = lookuptime + iteratetime;
 	}
 
-	void visit(const EnumeratedInternalPredTable*) {
-		getEnumeratedTableCost(false);
+	void visit(const EnumeratedInternalPredTable* t) {
+		getEnumeratedTableCost(false, t->statistics());
 	}
 
-	void visit(const EnumeratedInternalFuncTable*) {
-		getEnumeratedTableCost(true);
+	void visit(const EnumeratedInternalFuncTable* t) {
+		getEnumeratedTableCost(true, t->statistics());
 	}
 
 	void visit(const EqualInternalPredTable*) {
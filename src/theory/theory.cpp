@@ -23,6 +23,7 @@
 #include "printers/print.hpp"
 
 #include "TheoryUtils.hpp"
+#include "inferences/propagation/BoundsCache.hpp"
 
 using namespace std;
 
@@ -558,6 +559,12 @@ ostream& FixpDef::put(ostream& output) const {
  Theories
  ***************/
 
+unsigned int AbstractTheory::_nbtheories = 0;
+
+AbstractTheory::~AbstractTheory() {
+	BoundsCache::forgetTheory(_id);
+}
+
 Theory* Theory::clone() const {
 	auto newtheory = new Theory(_name, _vocabulary, ParseInfo());
 	for (auto it : getComponents()) {
@@ -585,12 +592,15 @@ void Theory::recursiveDelete() {//FIXME handle all cases with an enum or a visit
 
 void Theory::add(Formula* f) {
 	_sentences.push_back(f);
+	changed();
 }
 void Theory::add(Definition* d) {
 	_definitions.push_back(d);
+	changed();
 }
 void Theory::add(FixpDef* fd) {
 	_fixpdefs.push_back(fd);
+	changed();
 }
 
 void Theory::add(TheoryComponent* comp) { // FIXME handle all cases with an enum or a visitor
@@ -647,6 +657,7 @@ void Theory::remove(Definition* d) {
 	}
 	if (it != _definitions.end()) {
 		_definitions.erase(it);
+		changed();
 	}
 }
 
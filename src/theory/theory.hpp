@@ -683,27 +683,36 @@ public:
  */
 class AbstractTheory {
 ACCEPTDECLAREBOTH(AbstractTheory)
+private:
+	static unsigned int _nbtheories; //!< Number of theories created so far
+	unsigned int _id; //!< Unlike its address, never reused by a later theory
+	unsigned int _version; //!< Incremented whenever the theory might have changed
+
 protected:
 	std::string _name; //!< the name of the theory
 	Vocabulary* _vocabulary; //!< the vocabulary of the theory
 	ParseInfo _pi; //!< the place where the theory was parsed
 
+	void changed() {
+		++_version;
+	}
+
 public:
 	AbstractTheory(const std::string& name, const ParseInfo& pi)
-			: _name(name), _vocabulary(0), _pi(pi) {
+			: _id(++_nbtheories), _version(0), _name(name), _vocabulary(0), _pi(pi) {
 	}
 	AbstractTheory(const std::string& name, Vocabulary* voc, const ParseInfo& pi)
-			: _name(name), _vocabulary(voc), _pi(pi) {
+			: _id(++_nbtheories), _version(0), _name(name), _vocabulary(voc), _pi(pi) {
 	}
 
 	virtual AbstractTheory* clone() const = 0; //!< Make a deep copy of the theory
 
 	virtual void recursiveDelete() = 0; //!< Delete the theory and its components
-	virtual ~AbstractTheory() {
-	} //!< Delete the theory, but not its components
+	virtual ~AbstractTheory(); //!< Delete the theory, but not its components
 
 	void vocabulary(Vocabulary* v) {
 		_vocabulary = v;
+		changed();
 	} //!< Change the vocabulary of the theory
 	void name(const std::string& n) {
 		_name = n;
@@ -720,6 +729,13 @@ public:
 	const ParseInfo& pi() const {
 		return _pi;
 	}
+	unsigned int id() const {
+		return _id;
+	}
+	//! NOTE: conservative, every non-const access to the components of a theory counts as a change
+	unsigned int version() const {
+		return _version;
+	}
 
 	virtual std::ostream& put(std::ostream&) const = 0;
 };
@@ -761,28 +777,36 @@ public:
 	void addTheory(AbstractTheory*);
 	void sentence(unsigned int n, Formula* f) {
 		_sentences[n] = f;
+		changed();
 	}
 	void sentences(std::vector<Formula*> v) {
 		_sentences = v;
+		changed();
 	}
 	void definition(unsigned int n, Definition* d) {
 		_definitions[n] = d;
+		changed();
 	}
 	void definitions(std::vector<Definition*> v) {
 		_definitions = v;
+		changed();
 	}
 	void fixpdef(unsigned int n, FixpDef* d) {
 		_fixpdefs[n] = d;
+		changed();
 	}
 	void remove(Definition* d);
 
 	std::vector<Formula*>& sentences() {
+		changed();
 		return _sentences;
 	}
 	std::vector<Definition*>& definitions() {
+		changed();
 		return _definitions;
 	}
 	std::vector<FixpDef*>& fixpdefs() {
+		changed();
 		return _fixpdefs;
 	}
 
@@ -0,0 +1,129 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+#include "ForkedWorkers.hpp"
+#include <iostream>
+#ifdef UNIX
+#include <csignal>
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+using namespace std;
+
+ForkedWorkers::~ForkedWorkers() {
+	stop();
+}
+
+#ifdef UNIX
+
+int ForkedWorkers::start(const function<bool(int)>& work) {
+	int fds[2];
+	if (::pipe(fds) != 0) {
+		return -1;
+	}
+	cout.flush();
+	clog.flush();
+	auto pid = fork();
+	if (pid == 0) {
+		close(fds[0]);
+		for (const auto& worker : _workers) {
+			if (worker.pipe != -1) {
+				close(worker.pipe);
+			}
+		}
+		int status = 1;
+		try {
+			status = work(fds[1]) ? 0 : 1;
+		} catch (...) {
+		}
+		close(fds[1]);
+		_exit(status);
+	}
+	close(fds[1]);
+	if (pid < 0) {
+		close(fds[0]);
+		return -1;
+	}
+	_workers.push_back(Worker { pid, fds[0] });
+	return _workers.size() - 1;
+}
+
+bool ForkedWorkers::finish(size_t worker) {
+	auto& w = _workers[worker];
+	if (w.pipe == -1) {
+		return false;
+	}
+	close(w.pipe);
+	w.pipe = -1;
+	int status;
+	return waitpid(w.pid, &status, 0) == w.pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+void ForkedWorkers::stop() {
+	for (auto& worker : _workers) {
+		if (worker.pipe != -1) {
+			kill(worker.pid, SIGKILL);
+			close(worker.pipe);
+			worker.pipe = -1;
+			int status;
+			waitpid(worker.pid, &status, 0);
+		}
+	}
+}
+
+bool ForkedWorkers::writeAll(int fd, const void* data, size_t size) {
+	auto bytes = (const char*) data;
+	while (size > 0) {
+		auto n = write(fd, bytes, size);
+		if (n <= 0) {
+			return false;
+		}
+		bytes += n;
+		size -= n;
+	}
+	return true;
+}
+
+size_t ForkedWorkers::readAll(int fd, void* data, size_t size) {
+	auto bytes = (char*) data;
+	size_t done = 0;
+	while (done < size) {
+		auto n = read(fd, bytes + done, size - done);
+		if (n <= 0) {
+			break;
+		}
+		done += n;
+	}
+	return done;
+}
+
+#else
+
+int ForkedWorkers::start(const function<bool(int)>&) {
+	return -1;
+}
+
+bool ForkedWorkers::finish(size_t) {
+	return false;
+}
+
+void ForkedWorkers::stop() {
+}
+
+bool ForkedWorkers::writeAll(int, const void*, size_t) {
+	return false;
+}
+
+size_t ForkedWorkers::readAll(int, void*, size_t) {
+	return 0;
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * Forked processes which each send their results to this process over their own pipe.
+ * Workers which are not finished when the object is destroyed are killed and reaped,
+ * so an exception while starting or reading them does not leave them running.
+ *
+ * NOTE: only supported on Unix, elsewhere no worker can be started.
+ */
+class ForkedWorkers {
+private:
+	struct Worker {
+		int pid;
+		int pipe; //!< Read end of the pipe, -1 once the worker is finished
+	};
+	std::vector<Worker> _workers;
+
+	ForkedWorkers(const ForkedWorkers&);
+	ForkedWorkers& operator=(const ForkedWorkers&);
+
+public:
+	ForkedWorkers() {
+	}
+	~ForkedWorkers();
+
+	/**
+	 * Forks a worker which calls work with the write end of its pipe, and exits with status 0 if work returns true without throwing.
+	 * The worker closes the pipes of the other workers first, so they see the end of their pipe as soon as their own worker exits.
+	 * Returns the index of the new worker, or -1 if the pipe or the fork failed.
+	 */
+	int start(const std::function<bool(int pipe)>& work);
+
+	size_t size() const {
+		return _workers.size();
+	}
+	int pipe(size_t worker) const {
+		return _workers[worker].pipe;
+	}
+
+	//! Closes the pipe of the worker and waits for it. Returns true if it exited with status 0.
+	bool finish(size_t worker);
+	//! Kills and reaps the workers which are not finished
+	void stop();
+
+	//! Writes all bytes, also if the pipe only accepts part of them at a time
+	static bool writeAll(int fd, const void* data, size_t size);
+	//! Reads size bytes or until the end of the pipe. Returns the number of bytes read.
+	static size_t readAll(int fd, void* data, size_t size);
+};
@@ -0,0 +1,209 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#ifdef UNIX
+#include <csignal>
+#include <sys/time.h>
+#endif
+
+using namespace std;
+
+Profiler::Frame Profiler::_stack[Profiler::MAXDEPTH];
+volatile unsigned int Profiler::_depth = 0;
+volatile bool Profiler::_running = false;
+unsigned long long Profiler::_nextid = 0;
+Profiler::SampledStack* Profiler::_samples = NULL;
+volatile unsigned long Profiler::_nbdropped = 0;
+std::map<unsigned long long, std::string> Profiler::_descriptions;
+std::map<const char*, Profiler::PhaseTime> Profiler::_times;
+
+void Profiler::enter(Frame& frame) {
+	if (frame.detail != NULL && frame.describer != NULL) {
+		frame.id = ++_nextid;
+	}
+	// Only the outermost occurrence of a phase is timed, so recursive phases are not counted twice
+	auto index = &frame - _stack;
+	for (auto i = 0; i < index; ++i) {
+		if (_stack[i].name == frame.name) {
+			return;
+		}
+	}
+	frame.timed = true;
+	frame.start = clock();
+}
+
+void Profiler::exit(Frame& frame) {
+	if (frame.timed) {
+		auto& time = _times[frame.name];
+		time.time += clock() - frame.start;
+		++time.count;
+		frame.timed = false;
+	}
+	if (frame.sampled && frame.id != 0 && _descriptions.find(frame.id) == _descriptions.cend()) {
+		_descriptions[frame.id] = frame.describer(frame.detail);
+	}
+	frame.sampled = 0;
+}
+
+// NOTE: runs in a signal handler, so does not allocate and only touches the stack and the preallocated table
+void Profiler::sample(int) {
+	if (not _running || _samples == NULL) {
+		return;
+	}
+	auto depth = min((unsigned int) _depth, MAXDEPTH);
+	unsigned long long hash = depth;
+	for (unsigned int i = 0; i < depth; ++i) {
+		hash = hash * 31 + (unsigned long long) _stack[i].name;
+		hash = hash * 31 + _stack[i].id;
+	}
+	for (unsigned int probe = 0; probe < NBSTACKS; ++probe) {
+		auto& stack = _samples[(hash + probe) % NBSTACKS];
+		if (stack.count == 0) {
+			stack.depth = depth;
+			for (unsigned int i = 0; i < depth; ++i) {
+				stack.names[i] = _stack[i].name;
+				stack.ids[i] = _stack[i].id;
+			}
+		} else {
+			if (stack.depth != depth) {
+				continue;
+			}
+			bool equal = true;
+			for (unsigned int i = 0; i < depth && equal; ++i) {
+				equal = stack.names[i] == _stack[i].name && stack.ids[i] == _stack[i].id;
+			}
+			if (not equal) {
+				continue;
+			}
+		}
+		++stack.count;
+		for (unsigned int i = 0; i < depth; ++i) {
+			if (_stack[i].id != 0) {
+				_stack[i].sampled = 1;
+			}
+		}
+		return;
+	}
+	_nbdropped = _nbdropped + 1;
+}
+
+#ifdef UNIX
+bool Profiler::startSampling(unsigned int interval) {
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = &Profiler::sample;
+	action.sa_flags = SA_RESTART; // Sampling should not interrupt system calls
+	sigemptyset(&action.sa_mask);
+	if (sigaction(SIGPROF, &action, NULL) != 0) {
+		return false;
+	}
+	itimerval timer;
+	timer.it_interval.tv_sec = interval / 1000;
+	timer.it_interval.tv_usec = (interval % 1000) * 1000;
+	timer.it_value = timer.it_interval;
+	return setitimer(ITIMER_PROF, &timer, NULL) == 0;
+}
+
+void Profiler::stopSampling() {
+	itimerval timer;
+	memset(&timer, 0, sizeof(timer));
+	setitimer(ITIMER_PROF, &timer, NULL);
+	signal(SIGPROF, SIG_IGN);
+}
+#else
+bool Profiler::startSampling(unsigned int) {
+	return false;
+}
+
+void Profiler::stopSampling() {
+}
+#endif
+
+bool Profiler::start(unsigned int interval) {
+	if (_running) {
+		return true;
+	}
+	_samples = new SampledStack[NBSTACKS];
+	for (unsigned int i = 0; i < NBSTACKS; ++i) {
+		_samples[i].count = 0;
+	}
+	_nbdropped = 0;
+	_descriptions.clear();
+	_times.clear();
+	_running = true;
+	return startSampling(max(interval, 1u));
+}
+
+std::string Profiler::describe(const SampledStack& stack) {
+	stringstream ss;
+	ss << "idp";
+	for (unsigned int i = 0; i < stack.depth; ++i) {
+		ss << ";" << stack.names[i];
+		auto it = _descriptions.find(stack.ids[i]);
+		if (it != _descriptions.cend()) {
+			auto description = it->second;
+			// Semicolons separate the frames and newlines the stacks in the collapsed format
+			replace(description.begin(), description.end(), ';', ',');
+			replace(description.begin(), description.end(), '\n', ' ');
+			ss << "[" << description << "]";
+		}
+	}
+	return ss.str();
+}
+
+void Profiler::stop(std::ostream* collapsed, std::ostream& times) {
+	if (not _running) {
+		return;
+	}
+	stopSampling();
+	_running = false;
+
+	// Phases which are still running are reported up to now
+	for (unsigned int i = 0; i < min((unsigned int) _depth, MAXDEPTH); ++i) {
+		if (_stack[i].timed || _stack[i].sampled) {
+			exit(_stack[i]);
+		}
+	}
+
+	map<string, unsigned long> stacks;
+	for (unsigned int i = 0; i < NBSTACKS; ++i) {
+		if (_samples[i].count > 0) {
+			stacks[describe(_samples[i])] += _samples[i].count;
+		}
+	}
+	delete[] _samples;
+	_samples = NULL;
+	if (collapsed != NULL) {
+		for (auto& stack : stacks) {
+			*collapsed << stack.first << " " << stack.second << "\n";
+		}
+	}
+	if (_nbdropped > 0) {
+		times << "Dropped " << _nbdropped << " samples of stacks not fitting in the profile\n";
+	}
+
+	map<string, PhaseTime> phases;
+	for (auto& time : _times) {
+		auto& phase = phases[time.first];
+		phase.time += time.second.time;
+		phase.count += time.second.count;
+	}
+	for (auto& phase : phases) {
+		times << phase.first << ": " << (long long) ((double) phase.second.time * 1000 / CLOCKS_PER_SEC) << " ms in " << phase.second.count << " run(s)\n";
+	}
+	_descriptions.clear();
+	_times.clear();
+}
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#ifndef PROFILER_HPP_
+#define PROFILER_HPP_
+
+#include <atomic>
+#include <string>
+#include <map>
+#include <ostream>
+#include <ctime>
+
+//! Returns a description of the detail of a phase (e.g. the formula of a grounder)
+typedef std::string (*ProfileDescriber)(const void* detail);
+
+/**
+ * Built-in profiling of the phases of the inferences, available in any build type.
+ *
+ * Code marks its phases with ProfilePhase scopes, which maintain a stack of phase names.
+ * While the profiler is running
+ * 	- the CPU time of every phase is accumulated (nested occurrences of the same phase are only counted once)
+ * 	- on Unix, a SIGPROF timer samples the stack of phases, such that the time can be attributed to, e.g., the formulas being grounded.
+ * 	  The samples are written as collapsed stacks ("idp;modelexpand;grounding;grounder[!x: P(x)] 42"), the input format of flame graph tools.
+ *
+ * When the profiler is not running, a phase costs a few stores to a static array.
+ * NOTE: the stack is global, it represents the phases of the thread running the inference.
+ */
+class Profiler {
+public:
+	static const unsigned int MAXDEPTH = 24; //!< Phases nested deeper are not recorded (but are counted)
+	static const unsigned int NBSTACKS = 4096; //!< Number of different stacks that can be sampled, later new stacks are dropped
+
+private:
+	struct Frame {
+		const char* name;
+		const void* detail;
+		ProfileDescriber describer;
+		unsigned long long id; //!< Identifies the detail during the current run, 0 if there is none
+		volatile int sampled;
+		bool timed;
+		clock_t start;
+	};
+	struct SampledStack {
+		unsigned int depth;
+		unsigned long count;
+		const char* names[MAXDEPTH];
+		unsigned long long ids[MAXDEPTH];
+	};
+	struct PhaseTime {
+		clock_t time;
+		unsigned long count;
+		PhaseTime()
+				: 	time(0),
+					count(0) {
+		}
+	};
+
+	static Frame _stack[MAXDEPTH];
+	static volatile unsigned int _depth;
+	static volatile bool _running;
+	static unsigned long long _nextid;
+	static SampledStack* _samples; //!< Open addressing hash table of NBSTACKS stacks, only allocated while running
+	static volatile unsigned long _nbdropped;
+	static std::map<unsigned long long, std::string> _descriptions; //!< Description of the details of the sampled phases
+	static std::map<const char*, PhaseTime> _times; //!< Keyed on the address of the name, merged on the names when reporting
+
+	static void enter(Frame& frame);
+	static void exit(Frame& frame);
+	static void sample(int signal);
+	static bool startSampling(unsigned int interval);
+	static void stopSampling();
+	static std::string describe(const SampledStack& stack);
+
+public:
+	static void push(const char* name, const void* detail, ProfileDescriber describer) {
+		if (_depth < MAXDEPTH) {
+			auto& frame = _stack[_depth];
+			frame.name = name;
+			frame.detail = detail;
+			frame.describer = describer;
+			frame.id = 0;
+			frame.sampled = 0;
+			frame.timed = false;
+			if (_running) {
+				enter(frame);
+			}
+		}
+		// The SIGPROF handler reads the frames below _depth, so the frame has to be complete before it is counted
+		std::atomic_signal_fence(std::memory_order_release);
+		_depth = _depth + 1;
+	}
+	static void pop() {
+		_depth = _depth - 1;
+		std::atomic_signal_fence(std::memory_order_seq_cst); // Only change the frame once the handler no longer reads it
+		if (_depth < MAXDEPTH) {
+			auto& frame = _stack[_depth];
+			if (frame.timed || frame.sampled) {
+				exit(frame);
+			}
+		}
+	}
+
+	static bool running() {
+		return _running;
+	}
+	/**
+	 * Starts timing the phases and, if supported, sampling them every interval milliseconds.
+	 * Returns false if sampling is not supported (the phases are still timed).
+	 */
+	static bool start(unsigned int interval);
+	/**
+	 * Stops profiling, writes the sampled stacks in collapsed format to collapsed (if not NULL)
+	 * and the accumulated time of every phase to times
+	 */
+	static void stop(std::ostream* collapsed, std::ostream& times);
+};
+
+/**
+ * Marks the scope of a phase of an inference for the Profiler.
+ * Only the address of the name is stored, so it should stay valid (e.g. a string literal).
+ * The optional detail (e.g. a grounder) is described by the describer if the phase was sampled, while the phase is still running.
+ */
+class ProfilePhase {
+public:
+	ProfilePhase(const char* name, const void* detail = NULL, ProfileDescriber describer = NULL) {
+		Profiler::push(name, detail, describer);
+	}
+	~ProfilePhase() {
+		Profiler::pop();
+	}
+};
+
+#endif /* PROFILER_HPP_ */
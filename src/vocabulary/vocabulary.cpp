@@ -14,6 +14,7 @@
 #include "structure/StructureComponents.hpp"
 #include "utils/StringUtils.hpp"
 #include "printers/print.hpp"
+#include "inferences/propagation/BoundsCache.hpp"
 
 using namespace std;
 
@@ -1690,7 +1691,8 @@ bool isIntProduct(const Function* function, const Vocabulary* voc) {
 
 Vocabulary::Vocabulary(const string& name)
 		: 	_name(name),
-			_namespace(0) {
+			_namespace(0),
+			_id(++_nbvocabularies) {
 	if (_name != "std") {
 		add(Vocabulary::std());
 	}
@@ -1699,7 +1701,8 @@ Vocabulary::Vocabulary(const string& name)
 Vocabulary::Vocabulary(const string& name, const ParseInfo& pi)
 		: 	_name(name),
 			_pi(pi),
-			_namespace(0) {
+			_namespace(0),
+			_id(++_nbvocabularies) {
 	if (_name != "std") {
 		add(Vocabulary::std());
 	}
@@ -1709,6 +1712,7 @@ Vocabulary::~Vocabulary() {
 	if (this == _std) {
 		_std = NULL;
 	}
+	BoundsCache::forgetVocabulary(_id);
 	for (auto it = _name2pred.cbegin(); it != _name2pred.cend(); ++it) {
 		it->second->removeVocabulary(this);
 	}
@@ -1727,12 +1731,19 @@ void updateStructures(Elem elem, const List& structures) {
 	}
 }
 
+// Name of a predicate or function without the arity
+static string basename(const string& name) {
+	return name.substr(0, name.rfind('/'));
+}
+
 void Vocabulary::add(Sort* s) {
 	if (contains(s)) {
 		return;
 	}
 
 	_name2sort[s->name()] = s;
+	_sortindex[s->name()] = s;
+	++_nbchanges;
 	s->addVocabulary(this);
 	for (auto p : s->parents()) {
 		add(p);
@@ -1760,13 +1771,18 @@ void Vocabulary::add(Predicate* p) {
 		add(p->parent());
 	}
 
-	if (_name2pred.find(p->name()) == _name2pred.cend()) {
+	auto it = _predindex.find(p->name());
+	if (it == _predindex.cend()) {
 		_name2pred[p->name()] = p;
+		_predindex[p->name()] = p;
+		_basename2preds[basename(p->name())].push_back(p->name());
 	} else {
-		auto ovp = PredUtils::overload(p, _name2pred[p->name()]);
+		auto ovp = PredUtils::overload(p, it->second);
 		_name2pred[p->name()] = ovp;
+		it->second = ovp;
 		ovp->addVocabulary(this);
 	}
+	++_nbchanges;
 	auto ss = p->allsorts();
 	for (auto it = ss.cbegin(); it != ss.cend(); ++it) {
 		add(*it);
@@ -1780,13 +1796,18 @@ void Vocabulary::add(Function* f) {
 		return;
 	}
 
-	if (_name2func.find(f->name()) == _name2func.cend()) {
+	auto it = _funcindex.find(f->name());
+	if (it == _funcindex.cend()) {
 		_name2func[f->name()] = f;
+		_funcindex[f->name()] = f;
+		_basename2funcs[basename(f->name())].push_back(f->name());
 	} else {
-		auto ovf = FuncUtils::overload(f, _name2func[f->name()]);
+		auto ovf = FuncUtils::overload(f, it->second);
 		_name2func[f->name()] = ovf;
+		it->second = ovf;
 		ovf->addVocabulary(this);
 	}
+	++_nbchanges;
 	auto ss = f->allsorts();
 	for (auto it = ss.cbegin(); it != ss.cend(); ++it) {
 		add(*it);
@@ -1808,6 +1829,8 @@ void Vocabulary::add(Vocabulary* v) {
 }
 
 Vocabulary* Vocabulary::_std = 0;
+unsigned int Vocabulary::_nbchanges = 0;
+unsigned int Vocabulary::_nbvocabularies = 0;
 std::map<STDFUNC, std::string> func2string;
 std::map<STDPRED, std::string> pred2string;
 std::map<STDSORT, std::string> sort2string;
@@ -2027,26 +2050,26 @@ const ParseInfo& Vocabulary::pi() const {
 }
 
 bool Vocabulary::hasSortWithName(const std::string& name) const {
-	return _name2sort.find(name) != _name2sort.cend();
+	return _sortindex.find(name) != _sortindex.cend();
 }
 bool Vocabulary::hasPredWithName(const std::string& name) const {
-	return _name2pred.find(name) != _name2pred.cend();
+	return _predindex.find(name) != _predindex.cend();
 }
 bool Vocabulary::hasFuncWithName(const std::string& name) const {
-	return _name2func.find(name) != _name2func.cend();
+	return _funcindex.find(name) != _funcindex.cend();
 }
 
 bool Vocabulary::contains(const Sort* s) const {
-	auto it = _name2sort.find(s->name());
-	if (it == _name2sort.cend()) {
+	auto it = _sortindex.find(s->name());
+	if (it == _sortindex.cend()) {
 		return false;
 	}
 	return it->second == s;
 }
 
 bool Vocabulary::contains(const Predicate* p) const {
-	auto it = _name2pred.find(p->name());
-	if (it != _name2pred.cend()) {
+	auto it = _predindex.find(p->name());
+	if (it != _predindex.cend()) {
 		return it->second->contains(p);
 	} else {
 		return false;
@@ -2054,8 +2077,8 @@ bool Vocabulary::contains(const Predicate* p) const {
 }
 
 bool Vocabulary::contains(const Function* f) const {
-	auto it = _name2func.find(f->name());
-	if (it != _name2func.cend()) {
+	auto it = _funcindex.find(f->name());
+	if (it != _funcindex.cend()) {
 		return it->second->contains(f);
 	} else {
 		return false;
@@ -2083,8 +2106,8 @@ std::vector<PFSymbol*> Vocabulary::getNonBuiltinNonOverloadedNonTypeSymbols() co
 	}
 
 Sort* Vocabulary::sort(const string& name) const {
-	auto it = _name2sort.find(name);
-	if (it != _name2sort.cend()) {
+	auto it = _sortindex.find(name);
+	if (it != _sortindex.cend()) {
 		return it->second;
 	} else {
 		return NULL;
@@ -2092,8 +2115,8 @@ Sort* Vocabulary::sort(const string& name) const {
 }
 
 Predicate* Vocabulary::pred(const string& name) const {
-	auto it = _name2pred.find(name);
-	if (it != _name2pred.cend()) {
+	auto it = _predindex.find(name);
+	if (it != _predindex.cend()) {
 		return it->second;
 	} else {
 		return 0;
@@ -2101,8 +2124,8 @@ Predicate* Vocabulary::pred(const string& name) const {
 }
 
 Function* Vocabulary::func(const string& name) const {
-	auto it = _name2func.find(name);
-	if (it != _name2func.cend()) {
+	auto it = _funcindex.find(name);
+	if (it != _funcindex.cend()) {
 		return it->second;
 	} else {
 		return 0;
@@ -2111,10 +2134,10 @@ Function* Vocabulary::func(const string& name) const {
 
 set<Predicate*> Vocabulary::pred_no_arity(const string& name) const {
 	set<Predicate*> vp;
-	for (auto it = _name2pred.cbegin(); it != _name2pred.cend(); ++it) {
-		string nm = it->second->name();
-		if (nm.substr(0, nm.rfind('/')) == name) {
-			vp.insert(it->second);
+	auto it = _basename2preds.find(name);
+	if (it != _basename2preds.cend()) {
+		for (auto& nm : it->second) {
+			vp.insert(_predindex.at(nm));
 		}
 	}
 	return vp;
@@ -2122,10 +2145,10 @@ set<Predicate*> Vocabulary::pred_no_arity(const string& name) const {
 
 set<Function*> Vocabulary::func_no_arity(const string& name) const {
 	set<Function*> vf;
-	for (auto it = _name2func.cbegin(); it != _name2func.cend(); ++it) {
-		string nm = it->second->name();
-		if (nm.substr(0, nm.rfind('/')) == name) {
-			vf.insert(it->second);
+	auto it = _basename2funcs.find(name);
+	if (it != _basename2funcs.cend()) {
+		for (auto& nm : it->second) {
+			vf.insert(_funcindex.at(nm));
 		}
 	}
 	return vf;
@@ -14,6 +14,7 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <ostream>
 #include "parseinfo.hpp"
 #include "commontypes.hpp"
@@ -519,7 +520,19 @@ private:
 	std::map<std::string, Function*> _name2func; //!< Map a name to the (overloaded) function having
 												 //!< that name in the vocabulary. Name should end on /arity.
 
+	// Hashed indexes on the symbols of the maps above, which are kept for their (deterministic) iteration order.
+	// Name resolution in the parser only goes through these indexes.
+	std::unordered_map<std::string, Sort*> _sortindex;
+	std::unordered_map<std::string, Predicate*> _predindex;
+	std::unordered_map<std::string, Function*> _funcindex;
+	std::unordered_map<std::string, std::vector<std::string> > _basename2preds; //!< Map a name without arity to the names with arity
+	std::unordered_map<std::string, std::vector<std::string> > _basename2funcs; //!< Map a name without arity to the names with arity
+
 	static Vocabulary* _std; //!< The standard vocabulary
+	static unsigned int _nbchanges; //!< Number of symbols added to any vocabulary, to invalidate caches of name lookups
+	static unsigned int _nbvocabularies; //!< Number of vocabularies created so far
+
+	unsigned int _id; //!< Unlike its address, never reused by a later vocabulary
 
 	std::set<Structure*> structures;
 
@@ -552,6 +565,13 @@ public:
 	const std::string& name() const; //!< Returns the name of the vocabulary
 	const ParseInfo& pi() const; //!< Returns the parse info of the vocabularyPred
 
+	static unsigned int nbChanges() {
+		return _nbchanges;
+	}
+	unsigned int id() const {
+		return _id;
+	}
+
 	bool hasSortWithName(const std::string& name) const;
 	bool hasPredWithName(const std::string& name) const;
 	bool hasFuncWithName(const std::string& name) const;
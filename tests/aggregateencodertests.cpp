@@ -0,0 +1,30 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "groundtheories/AggregateEncoder.hpp"
+#include "utils/NumericLimits.hpp"
+
+using namespace std;
+
+namespace Tests {
+
+TEST(AggregateEncoderTest, SizeEstimatesSaturateInsteadOfOverflowing) {
+	vector<long long> weights(1 << 20, 1LL << 40);
+	auto atleast = (1LL << 60) - 1;
+	ASSERT_EQ(getMaxElem<long long>(), AggregateEncoder::estimateSize(AggEncoding::BDD, weights, atleast));
+	ASSERT_EQ(getMaxElem<long long>(), AggregateEncoder::estimateSize(AggEncoding::SEQUENTIAL, weights, atleast));
+	ASSERT_EQ(6 * 3 * 2, AggregateEncoder::estimateSize(AggEncoding::BDD, { 1, 2, 3 }, 2));
+}
+
+}
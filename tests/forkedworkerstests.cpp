@@ -0,0 +1,81 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "utils/ForkedWorkers.hpp"
+
+#ifdef UNIX
+#include <csignal>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace Tests {
+
+#ifdef UNIX
+
+TEST(ForkedWorkersTest, WorkersSendTheirResultsAndReportFailures) {
+	ForkedWorkers workers;
+	for (int i = 0; i < 3; ++i) {
+		ASSERT_EQ(i, workers.start([i](int pipe) {
+			return i != 1 && ForkedWorkers::writeAll(pipe, &i, sizeof(int));
+		}));
+	}
+	ASSERT_EQ(3u, workers.size());
+	for (int i = 0; i < 3; ++i) {
+		int result = -1;
+		auto n = ForkedWorkers::readAll(workers.pipe(i), &result, sizeof(int));
+		auto ok = workers.finish(i);
+		ASSERT_EQ(-1, workers.pipe(i));
+		if (i == 1) {
+			ASSERT_EQ(0u, n);
+			ASSERT_FALSE(ok);
+		} else {
+			ASSERT_EQ(sizeof(int), n);
+			ASSERT_EQ(i, result);
+			ASSERT_TRUE(ok);
+		}
+	}
+}
+
+TEST(ForkedWorkersTest, ThrowingWorkersFail) {
+	ForkedWorkers workers;
+	ASSERT_EQ(0, workers.start([](int) -> bool {
+		throw runtime_error("Fails in the worker");
+	}));
+	ASSERT_FALSE(workers.finish(0));
+}
+
+TEST(ForkedWorkersTest, UnfinishedWorkersAreKilledAndReaped) {
+	int pid = -1;
+	{
+		ForkedWorkers workers;
+		ASSERT_EQ(0, workers.start([](int pipe) {
+			int self = getpid();
+			ForkedWorkers::writeAll(pipe, &self, sizeof(int));
+			while (true) {
+				pause();
+			}
+			return true;
+		}));
+		ASSERT_EQ(sizeof(int), ForkedWorkers::readAll(workers.pipe(0), &pid, sizeof(int)));
+		ASSERT_EQ(0, kill(pid, 0));
+	}
+	// Once reaped, the pid no longer exists
+	ASSERT_EQ(-1, kill(pid, 0));
+}
+
+#endif
+
+}
@@ -15,9 +15,12 @@
 #include "external/runidp.hpp"
 #include "IncludeComponents.hpp"
 #include "generators/ComparisonGenerator.hpp"
+#include "generators/BinaryArithmeticOperatorsGenerator.hpp"
 #include "generators/SortGenAndChecker.hpp"
 #include "generators/TableCheckerAndGenerators.hpp"
 #include "generators/EnumLookupGenerator.hpp"
+#include "generators/LeapfrogJoinGenerator.hpp"
+#include "generators/GeneratorFactory.hpp"
 #include "structure/StructureComponents.hpp"
 
 using namespace std;
@@ -99,6 +102,107 @@ namespace Tests{
 		ASSERT_EQ(genvalues.size(), (uint)2);
 	}
 
+	TEST(ComparisonGenerator, IntegerRangesMatchAllComparisons){
+		auto left = TableUtils::createSortTable(-3, 3);
+		auto right = TableUtils::createSortTable(-1, 5);
+		for (auto comp : {CompType::EQ, CompType::LT, CompType::LEQ, CompType::GT, CompType::GEQ}) {
+			for (auto input : {Input::NONE, Input::LEFT}) {
+				DomElemContainer *leftvar = new DomElemContainer(), *rightvar = new DomElemContainer();
+				auto gen = new ComparisonGenerator(left, right, leftvar, rightvar, input, comp);
+				for (int fixed = -3; fixed <= (input == Input::LEFT ? 3 : -3); ++fixed) {
+					set<pair<int, int> > expected, genvalues;
+					for (int x = -3; x <= 3; ++x) {
+						for (int y = -1; y <= 5; ++y) {
+							if ((input == Input::NONE || x == fixed) && compare(x, comp, y)) {
+								expected.insert(pair<int, int>(x, y));
+							}
+						}
+					}
+					leftvar->operator =(createDomElem(fixed));
+					for (gen->begin(); not gen->isAtEnd(); gen->operator ++()) {
+						genvalues.insert(pair<int, int>(leftvar->get()->value()._int, rightvar->get()->value()._int));
+					}
+					ASSERT_EQ(expected, genvalues);
+				}
+			}
+		}
+	}
+
+	TEST(ComparisonGenerator, NonRangeSortsMatchAllComparisons){
+		auto left = TableUtils::createSortTable(-3, 3);
+		left->remove(createDomElem(0));
+		auto right = TableUtils::createSortTable();
+		for (auto y : {-2, 1, 4}) {
+			right->add(createDomElem(y));
+		}
+		for (auto comp : {CompType::EQ, CompType::LT, CompType::GEQ}) {
+			DomElemContainer *leftvar = new DomElemContainer(), *rightvar = new DomElemContainer();
+			auto gen = new ComparisonGenerator(left, right, leftvar, rightvar, Input::NONE, comp);
+			set<pair<int, int> > expected, genvalues;
+			for (int x = -3; x <= 3; ++x) {
+				for (auto y : {-2, 1, 4}) {
+					if (x != 0 && compare(x, comp, y)) {
+						expected.insert(pair<int, int>(x, y));
+					}
+				}
+			}
+			for (gen->begin(); not gen->isAtEnd(); gen->operator ++()) {
+				genvalues.insert(pair<int, int>(leftvar->get()->value()._int, rightvar->get()->value()._int));
+			}
+			ASSERT_EQ(expected, genvalues);
+		}
+	}
+
+	TEST(ComparisonGenerator, CharSortsGenerateChars){
+		auto left = new SortTable(new AllChars());
+		auto right = new SortTable(new AllChars());
+		DomElemContainer *leftvar = new DomElemContainer(), *rightvar = new DomElemContainer();
+		auto gen = new ComparisonGenerator(left, right, leftvar, rightvar, Input::NONE, CompType::EQ);
+		uint nbgenerated = 0;
+		for (gen->begin(); not gen->isAtEnd(); gen->operator ++()) {
+			ASSERT_TRUE(left->contains(leftvar->get()));
+			ASSERT_EQ(leftvar->get(), rightvar->get());
+			++nbgenerated;
+		}
+		ASSERT_EQ((uint)left->size()._size, nbgenerated);
+	}
+
+	TEST(ArithOpGenerator, IntegerResultInFloatDomain){
+		auto out = new SortTable(new AllFloats());
+		DomElemContainer *in1 = new DomElemContainer(), *in2 = new DomElemContainer(), *outvar = new DomElemContainer();
+		*in1 = createDomElem(1);
+		*in2 = createDomElem(2);
+		auto gen = new PlusGenerator(in1, in2, outvar, NumType::POSSIBLYINT, out);
+		gen->begin();
+		ASSERT_FALSE(gen->isAtEnd());
+		ASSERT_EQ(createDomElem(3), outvar->get());
+	}
+
+	TEST(ArithOpGenerator, ResultOutsideIntegerRangeIsRejected){
+		auto out = TableUtils::createSortTable(0, 2);
+		DomElemContainer *in1 = new DomElemContainer(), *in2 = new DomElemContainer(), *outvar = new DomElemContainer();
+		*in1 = createDomElem(1);
+		*in2 = createDomElem(2);
+		auto gen = new PlusGenerator(in1, in2, outvar, NumType::CERTAINLYINT, out);
+		gen->begin();
+		ASSERT_TRUE(gen->isAtEnd());
+		*in2 = createDomElem(1);
+		gen->begin();
+		ASSERT_FALSE(gen->isAtEnd());
+		ASSERT_EQ(createDomElem(2), outvar->get());
+	}
+
+	TEST(ArithOpGenerator, UnionOutputDomain){
+		auto out = new SortTable(new UnionInternalSortTable({ TableUtils::createSortTable(0, 5) }, { }));
+		DomElemContainer *in1 = new DomElemContainer(), *in2 = new DomElemContainer(), *outvar = new DomElemContainer();
+		*in1 = createDomElem(1);
+		*in2 = createDomElem(2);
+		auto gen = new PlusGenerator(in1, in2, outvar, NumType::CERTAINLYINT, out);
+		gen->begin();
+		ASSERT_FALSE(gen->isAtEnd());
+		ASSERT_EQ(createDomElem(3), outvar->get());
+	}
+
 	TEST(SortGenerator, FiniteSort){
 		auto sort = TableUtils::createSortTable(-2, 2);
 		auto var = new DomElemContainer();
@@ -275,4 +379,149 @@ namespace Tests{
 		}
 		ASSERT_EQ(count, 1);
 	}
+
+	TEST(LeapfrogJoinGenerator, Triangles){
+		auto sort = TableUtils::createSortTable(1, 4);
+
+		auto x = new DomElemContainer();
+		auto y = new DomElemContainer();
+		auto z = new DomElemContainer();
+		Universe universe({sort, sort});
+		SortedElementTable elemTable({
+			{domelem(1), domelem(2)},
+			{domelem(2), domelem(3)},
+			{domelem(1), domelem(3)},
+			{domelem(3), domelem(4)},
+			{domelem(2), domelem(4)},
+			{domelem(4), domelem(1)}
+		});
+		auto edges = new PredTable(new EnumeratedInternalPredTable(elemTable), universe);
+
+		// Edge(x,y) & Edge(y,z) & Edge(x,z)
+		auto atoms = LeapfrogJoinGenerator::createAtoms({edges, edges, edges}, {{0, 1}, {1, 2}, {0, 2}}, 3);
+		auto gen = new LeapfrogJoinGenerator(atoms, {}, {x, y, z}, {sort, sort, sort});
+		set<vector<int> > triangles;
+		for(gen->begin(); not gen->isAtEnd(); gen->operator ++()){
+			triangles.insert({x->get()->value()._int, y->get()->value()._int, z->get()->value()._int});
+		}
+		ASSERT_EQ(triangles.size(), (uint)2);
+		ASSERT_EQ(triangles.count({1, 2, 3}), (uint)1);
+		ASSERT_EQ(triangles.count({2, 3, 4}), (uint)1);
+
+		// Same join with x as input
+		atoms = LeapfrogJoinGenerator::createAtoms({edges, edges, edges}, {{0, 1}, {1, 2}, {0, 2}}, 3);
+		gen = new LeapfrogJoinGenerator(atoms, {x}, {y, z}, {sort, sort});
+		x->operator =(createDomElem(2));
+		int count = 0;
+		for(gen->begin(); not gen->isAtEnd(); gen->operator ++()){
+			count++;
+			ASSERT_EQ(y->get()->value()._int, 3);
+			ASSERT_EQ(z->get()->value()._int, 4);
+		}
+		ASSERT_EQ(count, 1);
+
+		x->operator =(createDomElem(4));
+		ASSERT_FALSE(gen->check());
+	}
+
+	TEST(LeapfrogJoinGenerator, OutputsAreRestrictedToTheirSort){
+		auto sort = TableUtils::createSortTable(1, 4);
+		auto smallsort = TableUtils::createSortTable(1, 3);
+
+		auto x = new DomElemContainer();
+		auto y = new DomElemContainer();
+		auto z = new DomElemContainer();
+		Universe universe({sort, sort});
+		SortedElementTable elemTable({
+			{domelem(1), domelem(2)},
+			{domelem(2), domelem(3)},
+			{domelem(1), domelem(3)},
+			{domelem(3), domelem(4)},
+			{domelem(2), domelem(4)}
+		});
+		auto edges = new PredTable(new EnumeratedInternalPredTable(elemTable), universe);
+
+		// Only the triangle 1-2-3 has its z in smallsort
+		auto atoms = LeapfrogJoinGenerator::createAtoms({edges, edges, edges}, {{0, 1}, {1, 2}, {0, 2}}, 3);
+		auto gen = new LeapfrogJoinGenerator(atoms, {}, {x, y, z}, {sort, sort, smallsort});
+		set<vector<int> > triangles;
+		for(gen->begin(); not gen->isAtEnd(); gen->operator ++()){
+			triangles.insert({x->get()->value()._int, y->get()->value()._int, z->get()->value()._int});
+		}
+		ASSERT_EQ(triangles.size(), (uint)1);
+		ASSERT_EQ(triangles.count({1, 2, 3}), (uint)1);
+	}
+
+	TEST(LeapfrogJoinGenerator, SeesTheChangesToItsTables){
+		auto sort = TableUtils::createSortTable(1, 4);
+
+		auto x = new DomElemContainer();
+		auto y = new DomElemContainer();
+		auto z = new DomElemContainer();
+		Universe universe({sort, sort});
+		SortedElementTable elemTable({
+			{domelem(1), domelem(2)},
+			{domelem(2), domelem(3)},
+			{domelem(1), domelem(3)},
+			{domelem(3), domelem(4)},
+			{domelem(2), domelem(4)}
+		});
+		auto edges = new PredTable(new EnumeratedInternalPredTable(elemTable), universe);
+
+		auto countTriangles = [&](){
+			auto atoms = LeapfrogJoinGenerator::createAtoms({edges, edges, edges}, {{0, 1}, {1, 2}, {0, 2}}, 3);
+			auto gen = new LeapfrogJoinGenerator(atoms, {}, {x, y, z}, {sort, sort, sort});
+			uint count = 0;
+			for(gen->begin(); not gen->isAtEnd(); gen->operator ++()){
+				count++;
+			}
+			delete(gen);
+			return count;
+		};
+
+		// The atoms share the sorted tuples cached on the table
+		auto atoms = LeapfrogJoinGenerator::createAtoms({edges, edges, edges}, {{0, 1}, {1, 2}, {0, 2}}, 3);
+		ASSERT_EQ((*atoms)[0].rows, (*atoms)[1].rows);
+		ASSERT_EQ((*atoms)[0].rows, (*atoms)[2].rows);
+		ASSERT_EQ(countTriangles(), (uint)2);
+
+		// Adding edge 1-4 closes triangles 1-2-4 and 1-3-4
+		edges->add({domelem(1), domelem(4)});
+		auto newatoms = LeapfrogJoinGenerator::createAtoms({edges, edges, edges}, {{0, 1}, {1, 2}, {0, 2}}, 3);
+		ASSERT_NE((*atoms)[0].rows, (*newatoms)[0].rows);
+		ASSERT_EQ((*newatoms)[0].rows->size(), (uint)6);
+		ASSERT_EQ(countTriangles(), (uint)4);
+
+		edges->remove({domelem(2), domelem(3)});
+		ASSERT_EQ(countTriangles(), (uint)2);
+	}
+
+	TEST(EnumLookupGenerator, UnionDoesNotShareItsTuplesThroughTheIndexOfAnInTable){
+		auto sort = TableUtils::createSortTable(1, 3);
+		Universe universe({sort});
+		auto first = new EnumeratedInternalPredTable(SortedElementTable({{domelem(1)}, {domelem(2)}}));
+		auto second = new EnumeratedInternalPredTable(SortedElementTable({{domelem(3)}}));
+		auto unionpt = new PredTable(new UnionInternalPredTable({first, second}, {}), universe);
+		auto var = new DomElemContainer();
+
+		// Caches indexes on both in-tables
+		auto gen = GeneratorFactory::create(unionpt, {Pattern::OUTPUT}, {var}, universe);
+		set<int> genvalues;
+		for(gen->begin(); not gen->isAtEnd(); gen->operator ++()){
+			genvalues.insert(var->get()->value()._int);
+		}
+		ASSERT_EQ(genvalues, (set<int>{1, 2, 3}));
+
+		// Reuses the index cached on the first in-table, which should only contain its own tuples
+		gen = GeneratorFactory::create(new PredTable(first, universe), {Pattern::OUTPUT}, {var}, universe);
+		genvalues.clear();
+		for(gen->begin(); not gen->isAtEnd(); gen->operator ++()){
+			genvalues.insert(var->get()->value()._int);
+		}
+		ASSERT_EQ(genvalues, (set<int>{1, 2}));
+
+		var->operator =(createDomElem(3));
+		gen = GeneratorFactory::create(new PredTable(first, universe), {Pattern::INPUT}, {var}, universe);
+		ASSERT_FALSE(gen->check());
+	}
 }
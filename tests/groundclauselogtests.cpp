@@ -0,0 +1,39 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "groundtheories/GroundClauseLog.hpp"
+
+using namespace std;
+
+namespace Tests {
+
+TEST(GroundClauseLogTest, SpilledClausesAreReadBackInOrder) {
+	vector<GroundClause> clauses = { { 1, -2, 3 }, { }, { -100000, 100000 }, { 7 }, { 2147483647, -2147483647 }, { 5, 4, 3, 2, 1 } };
+	GroundClauseLog log;
+	log.setWindow(3);
+	for (auto& clause : clauses) {
+		log.add(clause);
+	}
+	ASSERT_EQ(clauses.size(), log.size());
+	ASSERT_LT(0u, log.nbSpilledBytes());
+	for (int pass = 0; pass < 2; ++pass) {
+		vector<GroundClause> read;
+		for (auto& clause : log) {
+			read.push_back(clause);
+		}
+		ASSERT_EQ(clauses, read);
+	}
+}
+
+}
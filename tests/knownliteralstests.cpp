@@ -0,0 +1,49 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "testingtools.hpp"
+#include "IncludeComponents.hpp"
+#include "inferences/grounding/LazyGroundingManager.hpp"
+
+using namespace std;
+
+namespace Tests {
+
+TEST(KnownLiteralsTest, IndexMatchesLiteralsAddedBeforeAndAfter) {
+	DataManager m;
+	auto one = createDomElem(1), two = createDomElem(2), three = createDomElem(3);
+	KnownLiterals lits;
+	lits.add(1, { one, two });
+	lits.add(2, { two, two });
+	lits.addIndex(1);
+	lits.add(3, { one, three });
+	lits.add(4, { three, two });
+	lits.addIndex(1); // Requesting an index twice keeps it
+	ASSERT_TRUE(lits.hasIndex(1));
+	ASSERT_FALSE(lits.hasIndex(0));
+	ASSERT_EQ(4u, lits.size());
+
+	auto matching = lits.matching(1, two);
+	vector<Atom> atoms;
+	for (auto index : matching) {
+		ASSERT_EQ(two, lits[index].second[1]);
+		atoms.push_back(lits[index].first);
+	}
+	ASSERT_EQ(vector<Atom>({ 1, 2, 4 }), atoms);
+	ASSERT_EQ(1u, lits.matching(1, three).size());
+	ASSERT_EQ(3, lits[lits.matching(1, three)[0]].first);
+	ASSERT_TRUE(lits.matching(1, one).empty());
+}
+
+}
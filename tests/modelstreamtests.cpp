@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "external/runidp.hpp"
+
+using namespace std;
+
+namespace Tests {
+
+// Runs streammodels with the given arguments and options on the models of
+// 		#{x : P(x)} = 2. with P(1) true in the input structure and P over {1..4},
+// and returns what was written to stdout
+string streamModels(const string& args, const string& options) {
+	string idpfile = "modelstreamtest.idp";
+	{
+		ofstream out(idpfile);
+		out << "vocabulary V { type T = {1..4} isa int\n P(T) }\n"
+			<< "theory T : V { #{x : P(x)} = 2. }\n"
+			<< "structure S : V { P<ct> = {1} }\n"
+			<< "procedure main() { stdoptions.nbmodels = 0\n" << options << "\n if streammodels(" << args << ") == 3 then return 1 else return 0 end }\n";
+	}
+	stringstream captured;
+	auto coutbuffer = cout.rdbuf(captured.rdbuf());
+	auto result = test( { idpfile });
+	cout.rdbuf(coutbuffer);
+	std::remove(idpfile.c_str());
+	EXPECT_EQ(Status::SUCCESS, result);
+	return captured.str();
+}
+
+vector<string> toLines(const string& output) {
+	stringstream stream(output);
+	vector<string> lines;
+	string line;
+	while (getline(stream, line)) {
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+// Checks that the lines are the three models, each with P(1) and one other true tuple
+void checkFullModels(const string& output) {
+	auto lines = toLines(output);
+	ASSERT_EQ(3u, lines.size());
+	set<string> others;
+	for (size_t i = 0; i < lines.size(); ++i) {
+		string prefix = "{\"model\":" + to_string(i + 1) + ",\"P/1\":[[1],[";
+		ASSERT_EQ(prefix, lines[i].substr(0, prefix.size()));
+		ASSERT_EQ("]]}", lines[i].substr(lines[i].size() - 3));
+		others.insert(lines[i].substr(prefix.size(), lines[i].size() - 3 - prefix.size()));
+	}
+	ASSERT_EQ(set<string>( { "2", "3", "4" }), others);
+}
+
+// Checks that the lines are the first model, followed by the diffs which replace its second true tuple by another one
+void checkDiffs(const string& output) {
+	auto lines = toLines(output);
+	ASSERT_EQ(3u, lines.size());
+	string prefix = "{\"model\":1,\"P/1\":[[1],[";
+	ASSERT_EQ(prefix, lines[0].substr(0, prefix.size()));
+	auto previous = lines[0].substr(prefix.size(), lines[0].size() - 3 - prefix.size());
+	set<string> others = { previous };
+	for (size_t i = 1; i < lines.size(); ++i) {
+		prefix = "{\"model\":" + to_string(i + 1) + ",\"diff\":true,\"P/1\":{\"add\":[[";
+		ASSERT_EQ(prefix, lines[i].substr(0, prefix.size()));
+		auto added = lines[i].substr(prefix.size(), 1);
+		ASSERT_EQ(added + "]],\"remove\":[[" + previous + "]]}}", lines[i].substr(prefix.size() + 1));
+		others.insert(added);
+		previous = added;
+	}
+	ASSERT_EQ(set<string>( { "2", "3", "4" }), others);
+}
+
+TEST(ModelStreamTest, WritesStructuresAsJSONLines) {
+	checkFullModels(streamModels("T,S", "stdoptions.modelstream = \"jsonl\""));
+}
+
+TEST(ModelStreamTest, WritesDeltasAsJSONLines) {
+	checkFullModels(streamModels("T,S,V", "stdoptions.modelstream = \"jsonl\""));
+}
+
+TEST(ModelStreamTest, WritesDiffsOfStructures) {
+	checkDiffs(streamModels("T,S", "stdoptions.modelstream = \"jsonl\"\n stdoptions.modelstreamdiff = true"));
+}
+
+TEST(ModelStreamTest, WritesDiffsOfDeltas) {
+	checkDiffs(streamModels("T,S,V", "stdoptions.modelstream = \"jsonl\"\n stdoptions.modelstreamdiff = true"));
+}
+
+TEST(ModelStreamTest, WritesBinaryModels) {
+	auto stream = streamModels("T,S,V", "stdoptions.modelstream = \"binary\"");
+	// Per model: 'M', the model number, 1 symbol, its name "P/1", 2 tuples and the integers 1 and another one
+	const size_t modelsize = 1 + 4 + 4 + 4 + 3 + 4 + 2 * 5;
+	ASSERT_EQ(3 * modelsize, stream.size());
+	for (unsigned int i = 0; i < 3; ++i) {
+		auto model = stream.substr(i * modelsize, modelsize);
+		ASSERT_EQ('M', model[0]);
+		ASSERT_EQ(string( { (char) (i + 1), 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0 }), model.substr(1, 12));
+		ASSERT_EQ("P/1", model.substr(13, 3));
+		ASSERT_EQ(string( { 2, 0, 0, 0, 0, 1, 0, 0, 0, 0 }), model.substr(16, 10));
+	}
+}
+
+}
@@ -0,0 +1,37 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "FileEnumerator.hpp"
+
+namespace Tests {
+
+// The encodings only introduce atoms defined by the set literals, so the number of models is preserved
+TEST_P(MXnbTest, DoesMXWithSequentialCounters) {
+	runTests("modelexpansion.idp", GetParam(), "mxaggencoding(\"sequential\")");
+}
+
+TEST_P(MXnbTest, DoesMXWithTotalizers) {
+	runTests("modelexpansion.idp", GetParam(), "mxaggencoding(\"totalizer\")");
+}
+
+TEST_P(MXnbTest, DoesMXWithSortingNetworks) {
+	runTests("modelexpansion.idp", GetParam(), "mxaggencoding(\"sortingnetwork\")");
+}
+
+TEST_P(MXnbTest, DoesMXWithAggregateBDDs) {
+	runTests("modelexpansion.idp", GetParam(), "mxaggencoding(\"bdd\")");
+}
+
+TEST_P(MXsatTest, DoesSatMXWithAggregatesAsClauses) {
+	runTests("satisfiability.idp", GetParam(), "sataggencoding(\"auto\")");
+}
+
+}
@@ -19,4 +19,8 @@ TEST_P(SlowMXsatTest, DoesSlowMXWithBounds) {
 	runTests("satisfiability.idp", GetParam(), "satwithboundslong()");
 }
 
+TEST_P(SlowMXsatTest, DoesSlowMXWithAggregatesAsClauses) {
+	runTests("satisfiability.idp", GetParam(), "sataggencodinglong(\"auto\")");
+}
+
 }
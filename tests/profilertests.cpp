@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "external/runidp.hpp"
+#include "utils/Profiler.hpp"
+
+using namespace std;
+
+namespace Tests {
+
+TEST(ProfilerTest, ReportsThePhasesOfAModelExpansion) {
+	string idpfile = "profilertest.idp";
+	{
+		ofstream out(idpfile);
+		out << "vocabulary V { type T = {1..20} isa int\n P(T,T) }\n"
+			<< "theory T : V { !x: ?1 y: P(x,y). !x y z: P(x,y) & P(z,y) => x = z. }\n"
+			<< "structure S : V { }\n"
+			<< "procedure main() { stdoptions.nbmodels = 5\n if #modelexpand(T,S) == 5 then return 1 else return 0 end }\n";
+	}
+	Profiler::start(1);
+	ASSERT_TRUE(Profiler::running());
+	auto result = test( { idpfile });
+	stringstream collapsed, times;
+	Profiler::stop(&collapsed, times);
+	std::remove(idpfile.c_str());
+	ASSERT_EQ(Status::SUCCESS, result);
+	ASSERT_FALSE(Profiler::running());
+
+	// Every phase is reported as "<name>: <ms> ms in <count> run(s)"
+	set<string> phases;
+	string line;
+	while (getline(times, line)) {
+		auto colon = line.find(": ");
+		ASSERT_NE(string::npos, colon) << line;
+		long long ms = -1, count = -1;
+		ASSERT_EQ(2, sscanf(line.c_str() + colon + 2, "%lld ms in %lld run(s)", &ms, &count)) << line;
+		ASSERT_LE(0, ms);
+		ASSERT_LT(0, count);
+		phases.insert(line.substr(0, colon));
+	}
+	ASSERT_EQ(1u, phases.count("modelexpand"));
+	ASSERT_EQ(1u, phases.count("grounding"));
+	ASSERT_EQ(1u, phases.count("solving"));
+
+	// Every sampled stack is "idp;<frame>;...;<frame> <count>", and frames are named after phases
+	while (getline(collapsed, line)) {
+		auto space = line.rfind(' ');
+		ASSERT_NE(string::npos, space) << line;
+		ASSERT_LT(0, stol(line.substr(space + 1))) << line;
+		stringstream frames(line.substr(0, space));
+		string frame;
+		ASSERT_TRUE((bool) getline(frames, frame, ';'));
+		ASSERT_EQ("idp", frame);
+		while (getline(frames, frame, ';')) {
+			auto name = frame.substr(0, frame.find('['));
+			ASSERT_EQ(1u, phases.count(name)) << line;
+		}
+	}
+}
+
+}
@@ -0,0 +1,112 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "testingtools.hpp"
+#include "IncludeComponents.hpp"
+#include "inferences/propagation/PropagationScheduler.hpp"
+#include "inferences/propagation/PropagationDomain.hpp"
+#include "inferences/propagation/PropagationDomainFactory.hpp"
+
+using namespace std;
+
+namespace Tests {
+
+// Pops the next propagation and returns its parent
+const Formula* nextParent(FOPropScheduler& scheduler) {
+	auto propagation = scheduler.next();
+	auto parent = propagation->getParent();
+	delete (propagation);
+	return parent;
+}
+
+TEST(FOPropSchedulerTest, CheapestPropagationsComeFirst) {
+	DataManager m;
+	auto ts = getTestingSet1();
+	FOPropScheduler scheduler;
+	ASSERT_TRUE(scheduler.add(new FOPropagation(ts.px, DOWN, true, NULL), 3));
+	ASSERT_TRUE(scheduler.add(new FOPropagation(ts.qx, DOWN, true, NULL), 1));
+	ASSERT_TRUE(scheduler.add(new FOPropagation(ts.rx, DOWN, true, NULL), 2));
+	ASSERT_EQ(ts.qx, nextParent(scheduler));
+	ASSERT_EQ(ts.rx, nextParent(scheduler));
+	ASSERT_EQ(ts.px, nextParent(scheduler));
+	ASSERT_FALSE(scheduler.hasNext());
+	cleanTestingSet1();
+}
+
+TEST(FOPropSchedulerTest, EquallyExpensivePropagationsComeInScheduledOrder) {
+	DataManager m;
+	auto ts = getTestingSet1();
+	FOPropScheduler scheduler;
+	scheduler.add(new FOPropagation(ts.rx, DOWN, true, NULL));
+	scheduler.add(new FOPropagation(ts.px, DOWN, true, NULL));
+	scheduler.add(new FOPropagation(ts.qx, DOWN, true, NULL));
+	ASSERT_EQ(ts.rx, nextParent(scheduler));
+	// A propagation scheduled again after it was executed goes to the back
+	scheduler.add(new FOPropagation(ts.rx, DOWN, true, NULL));
+	ASSERT_EQ(ts.px, nextParent(scheduler));
+	ASSERT_EQ(ts.qx, nextParent(scheduler));
+	ASSERT_EQ(ts.rx, nextParent(scheduler));
+	ASSERT_FALSE(scheduler.hasNext());
+	cleanTestingSet1();
+}
+
+TEST(FOPropSchedulerTest, DuplicatePropagationsAreMerged) {
+	DataManager m;
+	auto ts = getTestingSet1();
+	FOPropScheduler scheduler;
+	ASSERT_TRUE(scheduler.add(new FOPropagation(ts.px, DOWN, true, NULL), 1));
+	ASSERT_TRUE(scheduler.add(new FOPropagation(ts.px, DOWN, false, NULL), 1));
+	ASSERT_TRUE(scheduler.add(new FOPropagation(ts.px, UP, true, ts.qx), 1));
+	ASSERT_FALSE(scheduler.add(new FOPropagation(ts.px, DOWN, true, NULL), 1));
+	ASSERT_FALSE(scheduler.add(new FOPropagation(ts.px, UP, true, ts.qx), 1));
+	ASSERT_EQ(3, scheduler.nbScheduled());
+	ASSERT_EQ(2, scheduler.nbMerged());
+	for (int i = 0; i < 3; ++i) {
+		ASSERT_TRUE(scheduler.hasNext());
+		nextParent(scheduler);
+	}
+	ASSERT_FALSE(scheduler.hasNext());
+	cleanTestingSet1();
+}
+
+TEST(FOPropSchedulerTest, MergedPropagationsGetTheNewCost) {
+	DataManager m;
+	auto ts = getTestingSet1();
+	FOPropScheduler scheduler;
+	scheduler.add(new FOPropagation(ts.px, DOWN, true, NULL), 1);
+	scheduler.add(new FOPropagation(ts.qx, DOWN, true, NULL), 2);
+	scheduler.add(new FOPropagation(ts.rx, DOWN, true, NULL), 2);
+	ASSERT_FALSE(scheduler.add(new FOPropagation(ts.px, DOWN, true, NULL), 5));
+	ASSERT_FALSE(scheduler.add(new FOPropagation(ts.rx, DOWN, true, NULL), 0));
+	ASSERT_EQ(ts.rx, nextParent(scheduler));
+	ASSERT_EQ(ts.qx, nextParent(scheduler));
+	ASSERT_EQ(ts.px, nextParent(scheduler));
+	cleanTestingSet1();
+}
+
+TEST(FOPropSchedulerTest, CostOfABDDDomainIsItsNumberOfNodes) {
+	DataManager m;
+	auto ts = getTestingSet1();
+	FOPropBDDDomainFactory factory;
+	auto px = factory.formuladomain(ts.px);
+	auto qx = factory.formuladomain(ts.qx);
+	auto pxandqx = factory.conjunction(px, qx);
+	ASSERT_EQ(1, factory.cost(px));
+	ASSERT_EQ(2, factory.cost(pxandqx));
+	ASSERT_EQ(2, factory.cost(pxandqx));
+	delete (pxandqx);
+	delete (qx);
+	delete (px);
+	cleanTestingSet1();
+}
+
+}
@@ -24,8 +24,10 @@
 #include "fobdds/FoBddVariable.hpp"
 #include "generators/BDDBasedGeneratorFactory.hpp"
 #include "inferences/propagation/PropagatorFactory.hpp"
+#include "inferences/propagation/BoundsCache.hpp"
 #include "inferences/propagation/GenerateBDDAccordingToBounds.hpp"
 #include "TestUtils.hpp"
+#include "testingtools.hpp"
 #include "utils/FileManagement.hpp"
 #include "generators/TableCheckerAndGenerators.hpp"
 
@@ -81,6 +83,37 @@ vector<string> generateListOfPropagationFiles() {
 	ASSERT_EQ(5, counter);
 }*/
 
+TEST(BoundsCache, ReusesAPropagatorUntilTheTheoryChanges) {
+	DataManager m;
+	auto ts = getTestingSet1();
+	auto cache = BoundsCache::instance();
+	auto theory = new Theory("T", ts.vocabulary, ParseInfo());
+	theory->add(ts.Axpx->clone());
+	auto mpi = propagateVocabulary(theory, ts.structure);
+
+	auto first = cache->propagator(theory, ts.structure, mpi, false);
+	ASSERT_EQ(first, cache->propagator(theory, ts.structure, mpi, false));
+
+	theory->add(ts.nExqx->clone());
+	auto second = cache->propagator(theory, ts.structure, mpi, false);
+	ASSERT_NE(first, second);
+	ASSERT_EQ(second, cache->propagator(theory, ts.structure, mpi, false));
+
+	// A copy of the theory is a different theory
+	auto copy = theory->clone();
+	ASSERT_NE(second, cache->propagator(copy, ts.structure, mpi, false));
+	copy->recursiveDelete();
+
+	auto othervoc = new Vocabulary("W");
+	auto other = new Structure("S", othervoc, ParseInfo());
+	ASSERT_THROW(cache->propagator(theory, other, mpi, false), IdpException);
+
+	delete (other);
+	delete (othervoc);
+	theory->recursiveDelete();
+	cleanTestingSet1();
+}
+
 class LuaPropagationTest: public ::testing::TestWithParam<string> {
 };
 
@@ -44,6 +44,23 @@ TEST(InternalQueryTest,MultipleOccurencesOfSameVar){
 	ASSERT_EQ(one,size._size);
 }
 
+TEST(InternalQueryTest,SolvesAnOwnedFormulaWithoutAQuery){
+	auto ts1 = getTestingSet1();
+	SortedElementTable els;
+	els.insert({createDomElem(0),createDomElem(0)});
+	els.insert({createDomElem(1),createDomElem(1)});
+	els.insert({createDomElem(0),createDomElem(1)});
+	Universe univ({ts1.sorttable,ts1.sorttable});
+	auto str = ts1.structure;
+	str->changeInter(ts1.s,new PredInter(new PredTable(new EnumeratedInternalPredTable(els),univ),true));
+	auto res = Querying::doSolveFormula({ts1.x},ts1.sxx->clone(),str,NULL);
+	auto size = res->size();
+	ASSERT_EQ(TableSizeType::TST_EXACT,size._type);
+	ASSERT_EQ(2,size._size);
+	ASSERT_TRUE(res->contains({createDomElem(0)}));
+	ASSERT_TRUE(res->contains({createDomElem(1)}));
+}
+
 vector<string> generateListOfQueryFiles() {
 	vector<string> testdirs {"simple/", "aggregates/", "threevalued/"};
 	return getAllFilesInDirs(getTestDirectory() + "query/", testdirs);
@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum 
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "external/serve.hpp"
+#include "common.hpp"
+#include "GlobalData.hpp"
+#include "options.hpp"
+#include "testingtools.hpp"
+
+using namespace std;
+
+namespace Tests {
+
+// Feeds the lines to a reader and returns the completed requests
+vector<Request> readRequests(const vector<string>& lines) {
+	RequestReader reader;
+	vector<Request> requests;
+	for (auto& line : lines) {
+		Request request;
+		if (reader.addLine(line, request)) {
+			requests.push_back(request);
+		}
+	}
+	return requests;
+}
+
+TEST(ServeTest, RequestsEndAtTheDotLine) {
+	auto requests = readRequests( { "", "request 1", "local x = 1", "return x", ".", "stats 2\r", "request 3\r", "return 3\r", ".\r", "shutdown" });
+	ASSERT_EQ(4u, requests.size());
+	ASSERT_EQ("request", requests[0].command);
+	ASSERT_EQ("1", requests[0].id);
+	ASSERT_EQ("local x = 1\nreturn x\n", requests[0].chunk);
+	ASSERT_EQ("stats", requests[1].command);
+	ASSERT_EQ("2", requests[1].id);
+	ASSERT_EQ("return 3\n", requests[2].chunk);
+	ASSERT_EQ("shutdown", requests[3].command);
+	ASSERT_EQ("-", requests[3].id);
+}
+
+TEST(ServeTest, UnfinishedRequestIsNotReturned) {
+	auto requests = readRequests( { "request 1", "return 1", " .", ". " });
+	ASSERT_TRUE(requests.empty());
+}
+
+TEST(ServeTest, DotStuffedLinesAreRestored) {
+	auto requests = readRequests( { "request 1", "..", "...x", ".y", "a.", "." });
+	ASSERT_EQ(1u, requests.size());
+	ASSERT_EQ(".\n..x\n.y\na.\n", requests[0].chunk);
+}
+
+TEST(ServeTest, HeaderOptionsAreParsed) {
+	auto requests = readRequests( { "request 1  timeout=5 verbosity=0 flag a=b=c", "return 1", "." });
+	ASSERT_EQ(1u, requests.size());
+	vector<pair<string, string> > expected { { "timeout", "5" }, { "verbosity", "0" }, { "flag", "" }, { "a", "b=c" } };
+	ASSERT_EQ(expected, requests[0].options);
+}
+
+TEST(ServeTest, OptionsOnlyHoldForTheirRequest) {
+	DataManager m;
+	auto original = getOption(IntType::NBMODELS);
+	auto requests = readRequests( { "request 1 nbmodels=7", "return stdoptions.nbmodels", ".", "request 2", "return stdoptions.nbmodels", "." });
+	ASSERT_EQ(2u, requests.size());
+
+	auto response = handle(requests[0]);
+	ASSERT_EQ("1", response.id);
+	ASSERT_EQ("ok", response.status);
+	ASSERT_EQ(vector<string> { "7" }, response.payload);
+	ASSERT_EQ(original, getOption(IntType::NBMODELS));
+
+	response = handle(requests[1]);
+	ASSERT_EQ("ok", response.status);
+	ASSERT_EQ(vector<string> { convertToString(original) }, response.payload);
+}
+
+TEST(ServeTest, InvalidOptionRejectsTheRequest) {
+	DataManager m;
+	auto original = getOption(IntType::NBMODELS);
+	auto requests = readRequests( { "request 1 nbmodels=7 nosuchoption=1", "stdoptions.nbmodels = 9", "." });
+	ASSERT_EQ(1u, requests.size());
+
+	auto response = handle(requests[0]);
+	ASSERT_EQ("error", response.status);
+	ASSERT_EQ(1u, response.payload.size());
+	ASSERT_EQ(original, getOption(IntType::NBMODELS));
+}
+
+}
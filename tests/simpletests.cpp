@@ -9,6 +9,7 @@
  * Celestijnenlaan 200A, B-3001 Leuven, Belgium
  ****************************************************************************/
 
+#include <algorithm>
 #include <cmath>
 
 #include "gtest/gtest.h"
@@ -21,6 +22,8 @@
 #include "theory/theory.hpp"
 #include "theory/TheoryUtils.hpp"
 #include "inferences/modelexpansion/ModelExpansion.hpp"
+#include "inferences/modelIteration/CubeAndConquer.hpp"
+#include "inferences/modelIteration/ModelCounting.hpp"
 #include "testingtools.hpp"
 
 #include <dirent.h>
@@ -410,3 +413,53 @@ TEST(SimpleMX,NoPushNegations){
 	models = ModelExpansion::doModelExpansion(T->clone(), S->clone());
 	ASSERT_FALSE(models.unsat);
 }
+
+TEST(SimpleTest, VocabularyLookupByNameWithoutArity) {
+	DataManager m;
+	auto sort = new Sort("x", new SortTable(new IntRangeInternalSortTable(-2, 2)));
+	auto unary = new Predicate("P", {sort});
+	auto binary = new Predicate("P", {sort, sort});
+	auto other = new Predicate("Q", {sort});
+	auto vocabulary = new Vocabulary("V");
+	vocabulary->add(sort);
+	auto changes = Vocabulary::nbChanges();
+	vocabulary->add(unary);
+	vocabulary->add(binary);
+	vocabulary->add(other);
+	ASSERT_LT(changes, Vocabulary::nbChanges());
+	ASSERT_EQ(unary, vocabulary->pred(unary->name()));
+	ASSERT_EQ(binary, vocabulary->pred(binary->name()));
+	ASSERT_EQ(std::set<Predicate*>({unary, binary}), vocabulary->pred_no_arity("P"));
+	ASSERT_EQ(std::set<Predicate*>({other}), vocabulary->pred_no_arity("Q"));
+	ASSERT_TRUE(vocabulary->pred_no_arity("R").empty());
+	ASSERT_EQ(sort, vocabulary->sort("x"));
+	delete (vocabulary); // Also deletes the symbols, which are in no other vocabulary
+}
+
+TEST(SimpleTest, CubesSplitSampledModelsEvenly) {
+	// Atom 1 is true in all samples, atoms 2 and 3 always have the same value, atom 4 splits the samples on atom 2 evenly
+	std::vector<litlist> samples { { 1, 2, 3, 4 }, { 1, 2, 3, -4 }, { 1, -2, -3, 4 }, { 1, -2, -3, -4 } };
+	auto splitatoms = CubeAndConquer::chooseSplitAtoms( { 1, 2, 3, 4 }, samples, 3);
+	ASSERT_EQ(2u, splitatoms.size());
+	ASSERT_TRUE(std::find(splitatoms.cbegin(), splitatoms.cend(), 1) == splitatoms.cend());
+	ASSERT_TRUE(std::find(splitatoms.cbegin(), splitatoms.cend(), 4) != splitatoms.cend());
+
+	auto cubes = CubeAndConquer::makeCubes(splitatoms);
+	ASSERT_EQ(4u, cubes.size());
+	for (const auto& sample : samples) {
+		int nbcubes = 0;
+		for (const auto& cube : cubes) {
+			bool contained = true;
+			for (auto lit : cube) {
+				contained &= std::find(sample.cbegin(), sample.cend(), lit) != sample.cend();
+			}
+			nbcubes += contained ? 1 : 0;
+		}
+		ASSERT_EQ(1, nbcubes);
+	}
+}
+
+TEST(SimpleTest, CountingMedianIgnoresFailedTrials) {
+	ASSERT_EQ(64, ModelCounting::median( { 128, -1, 32, 64, -1 }));
+	ASSERT_LT(ModelCounting::median( { -1, -1 }), 0);
+}
@@ -0,0 +1,59 @@
+/*****************************************************************************
+ * Copyright 2010-2012 Katholieke Universiteit Leuven
+ *
+ * Use of this software is governed by the GNU LGPLv3.0 license
+ *
+ * Written by Broes De Cat, Bart Bogaerts, Stef De Pooter, Johan Wittocx,
+ * Jo Devriendt, Joachim Jansen and Pieter Van Hertum
+ * K.U.Leuven, Departement Computerwetenschappen,
+ * Celestijnenlaan 200A, B-3001 Leuven, Belgium
+ ****************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "external/runidp.hpp"
+#include "lua/StartupSnapshot.hpp"
+#include "errorhandling/error.hpp"
+#include "testingtools.hpp"
+
+using namespace std;
+
+namespace Tests {
+
+TEST(StartupSnapshotTest, WrittenSnapshotIsLoadedAndRunsTheStandardLibrary) {
+	string snapshotfile = "startupsnapshottest.snapshot";
+	string idpfile = "startupsnapshottest.idp";
+	auto oldmode = StartupSnapshot::mode();
+	std::remove(snapshotfile.c_str());
+
+	StartupSnapshot::setPath(snapshotfile);
+	StartupSnapshot::setMode(SnapshotMode::WRITE);
+	{
+		DataManager m;
+		EXPECT_EQ(0u, Error::nr_of_errors());
+	}
+	auto snapshot = StartupSnapshot::read(snapshotfile);
+	EXPECT_TRUE(snapshot != NULL);
+	delete snapshot;
+
+	// modelexpand is a procedure of the standard library, so it can only be called if the snapshot was loaded correctly
+	{
+		ofstream out(idpfile);
+		out << "vocabulary V { type T = {1..3} isa int\n P(T) }\n"
+			<< "theory T : V { ?x: P(x). }\n"
+			<< "structure S : V { }\n"
+			<< "procedure main() { stdoptions.nbmodels = 0\n if #modelexpand(T,S) == 7 then return 1 else return 0 end }\n";
+	}
+	StartupSnapshot::setMode(SnapshotMode::LOAD);
+	auto result = test( { idpfile });
+
+	StartupSnapshot::setMode(oldmode);
+	StartupSnapshot::setPath("");
+	std::remove(snapshotfile.c_str());
+	std::remove(idpfile.c_str());
+	ASSERT_EQ(Status::SUCCESS, result);
+}
+
+}
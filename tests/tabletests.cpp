@@ -15,6 +15,8 @@
 #include "external/runidp.hpp"
 #include "IncludeComponents.hpp"
 #include "structure/StructureComponents.hpp"
+#include "structure/TableIndexes.hpp"
+#include "structure/TableView.hpp"
 #include "fobdds/FoBddManager.hpp"
 #include "fobdds/FoBdd.hpp"
 #include "fobdds/FoBddVariable.hpp"
@@ -84,4 +86,197 @@ TEST(TableTest, FunctionInterpretationTest) {
 	
 }
 
+TEST(TableTest, TableStatisticsCaptureSkew) {
+	auto factory = getGlobal()->getGlobalDomElemFactory();
+	auto tab = new EnumeratedInternalPredTable();
+	for (int i = 1; i <= 9; ++i) {
+		tab->add( { factory->create(1), factory->create(i) });
+	}
+	tab->add( { factory->create(2), factory->create(10) });
+
+	auto stats = tab->statistics();
+	ASSERT_EQ(10u, stats->size());
+	ASSERT_EQ(2u, stats->arity());
+	ASSERT_EQ(2u, stats->column(0).distinct);
+	ASSERT_EQ(10u, stats->column(1).distinct);
+	ASSERT_EQ(factory->create(1), stats->column(0).heavyhitters.front().first);
+	ASSERT_DOUBLE_EQ(9, stats->frequency(0, factory->create(1)));
+	ASSERT_DOUBLE_EQ(0.82, stats->selectivity(0)); // (9*9 + 1*1) / (10*10), a uniform estimate would be 0.5
+	ASSERT_DOUBLE_EQ(8.2, stats->expectedMatches( { true, false }));
+	ASSERT_DOUBLE_EQ(1, stats->expectedMatches( { false, true }));
+
+	tab->add( { factory->create(2), factory->create(11) });
+	ASSERT_EQ(11u, tab->statistics()->size());
+	delete (tab);
+}
+
+TEST(TableTest, TableIndexesAreClearedOnChange) {
+	auto factory = getGlobal()->getGlobalDomElemFactory();
+	auto tab = new EnumeratedInternalPredTable();
+	tab->add( { factory->create(1), factory->create(2) });
+
+	auto before = TableIndexes::totalMemory();
+	IndexPattern pattern = { TableIndexes::INPUTCOLUMN, TableIndexes::OUTPUTCOLUMN };
+	auto index = shared_ptr<LookupTable>(new LookupTable());
+	(*index)[ { factory->create(1) }].push_back( { factory->create(2) });
+	tab->indexes().add(pattern, index);
+	ASSERT_EQ(index, tab->indexes().get(pattern));
+	ASSERT_TRUE(tab->indexes().get( { TableIndexes::OUTPUTCOLUMN, TableIndexes::OUTPUTCOLUMN }) == NULL);
+	ASSERT_LT(before, TableIndexes::totalMemory());
+
+	tab->add( { factory->create(1), factory->create(3) });
+	ASSERT_TRUE(tab->indexes().get(pattern) == NULL);
+	ASSERT_EQ(before, TableIndexes::totalMemory());
+	delete (tab);
+}
+
+TEST(TableTest, EnumeratedSortTableNumbersElementsDensely) {
+	auto factory = getGlobal()->getGlobalDomElemFactory();
+	auto table = new SortTable(new EnumeratedInternalSortTable());
+	table->add(factory->create("c"));
+	table->add(factory->create("a"));
+	table->add(factory->create("b"));
+	table->add(factory->create("a"));
+
+	auto internal = dynamic_cast<EnumeratedInternalSortTable*>(table->internTable());
+	ASSERT_TRUE(internal != NULL);
+	ASSERT_EQ(3, table->size()._size);
+	ASSERT_EQ(factory->create("a"), table->first());
+	ASSERT_EQ(factory->create("c"), table->last());
+	for (int i = 0; i < 3; ++i) {
+		ASSERT_EQ(i, internal->rank(internal->element(i)));
+	}
+	ASSERT_EQ(1, internal->rank(factory->create("b")));
+	ASSERT_EQ(-1, internal->rank(factory->create("d")));
+
+	table->remove(factory->create("a"));
+	ASSERT_FALSE(table->contains(factory->create("a")));
+	ASSERT_EQ(0, internal->rank(factory->create("b")));
+	std::vector<const DomainElement*> elements;
+	for (auto it = table->sortBegin(); not it.isAtEnd(); ++it) {
+		elements.push_back(*it);
+	}
+	ASSERT_EQ((std::vector<const DomainElement*> { factory->create("b"), factory->create("c") }), elements);
+	delete (table);
+}
+
+TEST(TableTest, EnumeratedSortTableChangesACopyWhileIterating) {
+	auto factory = getGlobal()->getGlobalDomElemFactory();
+	auto table = new SortTable(new EnumeratedInternalSortTable());
+	table->add(factory->create("a"));
+	table->add(factory->create("b"));
+
+	// The iterator keeps iterating over the elements it started with
+	auto it = table->sortBegin();
+	table->add(factory->create("c"));
+	table->remove(factory->create("a"));
+	std::vector<const DomainElement*> elements;
+	for (; not it.isAtEnd(); ++it) {
+		elements.push_back(*it);
+	}
+	ASSERT_EQ((std::vector<const DomainElement*> { factory->create("a"), factory->create("b") }), elements);
+	ASSERT_TRUE(table->contains(factory->create("c")));
+	ASSERT_FALSE(table->contains(factory->create("a")));
+
+	// An iterator can outlive its table
+	auto last = table->sortBegin();
+	delete (table);
+	elements.clear();
+	for (; not last.isAtEnd(); ++last) {
+		elements.push_back(*last);
+	}
+	ASSERT_EQ((std::vector<const DomainElement*> { factory->create("b"), factory->create("c") }), elements);
+}
+
+TEST(TableTest, SmallElementTuplesOnlyAllocateAboveInlineSize) {
+	auto factory = getGlobal()->getGlobalDomElemFactory();
+	auto before = SmallElementTuple::nbHeapAllocations();
+	LookupTable index;
+	for (int i = 0; i < 1000; ++i) {
+		SmallElementTuple key;
+		for (unsigned int n = 0; n < SmallElementTuple::INLINESIZE; ++n) {
+			key.push_back(factory->create((int) (i + n)));
+		}
+		index[key].push_back(SmallElementTuple(ElementTuple { factory->create(i) }));
+	}
+	ASSERT_EQ(before, SmallElementTuple::nbHeapAllocations());
+
+	// Lookups with an ElementTuple find the same key
+	ElementTuple lookup { factory->create(7), factory->create(8), factory->create(9), factory->create(10) };
+	ASSERT_TRUE(index.find(lookup) != index.cend());
+	ASSERT_EQ(factory->create(7), index[lookup][0][0]);
+
+	SmallElementTuple large(SmallElementTuple::INLINESIZE, factory->create(1));
+	large.push_back(factory->create(2));
+	ASSERT_EQ(before + 1, SmallElementTuple::nbHeapAllocations());
+	ASSERT_EQ(SmallElementTuple::INLINESIZE + 1, large.size());
+	ASSERT_EQ(factory->create(2), large[SmallElementTuple::INLINESIZE]);
+	auto moved = std::move(large);
+	ASSERT_EQ(before + 1, SmallElementTuple::nbHeapAllocations());
+	ASSERT_EQ(moved.toVector(), (ElementTuple { factory->create(1), factory->create(1), factory->create(1), factory->create(1), factory->create(2) }));
+	// A proper prefix comes first
+	ASSERT_TRUE(SmallElementTuple(ElementTuple { factory->create(1) }) < moved);
+	ASSERT_FALSE(moved < SmallElementTuple(ElementTuple { factory->create(1) }));
+}
+
+TEST(TableTest, SmallElementTupleViewsSearchWithoutAllocating) {
+	auto factory = getGlobal()->getGlobalDomElemFactory();
+	ElementTuple large, other;
+	for (unsigned int n = 0; n <= SmallElementTuple::INLINESIZE; ++n) {
+		large.push_back(factory->create((int) n));
+		other.push_back(factory->create((int) n + 1));
+	}
+	std::unordered_map<SmallElementTuple, int, HashTuple> atoms;
+	atoms[large] = 1;
+	auto before = SmallElementTuple::nbHeapAllocations();
+	auto it = atoms.find(SmallElementTuple::view(large));
+	ASSERT_TRUE(it != atoms.cend());
+	ASSERT_EQ(1, it->second);
+	ASSERT_TRUE(atoms.find(SmallElementTuple::view(other)) == atoms.cend());
+	ASSERT_TRUE(atoms.find(SmallElementTuple::view(ElementTuple { })) == atoms.cend());
+	ASSERT_EQ(before, SmallElementTuple::nbHeapAllocations());
+
+	// A copy of a view owns its elements
+	auto view = SmallElementTuple::view(large);
+	SmallElementTuple copy(view);
+	large[0] = factory->create(-1);
+	ASSERT_EQ(factory->create(0), copy[0]);
+
+	// Changing a view would change the viewed tuple, moving another tuple into it replaces the view
+	ASSERT_THROW(view.push_back(factory->create(5)), IdpException);
+	ASSERT_THROW(view = copy, IdpException);
+	ASSERT_THROW(view[0] = factory->create(5), IdpException);
+	ASSERT_THROW(view.clear(), IdpException);
+	ASSERT_EQ(SmallElementTuple::INLINESIZE + 1, large.size());
+	ASSERT_EQ(factory->create(-1), large[0]);
+	view = SmallElementTuple(copy);
+	view.push_back(factory->create(5));
+	ASSERT_EQ(SmallElementTuple::INLINESIZE + 2, view.size());
+	ASSERT_EQ(SmallElementTuple::INLINESIZE + 1, large.size());
+}
+
+TEST(TableTest, TableViewOutlivesItsTableAndKeepsItsTuples) {
+	auto factory = getGlobal()->getGlobalDomElemFactory();
+	auto sorttable = new SortTable(new IntRangeInternalSortTable(1, 3));
+	SortedElementTable tuples;
+	tuples.insert( { factory->create(1), factory->create(2) });
+	tuples.insert( { factory->create(2), factory->create(3) });
+	auto table = new PredTable(new EnumeratedInternalPredTable(tuples), Universe( { sorttable, sorttable }));
+	auto view = new TableView(table);
+	auto projection = view->project( { 1 });
+
+	table->add( { factory->create(3), factory->create(1) });
+	ASSERT_TRUE(table->contains( { factory->create(3), factory->create(1) }));
+	delete (table);
+	delete (sorttable);
+
+	ASSERT_EQ(2, view->size());
+	ASSERT_FALSE(view->contains( { factory->create(3), factory->create(1) }));
+	delete (view);
+	ASSERT_EQ(2, projection->size());
+	ASSERT_TRUE(projection->contains( { factory->create(3) }));
+	ASSERT_FALSE(projection->contains( { factory->create(1) }));
+	delete (projection);
+}
+
 }